@@ -13,6 +13,8 @@ extern "C" {
 
 namespace Porto {
 
+Connection::Connection() { }
+
 Connection::~Connection() {
     Close();
 }
@@ -62,6 +64,9 @@ EError Connection::Connect(const char *socket_path) {
     if (connect(Fd, (struct sockaddr *) &peer_addr, peer_addr_size) < 0)
         return SetError("connect", errno);
 
+    /* Keeps read-ahead between responses */
+    Input.reset(new google::protobuf::io::FileInputStream(Fd));
+
     /* Restore async wait state */
     if (!AsyncWaitNames.empty()) {
         for (auto &name: AsyncWaitNames)
@@ -77,6 +82,7 @@ EError Connection::Connect(const char *socket_path) {
 }
 
 void Connection::Close() {
+    Input.reset();
     if (Fd >= 0)
         close(Fd);
     Fd = -1;
@@ -136,7 +142,10 @@ EError Connection::Send(const rpc::TPortoRequest &req) {
 }
 
 EError Connection::Recv(rpc::TPortoResponse &rsp) {
-    google::protobuf::io::FileInputStream raw(Fd);
+    if (!Input)
+        return SetError("recv", EIO);
+
+    auto &raw = *Input;
     google::protobuf::io::CodedInputStream input(&raw);
 
     while (true) {
@@ -213,6 +222,38 @@ EError Connection::Call(const TString &req,
     return LastError;
 }
 
+EError Connection::SendTagged(rpc::TPortoRequest &req, uint64_t tag) {
+    EError err = EError::Success;
+
+    if (!tag) {
+        LastError = EError::InvalidValue;
+        LastErrorMsg = "Zero request tag";
+        return LastError;
+    }
+
+    if (Fd < 0)
+        err = Connect();
+
+    req.set_tag(tag);
+
+    if (!err)
+        err = Send(req);
+
+    return err;
+}
+
+EError Connection::RecvTagged(rpc::TPortoResponse &rsp, uint64_t &tag) {
+    EError err = Recv(rsp);
+
+    if (!err) {
+        tag = rsp.tag();
+        err = LastError = rsp.error();
+        LastErrorMsg = rsp.errormsg();
+    }
+
+    return err;
+}
+
 EError Connection::GetVersion(TString &tag, TString &revision) {
     Req.Clear();
     Req.mutable_version();
@@ -364,6 +405,48 @@ const rpc::TContainerSpec *Connection::GetContainerSpec(const TString &name) {
     return nullptr;
 }
 
+const rpc::TListChangesResponse *Connection::ListChanges(uint64_t since_gen) {
+    Req.Clear();
+    Req.mutable_listchanges()->set_since_gen(since_gen);
+
+    if (!Call())
+        return &Rsp.listchanges();
+
+    return nullptr;
+}
+
+const rpc::TGetStatsResponse *Connection::GetStats(const std::vector<TString> &names,
+                                                  const std::vector<TString> &properties) {
+    Req.Clear();
+    auto req = Req.mutable_getstats();
+
+    for (auto &name: names)
+        req->add_name(name);
+    for (auto &prop: properties)
+        req->add_property(prop);
+
+    if (!Call())
+        return &Rsp.getstats();
+
+    return nullptr;
+}
+
+const rpc::TGetSamplesResponse *Connection::GetSamples(const std::vector<TString> &names,
+                                                      uint32_t count) {
+    Req.Clear();
+    auto req = Req.mutable_getsamples();
+
+    for (auto &name: names)
+        req->add_name(name);
+    if (count)
+        req->set_count(count);
+
+    if (!Call())
+        return &Rsp.getsamples();
+
+    return nullptr;
+}
+
 EError Connection::GetProperty(const TString &name,
                                const TString &property,
                                TString &value,
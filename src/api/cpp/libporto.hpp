@@ -8,6 +8,14 @@
 
 #include "rpc.pb.h"
 
+namespace google {
+namespace protobuf {
+namespace io {
+class FileInputStream;
+}
+}
+}
+
 namespace Porto {
 
 using Porto::rpc::EError;
@@ -29,6 +37,7 @@ enum {
 class Connection {
 private:
     int Fd = -1;
+    std::unique_ptr<google::protobuf::io::FileInputStream> Input;
     int Timeout = DEFAULT_TIMEOUT;
     int DiskTimeout = DEFAULT_DISK_TIMEOUT;
 
@@ -54,7 +63,7 @@ private:
     EError Call(int extra_timeout = -1);
 
 public:
-    Connection() { }
+    Connection();
     ~Connection();
 
     int GetFd() const { return Fd; }
@@ -92,6 +101,14 @@ public:
                 TString &rsp,
                 int extra_timeout = -1);
 
+    /*
+     * Pipelined mode: send several tagged requests without waiting,
+     * responses come back in order of completion with the same tag.
+     * Tag must be non-zero. Async wait events are handled as usual.
+     */
+    EError SendTagged(rpc::TPortoRequest &req, uint64_t tag);
+    EError RecvTagged(rpc::TPortoResponse &rsp, uint64_t &tag);
+
     /* System */
 
     EError GetVersion(TString &tag, TString &revision);
@@ -157,6 +174,16 @@ public:
     /* Porto v5 api */
     const rpc::TContainerSpec *GetContainerSpec(const TString &name);
 
+    /* Containers and volumes changed since generation */
+    const rpc::TListChangesResponse *ListChanges(uint64_t since_gen);
+
+    /* Typed values, stats are in order of properties */
+    const rpc::TGetStatsResponse *GetStats(const std::vector<TString> &names,
+                                           const std::vector<TString> &properties);
+
+    const rpc::TGetSamplesResponse *GetSamples(const std::vector<TString> &names,
+                                               uint32_t count = 0);
+
     EError GetProperty(const TString &name,
                        const TString &property,
                        TString &value,
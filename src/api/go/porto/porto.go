@@ -100,6 +100,15 @@ type TPortoGetResponse struct {
 	ErrorMsg string
 }
 
+// Typed value returned by GetStats
+type TPortoStat struct {
+	Uint     uint64
+	Map      map[string]uint64
+	Value    string
+	Error    int
+	ErrorMsg string
+}
+
 type Error struct {
 	Errno   rpc.EError
 	ErrName string
@@ -138,6 +147,8 @@ type API interface {
 	Get(containers []string, variables []string) (map[string]map[string]TPortoGetResponse, error)
 	Get3(containers []string, variables []string, nonblock bool) (
 		map[string]map[string]TPortoGetResponse, error)
+	GetStats(containers []string, variables []string) (
+		map[string]map[string]TPortoStat, error)
 
 	GetProperty(name string, property string) (string, error)
 	SetProperty(name string, property string, value string) error
@@ -473,6 +484,50 @@ func (conn *portoConnection) Get3(containers []string, variables []string, nonbl
 	return ret, err
 }
 
+func (conn *portoConnection) GetStats(containers []string, variables []string) (ret map[string]map[string]TPortoStat, err error) {
+	ret = make(map[string]map[string]TPortoStat)
+	req := &rpc.TPortoRequest{
+		GetStats: &rpc.TGetStatsRequest{
+			Name:     containers,
+			Property: variables,
+		},
+	}
+
+	resp, err := conn.performRequest(req)
+	if err != nil {
+		return nil, err
+	}
+
+	for _, item := range resp.GetGetStats().GetContainer() {
+		if item.GetError() != nil {
+			continue
+		}
+		stats := make(map[string]TPortoStat)
+		for i, stat := range item.GetStat() {
+			if i >= len(variables) {
+				break
+			}
+			var v = TPortoStat{
+				Uint:  stat.GetUintValue(),
+				Value: stat.GetStringValue(),
+			}
+			if stat.GetError() != nil {
+				v.Error = int(stat.GetError().GetError())
+				v.ErrorMsg = stat.GetError().GetMsg()
+			}
+			if stat.GetMapValue() != nil {
+				v.Map = make(map[string]uint64)
+				for _, kv := range stat.GetMapValue().GetMap() {
+					v.Map[kv.GetKey()] = kv.GetVal()
+				}
+			}
+			stats[variables[i]] = v
+		}
+		ret[item.GetName()] = stats
+	}
+	return ret, err
+}
+
 func (conn *portoConnection) GetProperty(name string, property string) (string, error) {
 	req := &rpc.TPortoRequest{
 		GetProperty: &rpc.TContainerGetPropertyRequest{
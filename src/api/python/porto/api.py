@@ -57,8 +57,10 @@ class _RPC(object):
         self.nr_connects = 0
         self.connect_time = None
         self.async_wait_names = []
+        self.async_wait_volumes = []
         self.async_wait_callback = None
         self.async_wait_timeout = None
+        self.follow_callback = None
 
     def _connect(self):
         if self.connect_time:
@@ -137,6 +139,11 @@ class _RPC(object):
                         self.async_wait_callback(name=rsp.AsyncWait.name, state=rsp.AsyncWait.state, when=rsp.AsyncWait.when, label=rsp.AsyncWait.label, value=rsp.AsyncWait.value)
                     else:
                         self.async_wait_callback(name=rsp.AsyncWait.name, state=rsp.AsyncWait.state, when=rsp.AsyncWait.when)
+            elif rsp.HasField('FollowStream'):
+                if self.follow_callback is not None:
+                    self.follow_callback(name=rsp.FollowStream.name, stream=rsp.FollowStream.stream,
+                                         offset=rsp.FollowStream.offset, data=rsp.FollowStream.data,
+                                         end=rsp.FollowStream.end)
             else:
                 return rsp
 
@@ -187,6 +194,39 @@ class _RPC(object):
             raise exceptions.PortoException.Create(response.error, response.errorMsg)
         return response
 
+    def pipeline(self, requests, call_timeout=0):
+        # Send all requests at once, responses come in order of completion
+        reqs = bytearray()
+        for tag, request in enumerate(requests, 1):
+            request.tag = tag
+            reqs += self.encode_request(request)
+
+        responses = [None] * len(requests)
+
+        with self.lock:
+            self._set_deadline(self.timeout)
+            try:
+                self._check_connect()
+                self._set_socket_timeout()
+                self.sock.sendall(reqs)
+
+                if call_timeout is None or call_timeout < 0:
+                    self.deadline = None
+                elif self.deadline is not None:
+                    self.deadline += call_timeout
+
+                for i in range(len(requests)):
+                    response = self._recv_response()
+                    responses[response.tag - 1] = response
+            except socket.timeout as e:
+                self.sock = None
+                raise exceptions.SocketTimeout("Porto connection timeout: {}".format(e))
+            except socket.error as e:
+                self.sock = None
+                raise exceptions.SocketError("Socket error: {}".format(e))
+
+        return responses
+
     def connect(self, timeout=None):
         with self.lock:
             self._set_deadline(timeout if timeout is not None else self.timeout)
@@ -222,11 +262,12 @@ class _RPC(object):
             return self.sock is not None
 
     def _resend_async_wait(self):
-        if not self.async_wait_names:
+        if not self.async_wait_names and not self.async_wait_volumes:
             return
 
         request = rpc_pb2.TPortoRequest()
         request.AsyncWait.name.extend(self.async_wait_names)
+        request.AsyncWait.volume.extend(self.async_wait_volumes)
         if self.async_wait_timeout is not None:
             request.AsyncWait.timeout_ms = int(self.async_wait_timeout * 1000)
 
@@ -235,14 +276,17 @@ class _RPC(object):
         if response.error != rpc_pb2.Success:
             raise exceptions.PortoException.Create(response.error, response.errorMsg)
 
-    def async_wait(self, names, labels, callback, timeout):
+    def async_wait(self, names, labels, callback, timeout, volumes=None):
         with self.lock:
             self.async_wait_names = names
+            self.async_wait_volumes = volumes or []
             self.async_wait_callback = callback
             self.async_wait_timeout = timeout
 
         request = rpc_pb2.TPortoRequest()
         request.AsyncWait.name.extend(names)
+        if volumes is not None:
+            request.AsyncWait.volume.extend(volumes)
         if timeout is not None:
             request.AsyncWait.timeout_ms = int(timeout * 1000)
         if labels is not None:
@@ -642,15 +686,33 @@ class Connection(object):
             return _decode_message(getattr(rsp, response_name or command_name))
         return None
 
-    def List(self, mask=None):
+    def Pipeline(self, requests):
+        """Send list of TPortoRequest at once, returns list of TPortoResponse"""
+        return self.rpc.pipeline(requests)
+
+    def List(self, mask=None, labels=None):
+        """labels - select containers with any of labels NAME or NAME=VALUE"""
         request = rpc_pb2.TPortoRequest()
         request.list.CopyFrom(rpc_pb2.TContainerListRequest())
         if mask is not None:
             request.list.mask = mask
+        if labels is not None:
+            request.list.label.extend(labels)
         return self.rpc.call(request).list.name
 
-    def ListContainers(self, mask=None):
-        return [Container(self, name) for name in self.List(mask)]
+    def GetSamples(self, names=None, count=None):
+        """Resource usage history collected by portod, oldest sample first"""
+        request = rpc_pb2.TPortoRequest()
+        request.GetSamples.SetInParent()
+        if names is not None:
+            request.GetSamples.name.extend(names)
+        if count is not None:
+            request.GetSamples.count = count
+        rsp = self.rpc.call(request).GetSamples
+        return {ct.name: [_decode_message(s) for s in ct.sample] for ct in rsp.container if not ct.HasField('error')}
+
+    def ListContainers(self, mask=None, labels=None):
+        return [Container(self, name) for name in self.List(mask, labels)]
 
     def FindLabel(self, label, mask=None, state=None, value=None):
         request = rpc_pb2.TPortoRequest()
@@ -741,11 +803,13 @@ class Connection(object):
         request.resume.name = name
         self.rpc.call(request)
 
-    def Get(self, containers, variables, nonblock=False, sync=False):
+    def Get(self, containers, variables, nonblock=False, sync=False, labels=None):
         request = rpc_pb2.TPortoRequest()
         request.get.name.extend(containers)
         request.get.variable.extend(variables)
         request.get.sync = sync
+        if labels is not None:
+            request.get.label.extend(labels)
         if nonblock:
             request.get.nonblock = nonblock
         resp = self.rpc.call(request)
@@ -766,6 +830,35 @@ class Connection(object):
             res[container.name] = var
         return res
 
+    def ListChanges(self, since_gen=0):
+        """Containers and volumes changed since generation, returns TListChangesResponse"""
+        request = rpc_pb2.TPortoRequest()
+        request.ListChanges.since_gen = since_gen
+        return self.rpc.call(request).ListChanges
+
+    def GetStats(self, containers, variables):
+        """Like Get but numbers and maps are returned as int and dict"""
+        request = rpc_pb2.TPortoRequest()
+        request.GetStats.name.extend(containers)
+        request.GetStats.property.extend(variables)
+        resp = self.rpc.call(request)
+        res = {}
+        for container in resp.GetStats.container:
+            if container.HasField('error'):
+                continue
+            var = {}
+            for key, stat in zip(variables, container.stat):
+                if stat.HasField('error'):
+                    var[key] = exceptions.PortoException.Create(stat.error.error, stat.error.msg)
+                elif stat.HasField('uint_value'):
+                    var[key] = stat.uint_value
+                elif stat.HasField('map_value'):
+                    var[key] = {kv.key: kv.val for kv in stat.map_value.map}
+                else:
+                    var[key] = stat.string_value
+            res[container.name] = var
+        return res
+
     def GetProperty(self, name, key, sync=False):
         request = rpc_pb2.TPortoRequest()
         request.getProperty.name = name
@@ -869,8 +962,44 @@ class Connection(object):
         except exceptions.WaitContainerTimeout:
             return ""
 
-    def AsyncWait(self, containers, callback, timeout=None, labels=None):
-        self.rpc.async_wait([str(ct) for ct in containers], labels, callback, timeout)
+    def AsyncWait(self, containers, callback, timeout=None, labels=None, volumes=None):
+        self.rpc.async_wait([str(ct) for ct in containers], labels, callback, timeout, volumes=volumes)
+
+    def WaitVolumes(self, paths, timeout=None):
+        request = rpc_pb2.TPortoRequest()
+        request.wait.volume.extend(paths)
+        if timeout is not None and timeout >= 0:
+            request.wait.timeout_ms = int(timeout * 1000)
+        else:
+            timeout = None
+        resp = self.rpc.call(request, timeout)
+        if resp.wait.name == "":
+            raise exceptions.WaitContainerTimeout("Timeout {} exceeded".format(timeout))
+        return { 'when': resp.wait.when,
+                 'path': resp.wait.name,
+                 'state': resp.wait.state,
+                 'label': resp.wait.label,
+                 'value': resp.wait.value }
+
+    def FollowStream(self, container, callback, stream='stdout', offset=None, chunk_size=None):
+        self.rpc.follow_callback = callback
+        request = rpc_pb2.TPortoRequest()
+        request.FollowStream.name = str(container)
+        request.FollowStream.stream = stream
+        if offset is not None:
+            request.FollowStream.offset = offset
+        if chunk_size is not None:
+            request.FollowStream.chunk_size = chunk_size
+        # data is pushed as responses with tag of this request
+        request.tag = 1
+        self.rpc.call(request)
+
+    def UnfollowStream(self, container, stream='stdout'):
+        request = rpc_pb2.TPortoRequest()
+        request.FollowStream.name = str(container)
+        request.FollowStream.stream = stream
+        request.FollowStream.stop = True
+        self.rpc.call(request)
 
     def WaitLabels(self, containers, labels, timeout=None):
         request = rpc_pb2.TPortoRequest()
@@ -911,7 +1040,7 @@ class Connection(object):
         req.IncLabel.add = add
         return self.rpc.call(req).IncLabel.result
 
-    def CreateVolume(self, path=None, layers=None, storage=None, private_value=None, timeout=None, **properties):
+    def CreateVolume(self, path=None, layers=None, storage=None, private_value=None, timeout=None, async_build=False, **properties):
         if layers:
             layers = [l.name if isinstance(l, Layer) else l for l in layers]
             properties['layers'] = ';'.join(layers)
@@ -926,6 +1055,8 @@ class Connection(object):
         request.createVolume.CopyFrom(rpc_pb2.TVolumeCreateRequest())
         if path:
             request.createVolume.path = path
+        if async_build:
+            request.createVolume.async_build = True
         for name, value in properties.items():
             prop = request.createVolume.properties.add()
             prop.name, prop.value = name, value
@@ -936,29 +1067,35 @@ class Connection(object):
         pb = self._ListVolumes(path=path)[0]
         return Volume(self, path, pb)
 
-    def NewVolume(self, spec, timeout=None):
+    def NewVolume(self, spec, timeout=None, async_build=False):
         req = rpc_pb2.TPortoRequest()
         req.NewVolume.SetInParent()
         _encode_message(req.NewVolume.volume, spec)
+        if async_build:
+            req.NewVolume.async_build = True
         rsp = self.rpc.call(req, timeout or self.disk_timeout)
         return _decode_message(rsp.NewVolume.volume)
 
-    def GetVolume(self, path, container=None, timeout=None):
+    def GetVolume(self, path, container=None, timeout=None, sync=False):
         req = rpc_pb2.TPortoRequest()
         req.GetVolume.SetInParent()
         if container is not None:
             req.GetVolume.container = str(container)
         req.GetVolume.path.append(path)
+        if sync:
+            req.GetVolume.sync = True
         rsp = self.rpc.call(req, timeout or self.disk_timeout)
         return _decode_message(rsp.GetVolume.volume[0])
 
-    def GetVolumes(self, paths=None, container=None, timeout=None):
+    def GetVolumes(self, paths=None, container=None, timeout=None, sync=False):
         req = rpc_pb2.TPortoRequest()
         req.GetVolume.SetInParent()
         if container is not None:
             req.GetVolume.container = str(container)
         if paths is not None:
             req.GetVolume.path.extend(paths)
+        if sync:
+            req.GetVolume.sync = True
         rsp = self.rpc.call(req, timeout or self.disk_timeout)
         return [_decode_message(v) for v in rsp.GetVolume.volume]
 
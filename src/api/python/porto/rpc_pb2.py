@@ -0,0 +1,299 @@
+# -*- coding: utf-8 -*-
+# Generated by the protocol buffer compiler.  DO NOT EDIT!
+# source: rpc.proto
+"""Generated protocol buffer code."""
+from google.protobuf.internal import builder as _builder
+from google.protobuf import descriptor as _descriptor
+from google.protobuf import descriptor_pool as _descriptor_pool
+from google.protobuf import symbol_database as _symbol_database
+# @@protoc_insertion_point(imports)
+
+_sym_db = _symbol_database.Default()
+
+
+
+
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\trpc.proto\x12\tPorto.rpc\"\xef\x18\n\rTPortoRequest\x12\x32\n\x06\x63reate\x18\x01 \x01(\x0b\x32\".Porto.rpc.TContainerCreateRequest\x12\x34\n\x07\x64\x65stroy\x18\x02 \x01(\x0b\x32#.Porto.rpc.TContainerDestroyRequest\x12.\n\x04list\x18\x03 \x01(\x0b\x32 .Porto.rpc.TContainerListRequest\x12<\n\x0bgetProperty\x18\x04 \x01(\x0b\x32\'.Porto.rpc.TContainerGetPropertyRequest\x12<\n\x0bsetProperty\x18\x05 \x01(\x0b\x32\'.Porto.rpc.TContainerSetPropertyRequest\x12\x34\n\x07getData\x18\x06 \x01(\x0b\x32#.Porto.rpc.TContainerGetDataRequest\x12\x30\n\x05start\x18\x07 \x01(\x0b\x32!.Porto.rpc.TContainerStartRequest\x12.\n\x04stop\x18\x08 \x01(\x0b\x32 .Porto.rpc.TContainerStopRequest\x12\x30\n\x05pause\x18\t \x01(\x0b\x32!.Porto.rpc.TContainerPauseRequest\x12\x32\n\x06resume\x18\n \x01(\x0b\x32\".Porto.rpc.TContainerResumeRequest\x12>\n\x0cpropertyList\x18\x0b \x01(\x0b\x32(.Porto.rpc.TContainerPropertyListRequest\x12\x36\n\x08\x64\x61taList\x18\x0c \x01(\x0b\x32$.Porto.rpc.TContainerDataListRequest\x12.\n\x04kill\x18\r \x01(\x0b\x32 .Porto.rpc.TContainerKillRequest\x12+\n\x07version\x18\x0e \x01(\x0b\x32\x1a.Porto.rpc.TVersionRequest\x12,\n\x03get\x18\x0f \x01(\x0b\x32\x1f.Porto.rpc.TContainerGetRequest\x12.\n\x04wait\x18\x10 \x01(\x0b\x32 .Porto.rpc.TContainerWaitRequest\x12\x36\n\ncreateWeak\x18\x11 \x01(\x0b\x32\".Porto.rpc.TContainerCreateRequest\x12\x34\n\x07Respawn\x18\x12 \x01(\x0b\x32#.Porto.rpc.TContainerRespawnRequest\x12\x33\n\tAsyncWait\x18\x13 \x01(\x0b\x32 .Porto.rpc.TContainerWaitRequest\x12/\n\tFindLabel\x18\x14 \x01(\x0b\x32\x1c.Porto.rpc.TFindLabelRequest\x12-\n\x08SetLabel\x18\x15 \x01(\x0b\x32\x1b.Porto.rpc.TSetLabelRequest\x12-\n\x08IncLabel\x18\x16 \x01(\x0b\x32\x1b.Porto.rpc.TIncLabelRequest\x12\x35\n\x0cNewContainer\x18\x17 \x01(\x0b\x32\x1f.Porto.rpc.TNewContainerRequest\x12\x35\n\x0cSetContainer\x18\x18 \x01(\x0b\x32\x1f.Porto.rpc.TSetContainerRequest\x12\x35\n\x0cGetContainer\x18\x19 \x01(\x0b\x32\x1f.Porto.rpc.TGetContainerRequest\x12\x31\n\nGetSamples\x18\x1a \x01(\x0b\x32\x1d.Porto.rpc.TGetSamplesRequest\x12-\n\x08GetStats\x18\x1b \x01(\x0b\x32\x1b.Porto.rpc.TGetStatsRequest\x12\x33\n\x0bListChanges\x18\x1c \x01(\x0b\x32\x1e.Porto.rpc.TListChangesRequest\x12\x35\n\x0c\x46ollowStream\x18\x1d \x01(\x0b\x32\x1f.Porto.rpc.TFollowStreamRequest\x12\x43\n\x14listVolumeProperties\x18g \x01(\x0b\x32%.Porto.rpc.TVolumePropertyListRequest\x12\x35\n\x0c\x63reateVolume\x18h \x01(\x0b\x32\x1f.Porto.rpc.TVolumeCreateRequest\x12\x31\n\nlinkVolume\x18i \x01(\x0b\x32\x1d.Porto.rpc.TVolumeLinkRequest\x12\x37\n\x10LinkVolumeTarget\x18x \x01(\x0b\x32\x1d.Porto.rpc.TVolumeLinkRequest\x12\x35\n\x0cunlinkVolume\x18j \x01(\x0b\x32\x1f.Porto.rpc.TVolumeUnlinkRequest\x12;\n\x12UnlinkVolumeTarget\x18y \x01(\x0b\x32\x1f.Porto.rpc.TVolumeUnlinkRequest\x12\x32\n\x0blistVolumes\x18k \x01(\x0b\x32\x1d.Porto.rpc.TVolumeListRequest\x12\x31\n\ntuneVolume\x18l \x01(\x0b\x32\x1d.Porto.rpc.TVolumeTuneRequest\x12\x33\n\x0bimportLayer\x18n \x01(\x0b\x32\x1e.Porto.rpc.TLayerImportRequest\x12\x33\n\x0bremoveLayer\x18o \x01(\x0b\x32\x1e.Porto.rpc.TLayerRemoveRequest\x12\x30\n\nlistLayers\x18p \x01(\x0b\x32\x1c.Porto.rpc.TLayerListRequest\x12\x33\n\x0b\x65xportLayer\x18q \x01(\x0b\x32\x1e.Porto.rpc.TLayerExportRequest\x12;\n\x0fgetlayerprivate\x18r \x01(\x0b\x32\".Porto.rpc.TLayerGetPrivateRequest\x12;\n\x0fsetlayerprivate\x18s \x01(\x0b\x32\".Porto.rpc.TLayerSetPrivateRequest\x12\x33\n\x0blistStorage\x18t \x01(\x0b\x32\x1e.Porto.rpc.TStorageListRequest\x12\x37\n\rremoveStorage\x18u \x01(\x0b\x32 .Porto.rpc.TStorageRemoveRequest\x12\x37\n\rimportStorage\x18v \x01(\x0b\x32 .Porto.rpc.TStorageImportRequest\x12\x37\n\rexportStorage\x18w \x01(\x0b\x32 .Porto.rpc.TStorageExportRequest\x12\x32\n\x11\x43reateMetaStorage\x18z \x01(\x0b\x32\x17.Porto.rpc.TMetaStorage\x12\x32\n\x11ResizeMetaStorage\x18{ \x01(\x0b\x32\x17.Porto.rpc.TMetaStorage\x12\x32\n\x11RemoveMetaStorage\x18| \x01(\x0b\x32\x17.Porto.rpc.TMetaStorage\x12\x31\n\nSetSymlink\x18} \x01(\x0b\x32\x1d.Porto.rpc.TSetSymlinkRequest\x12/\n\tNewVolume\x18~ \x01(\x0b\x32\x1c.Porto.rpc.TNewVolumeRequest\x12/\n\tGetVolume\x18\x7f \x01(\x0b\x32\x1c.Porto.rpc.TGetVolumeRequest\x12\x34\n\x0b\x63onvertPath\x18\xc8\x01 \x01(\x0b\x32\x1e.Porto.rpc.TConvertPathRequest\x12\x38\n\rattachProcess\x18\xc9\x01 \x01(\x0b\x32 .Porto.rpc.TAttachProcessRequest\x12\x38\n\rlocateProcess\x18\xca\x01 \x01(\x0b\x32 .Porto.rpc.TLocateProcessRequest\x12\x37\n\x0c\x41ttachThread\x18\xcb\x01 \x01(\x0b\x32 .Porto.rpc.TAttachProcessRequest\x12\x30\n\tGetSystem\x18\xac\x02 \x01(\x0b\x32\x1c.Porto.rpc.TGetSystemRequest\x12\x30\n\tSetSystem\x18\xad\x02 \x01(\x0b\x32\x1c.Porto.rpc.TSetSystemRequest\x12\x0c\n\x03tag\x18\xe9\x07 \x01(\x04\"\xe4\r\n\x0eTPortoResponse\x12+\n\x05\x65rror\x18\x01 \x01(\x0e\x32\x11.Porto.rpc.EError:\tLostError\x12\x10\n\x08\x65rrorMsg\x18\x02 \x01(\t\x12\x12\n\ttimestamp\x18\xe8\x07 \x01(\x04\x12/\n\x04list\x18\x03 \x01(\x0b\x32!.Porto.rpc.TContainerListResponse\x12=\n\x0bgetProperty\x18\x04 \x01(\x0b\x32(.Porto.rpc.TContainerGetPropertyResponse\x12\x35\n\x07getData\x18\x05 \x01(\x0b\x32$.Porto.rpc.TContainerGetDataResponse\x12?\n\x0cpropertyList\x18\x06 \x01(\x0b\x32).Porto.rpc.TContainerPropertyListResponse\x12\x37\n\x08\x64\x61taList\x18\x07 \x01(\x0b\x32%.Porto.rpc.TContainerDataListResponse\x12,\n\x07version\x18\x08 \x01(\x0b\x32\x1b.Porto.rpc.TVersionResponse\x12\x32\n\nvolumeList\x18\t \x01(\x0b\x32\x1e.Porto.rpc.TVolumeListResponse\x12-\n\x03get\x18\n \x01(\x0b\x32 .Porto.rpc.TContainerGetResponse\x12/\n\x04wait\x18\x0b \x01(\x0b\x32!.Porto.rpc.TContainerWaitResponse\x12\x42\n\x12volumePropertyList\x18\x0c \x01(\x0b\x32&.Porto.rpc.TVolumePropertyListResponse\x12-\n\x06volume\x18\r \x01(\x0b\x32\x1d.Porto.rpc.TVolumeDescription\x12-\n\x06layers\x18\x0e \x01(\x0b\x32\x1d.Porto.rpc.TLayerListResponse\x12\x34\n\x0b\x63onvertPath\x18\x0f \x01(\x0b\x32\x1f.Porto.rpc.TConvertPathResponse\x12:\n\rlayer_private\x18\x10 \x01(\x0b\x32#.Porto.rpc.TLayerGetPrivateResponse\x12\x34\n\x0bstorageList\x18\x11 \x01(\x0b\x32\x1f.Porto.rpc.TStorageListResponse\x12\x38\n\rlocateProcess\x18\x12 \x01(\x0b\x32!.Porto.rpc.TLocateProcessResponse\x12\x34\n\tAsyncWait\x18\x13 \x01(\x0b\x32!.Porto.rpc.TContainerWaitResponse\x12\x30\n\tFindLabel\x18\x14 \x01(\x0b\x32\x1d.Porto.rpc.TFindLabelResponse\x12.\n\x08SetLabel\x18\x15 \x01(\x0b\x32\x1c.Porto.rpc.TSetLabelResponse\x12.\n\x08IncLabel\x18\x16 \x01(\x0b\x32\x1c.Porto.rpc.TIncLabelResponse\x12\x36\n\x0cNewContainer\x18\x17 \x01(\x0b\x32 .Porto.rpc.TNewContainerResponse\x12\x36\n\x0cSetContainer\x18\x18 \x01(\x0b\x32 .Porto.rpc.TSetContainerResponse\x12\x36\n\x0cGetContainer\x18\x19 \x01(\x0b\x32 .Porto.rpc.TGetContainerResponse\x12\x32\n\nGetSamples\x18\x1a \x01(\x0b\x32\x1e.Porto.rpc.TGetSamplesResponse\x12.\n\x08GetStats\x18\x1b \x01(\x0b\x32\x1c.Porto.rpc.TGetStatsResponse\x12\x34\n\x0bListChanges\x18\x1c \x01(\x0b\x32\x1f.Porto.rpc.TListChangesResponse\x12\x36\n\x0c\x46ollowStream\x18\x1d \x01(\x0b\x32 .Porto.rpc.TFollowStreamResponse\x12\x30\n\tNewVolume\x18~ \x01(\x0b\x32\x1d.Porto.rpc.TNewVolumeResponse\x12\x30\n\tGetVolume\x18\x7f \x01(\x0b\x32\x1d.Porto.rpc.TGetVolumeResponse\x12\x31\n\tGetSystem\x18\xac\x02 \x01(\x0b\x32\x1d.Porto.rpc.TGetSystemResponse\x12\x31\n\tSetSystem\x18\xad\x02 \x01(\x0b\x32\x1d.Porto.rpc.TSetSystemResponse\x12\x0c\n\x03tag\x18\xe9\x07 \x01(\x04\"|\n\nTStringMap\x12\x32\n\x03map\x18\x01 \x03(\x0b\x32%.Porto.rpc.TStringMap.TStringMapEntry\x12\r\n\x05merge\x18\x02 \x01(\x08\x1a+\n\x0fTStringMapEntry\x12\x0b\n\x03key\x18\x01 \x01(\t\x12\x0b\n\x03val\x18\x02 \x01(\t\"t\n\x08TUintMap\x12.\n\x03map\x18\x01 \x03(\x0b\x32!.Porto.rpc.TUintMap.TUintMapEntry\x12\r\n\x05merge\x18\x02 \x01(\x08\x1a)\n\rTUintMapEntry\x12\x0b\n\x03key\x18\x01 \x01(\t\x12\x0b\n\x03val\x18\x02 \x01(\x04\"B\n\x06TError\x12+\n\x05\x65rror\x18\x01 \x01(\x0e\x32\x11.Porto.rpc.EError:\tLostError\x12\x0b\n\x03msg\x18\x02 \x01(\t\"K\n\x05TCred\x12\x0c\n\x04user\x18\x01 \x01(\t\x12\x0b\n\x03uid\x18\x02 \x01(\x07\x12\r\n\x05group\x18\x03 \x01(\t\x12\x0b\n\x03gid\x18\x04 \x01(\x07\x12\x0b\n\x03grp\x18\x05 \x03(\x07\")\n\rTCapabilities\x12\x0b\n\x03\x63\x61p\x18\x01 \x03(\t\x12\x0b\n\x03hex\x18\x02 \x01(\t\"%\n\x15TContainerCommandArgv\x12\x0c\n\x04\x61rgv\x18\x01 \x03(\t\">\n\x10TContainerEnvVar\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\r\n\x05value\x18\x02 \x01(\t\x12\r\n\x05unset\x18\x03 \x01(\x08\"H\n\rTContainerEnv\x12(\n\x03var\x18\x01 \x03(\x0b\x32\x1b.Porto.rpc.TContainerEnvVar\x12\r\n\x05merge\x18\x02 \x01(\x08\"b\n\x10TContainerUlimit\x12\x0c\n\x04type\x18\x01 \x02(\t\x12\x11\n\tunlimited\x18\x02 \x01(\x08\x12\x0c\n\x04soft\x18\x03 \x01(\x04\x12\x0c\n\x04hard\x18\x04 \x01(\x04\x12\x11\n\tinherited\x18\x05 \x01(\x08\"O\n\x11TContainerUlimits\x12+\n\x06ulimit\x18\x01 \x03(\x0b\x32\x1b.Porto.rpc.TContainerUlimit\x12\r\n\x05merge\x18\x02 \x01(\x08\"+\n\x15TContainerControllers\x12\x12\n\ncontroller\x18\x01 \x03(\t\"G\n\x10TContainerCgroup\x12\x12\n\ncontroller\x18\x01 \x02(\t\x12\x0c\n\x04path\x18\x02 \x02(\t\x12\x11\n\tinherited\x18\x03 \x01(\x08\"@\n\x11TContainerCgroups\x12+\n\x06\x63group\x18\x01 \x03(\x0b\x32\x1b.Porto.rpc.TContainerCgroup\"Y\n\x10TContainerCpuSet\x12\x0e\n\x06policy\x18\x01 \x01(\t\x12\x0b\n\x03\x61rg\x18\x02 \x01(\r\x12\x0c\n\x04list\x18\x03 \x01(\t\x12\x0b\n\x03\x63pu\x18\x04 \x03(\r\x12\r\n\x05\x63ount\x18\x05 \x01(\r\"C\n\x13TContainerBindMount\x12\x0e\n\x06source\x18\x01 \x02(\t\x12\x0e\n\x06target\x18\x02 \x02(\t\x12\x0c\n\x04\x66lag\x18\x03 \x03(\t\"D\n\x14TContainerBindMounts\x12,\n\x04\x62ind\x18\x01 \x03(\x0b\x32\x1e.Porto.rpc.TContainerBindMount\"[\n\x14TContainerVolumeLink\x12\x0e\n\x06volume\x18\x01 \x02(\t\x12\x0e\n\x06target\x18\x02 \x01(\t\x12\x10\n\x08required\x18\x03 \x01(\x08\x12\x11\n\tread_only\x18\x04 \x01(\x08\"F\n\x15TContainerVolumeLinks\x12-\n\x04link\x18\x01 \x03(\x0b\x32\x1f.Porto.rpc.TContainerVolumeLink\"#\n\x11TContainerVolumes\x12\x0e\n\x06volume\x18\x01 \x03(\t\"/\n\x0fTContainerPlace\x12\r\n\x05place\x18\x01 \x02(\t\x12\r\n\x05\x61lias\x18\x02 \x01(\t\"@\n\x15TContainerPlaceConfig\x12\'\n\x03\x63\x66g\x18\x01 \x03(\x0b\x32\x1a.Porto.rpc.TContainerPlace\"2\n\x10TContainerDevice\x12\x0e\n\x06\x64\x65vice\x18\x01 \x02(\t\x12\x0e\n\x06\x61\x63\x63\x65ss\x18\x02 \x02(\t\"O\n\x11TContainerDevices\x12+\n\x06\x64\x65vice\x18\x01 \x03(\x0b\x32\x1b.Porto.rpc.TContainerDevice\x12\r\n\x05merge\x18\x02 \x01(\x08\"/\n\x13TContainerNetOption\x12\x0b\n\x03opt\x18\x01 \x02(\t\x12\x0b\n\x03\x61rg\x18\x02 \x03(\t\"U\n\x13TContainerNetConfig\x12+\n\x03\x63\x66g\x18\x01 \x03(\x0b\x32\x1e.Porto.rpc.TContainerNetOption\x12\x11\n\tinherited\x18\x02 \x01(\x08\"/\n\x11TContainerIpLimit\x12\x0e\n\x06policy\x18\x01 \x02(\t\x12\n\n\x02ip\x18\x02 \x03(\t\"v\n\x12TContainerIpConfig\x12\x37\n\x03\x63\x66g\x18\x01 \x03(\x0b\x32*.Porto.rpc.TContainerIpConfig.TContainerIp\x1a\'\n\x0cTContainerIp\x12\x0b\n\x03\x64\x65v\x18\x01 \x02(\t\x12\n\n\x02ip\x18\x02 \x02(\t\"\xe9\x01\n\x07TVmStat\x12\r\n\x05\x63ount\x18\x01 \x01(\x04\x12\x0c\n\x04size\x18\x02 \x01(\x04\x12\x10\n\x08max_size\x18\x03 \x01(\x04\x12\x0c\n\x04used\x18\x04 \x01(\x04\x12\x10\n\x08max_used\x18\x05 \x01(\x04\x12\x0c\n\x04\x61non\x18\x06 \x01(\x04\x12\x0c\n\x04\x66ile\x18\x07 \x01(\x04\x12\r\n\x05shmem\x18\x08 \x01(\x04\x12\x0c\n\x04huge\x18\t \x01(\x04\x12\x0c\n\x04swap\x18\n \x01(\x04\x12\x0c\n\x04\x64\x61ta\x18\x0b \x01(\x04\x12\r\n\x05stack\x18\x0c \x01(\x04\x12\x0c\n\x04\x63ode\x18\r \x01(\x04\x12\x0e\n\x06locked\x18\x0e \x01(\x04\x12\r\n\x05table\x18\x0f \x01(\x04\"\xd4!\n\x0eTContainerSpec\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x15\n\rabsolute_name\x18\x02 \x01(\t\x12\r\n\x05state\x18\x03 \x01(\t\x12\n\n\x02id\x18\x04 \x01(\x04\x12\r\n\x05level\x18\x05 \x01(\r\x12\x0e\n\x06parent\x18\x06 \x01(\t\x12\x0c\n\x04weak\x18\x07 \x01(\x08\x12\x0f\n\x07private\x18\x08 \x01(\t\x12%\n\x06labels\x18\t \x01(\x0b\x32\x15.Porto.rpc.TStringMap\x12\x0f\n\x07\x63ommand\x18\n \x01(\t\x12\x36\n\x0c\x63ommand_argv\x18\x0b \x01(\x0b\x32 .Porto.rpc.TContainerCommandArgv\x12%\n\x03\x65nv\x18\x0c \x01(\x0b\x32\x18.Porto.rpc.TContainerEnv\x12,\n\x06ulimit\x18\r \x01(\x0b\x32\x1c.Porto.rpc.TContainerUlimits\x12\x14\n\x0c\x63ore_command\x18\x0e \x01(\t\x12\x0f\n\x07isolate\x18\x0f \x01(\x08\x12\x11\n\tvirt_mode\x18\x10 \x01(\t\x12\x14\n\x0c\x65nable_porto\x18\x11 \x01(\t\x12\x17\n\x0fporto_namespace\x18\x12 \x01(\t\x12\x1a\n\x12\x61\x62solute_namespace\x18\x13 \x01(\t\x12\x10\n\x08root_pid\x18\x14 \x01(\x05\x12\x13\n\x0b\x65xit_status\x18\x15 \x01(\x05\x12\x11\n\texit_code\x18\x16 \x01(\x05\x12\x13\n\x0b\x63ore_dumped\x18\x17 \x01(\x08\x12&\n\x0bstart_error\x18\x18 \x01(\x0b\x32\x11.Porto.rpc.TError\x12\x0c\n\x04time\x18\x19 \x01(\x04\x12\x11\n\tdead_time\x18\x1a \x01(\x04\x12\x12\n\naging_time\x18\x1b \x01(\x04\x12#\n\ttask_cred\x18\x1e \x01(\x0b\x32\x10.Porto.rpc.TCred\x12\x0c\n\x04user\x18\x1f \x01(\t\x12\r\n\x05group\x18  \x01(\t\x12$\n\nowner_cred\x18! \x01(\x0b\x32\x10.Porto.rpc.TCred\x12\x12\n\nowner_user\x18\" \x01(\t\x12\x13\n\x0bowner_group\x18# \x01(\t\x12.\n\x0c\x63\x61pabilities\x18$ \x01(\x0b\x32\x18.Porto.rpc.TCapabilities\x12\x36\n\x14\x63\x61pabilities_ambient\x18% \x01(\x0b\x32\x18.Porto.rpc.TCapabilities\x12\x36\n\x14\x63\x61pabilities_allowed\x18& \x01(\x0b\x32\x18.Porto.rpc.TCapabilities\x12>\n\x1c\x63\x61pabilities_ambient_allowed\x18\' \x01(\x0b\x32\x18.Porto.rpc.TCapabilities\x12\x0c\n\x04root\x18( \x01(\t\x12\x11\n\troot_path\x18) \x01(\t\x12\x15\n\rroot_readonly\x18* \x01(\x08\x12-\n\x04\x62ind\x18+ \x01(\x0b\x32\x1f.Porto.rpc.TContainerBindMounts\x12&\n\x07symlink\x18, \x01(\x0b\x32\x15.Porto.rpc.TStringMap\x12-\n\x07\x64\x65vices\x18- \x01(\x0b\x32\x1c.Porto.rpc.TContainerDevices\x12/\n\x05place\x18. \x01(\x0b\x32 .Porto.rpc.TContainerPlaceConfig\x12(\n\x0bplace_limit\x18/ \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12(\n\x0bplace_usage\x18\x30 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12\x0b\n\x03\x63wd\x18\x32 \x01(\t\x12\x12\n\nstdin_path\x18\x33 \x01(\t\x12\x13\n\x0bstdout_path\x18\x34 \x01(\t\x12\x13\n\x0bstderr_path\x18\x35 \x01(\t\x12\x14\n\x0cstdout_limit\x18\x36 \x01(\x04\x12\x15\n\rstdout_offset\x18\x37 \x01(\x04\x12\x15\n\rstderr_offset\x18\x38 \x01(\x04\x12\r\n\x05umask\x18\x39 \x01(\r\x12\x0f\n\x07respawn\x18< \x01(\x08\x12\x15\n\rrespawn_count\x18= \x01(\x04\x12\x14\n\x0cmax_respawns\x18> \x01(\x04\x12\x15\n\rrespawn_delay\x18? \x01(\x04\x12\x15\n\rcreation_time\x18\x46 \x01(\x04\x12\x12\n\nstart_time\x18G \x01(\x04\x12\x12\n\ndeath_time\x18H \x01(\x04\x12\x13\n\x0b\x63hange_time\x18I \x01(\x04\x12\x12\n\nno_changes\x18J \x01(\x08\x12\x35\n\x0b\x63ontrollers\x18P \x01(\x0b\x32 .Porto.rpc.TContainerControllers\x12-\n\x07\x63groups\x18Q \x01(\x0b\x32\x1c.Porto.rpc.TContainerCgroups\x12\x12\n\ncpu_policy\x18\x64 \x01(\t\x12\x12\n\ncpu_weight\x18\x65 \x01(\x01\x12\x15\n\rcpu_guarantee\x18\x66 \x01(\x01\x12\x1b\n\x13\x63pu_guarantee_total\x18g \x01(\x01\x12\x11\n\tcpu_limit\x18h \x01(\x01\x12\x17\n\x0f\x63pu_limit_total\x18i \x01(\x01\x12\x12\n\ncpu_period\x18j \x01(\x04\x12,\n\x07\x63pu_set\x18k \x01(\x0b\x32\x1b.Porto.rpc.TContainerCpuSet\x12\x35\n\x10\x63pu_set_affinity\x18l \x01(\x0b\x32\x1b.Porto.rpc.TContainerCpuSet\x12\x11\n\tcpu_usage\x18m \x01(\x04\x12\x18\n\x10\x63pu_usage_system\x18n \x01(\x04\x12\x10\n\x08\x63pu_wait\x18o \x01(\x04\x12\x15\n\rcpu_throttled\x18p \x01(\x04\x12\x15\n\rprocess_count\x18x \x01(\x04\x12\x14\n\x0cthread_count\x18y \x01(\x04\x12\x14\n\x0cthread_limit\x18z \x01(\x04\x12\x12\n\tio_policy\x18\xc9\x01 \x01(\t\x12\x12\n\tio_weight\x18\xca\x01 \x01(\x01\x12&\n\x08io_limit\x18\xcc\x01 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12*\n\x0cio_ops_limit\x18\xcd\x01 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12%\n\x07io_read\x18\xce\x01 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12&\n\x08io_write\x18\xcf\x01 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12$\n\x06io_ops\x18\xd0\x01 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12%\n\x07io_time\x18\xd1\x01 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12\x15\n\x0cmemory_usage\x18\xd4\x02 \x01(\x04\x12\x19\n\x10memory_guarantee\x18\xd5\x02 \x01(\x04\x12\x1f\n\x16memory_guarantee_total\x18\xd6\x02 \x01(\x04\x12\x15\n\x0cmemory_limit\x18\xd7\x02 \x01(\x04\x12\x1b\n\x12memory_limit_total\x18\xd8\x02 \x01(\x04\x12\x13\n\nanon_usage\x18\xd9\x02 \x01(\x04\x12\x17\n\x0e\x61non_max_usage\x18\xda\x02 \x01(\x04\x12\x13\n\nanon_limit\x18\xdb\x02 \x01(\x04\x12\x19\n\x10\x61non_limit_total\x18\xdc\x02 \x01(\x04\x12\x14\n\x0b\x63\x61\x63he_usage\x18\xdd\x02 \x01(\x04\x12\x14\n\x0b\x64irty_limit\x18\xde\x02 \x01(\x04\x12\x16\n\rhugetlb_usage\x18\xdf\x02 \x01(\x04\x12\x16\n\rhugetlb_limit\x18\xe0\x02 \x01(\x04\x12\x1c\n\x13recharge_on_pgfault\x18\xe1\x02 \x01(\x08\x12\x1c\n\x13pressurize_on_death\x18\xe2\x02 \x01(\x08\x12\x12\n\tanon_only\x18\xe3\x02 \x01(\x08\x12\x15\n\x0cminor_faults\x18\xe4\x02 \x01(\x04\x12\x15\n\x0cmajor_faults\x18\xe5\x02 \x01(\x04\x12\x19\n\x10memory_reclaimed\x18\xe6\x02 \x01(\x04\x12+\n\x0evirtual_memory\x18\xe7\x02 \x01(\x0b\x32\x12.Porto.rpc.TVmStat\x12\x12\n\toom_kills\x18\x86\x03 \x01(\x04\x12\x18\n\x0foom_kills_total\x18\x87\x03 \x01(\x04\x12\x16\n\room_score_adj\x18\x88\x03 \x01(\x05\x12\x13\n\noom_killed\x18\x89\x03 \x01(\x08\x12\x15\n\x0coom_is_fatal\x18\x8a\x03 \x01(\x08\x12,\n\x03net\x18\x90\x03 \x01(\x0b\x32\x1e.Porto.rpc.TContainerNetConfig\x12/\n\x08ip_limit\x18\x91\x03 \x01(\x0b\x32\x1c.Porto.rpc.TContainerIpLimit\x12*\n\x02ip\x18\x92\x03 \x01(\x0b\x32\x1d.Porto.rpc.TContainerIpConfig\x12\x32\n\ndefault_gw\x18\x93\x03 \x01(\x0b\x32\x1d.Porto.rpc.TContainerIpConfig\x12\x11\n\x08hostname\x18\x94\x03 \x01(\t\x12\x14\n\x0bresolv_conf\x18\x95\x03 \x01(\t\x12\x12\n\tetc_hosts\x18\x96\x03 \x01(\t\x12&\n\x06sysctl\x18\x97\x03 \x01(\x0b\x32\x15.Porto.rpc.TStringMap\x12+\n\rnet_guarantee\x18\x98\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12\'\n\tnet_limit\x18\x99\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12*\n\x0cnet_rx_limit\x18\x9a\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12*\n\x0cnet_class_id\x18\x9b\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12\x10\n\x07net_tos\x18\x9c\x03 \x01(\t\x12\'\n\tnet_bytes\x18\xa5\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12)\n\x0bnet_packets\x18\xa6\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12\'\n\tnet_drops\x18\xa7\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12,\n\x0enet_overlimits\x18\xa8\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12*\n\x0cnet_rx_bytes\x18\xa9\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12,\n\x0enet_rx_packets\x18\xaa\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12*\n\x0cnet_rx_drops\x18\xab\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12*\n\x0cnet_tx_bytes\x18\xac\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12,\n\x0enet_tx_packets\x18\xad\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12*\n\x0cnet_tx_drops\x18\xae\x03 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12\x39\n\x0evolumes_linked\x18\xf4\x03 \x01(\x0b\x32 .Porto.rpc.TContainerVolumeLinks\x12\x37\n\x10volumes_required\x18\xf5\x03 \x01(\x0b\x32\x1c.Porto.rpc.TContainerVolumes\x12\x34\n\rvolumes_owned\x18\xf6\x03 \x01(\x0b\x32\x1c.Porto.rpc.TContainerVolumes\x12!\n\x05\x65rror\x18\xe8\x07 \x03(\x0b\x32\x11.Porto.rpc.TError\x12#\n\x07warning\x18\xe9\x07 \x03(\x0b\x32\x11.Porto.rpc.TError\x12!\n\x05taint\x18\xea\x07 \x03(\x0b\x32\x11.Porto.rpc.TError\".\n\x0fTVolumeProperty\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\r\n\x05value\x18\x02 \x02(\t\"\xb6\x01\n\x12TVolumeDescription\x12\x0c\n\x04path\x18\x01 \x02(\t\x12.\n\nproperties\x18\x02 \x03(\x0b\x32\x1a.Porto.rpc.TVolumeProperty\x12\x12\n\ncontainers\x18\x03 \x03(\t\x12%\n\x05links\x18\x04 \x03(\x0b\x32\x16.Porto.rpc.TVolumeLink\x12\x13\n\x0b\x63hange_time\x18\x05 \x01(\x04\x12\x12\n\nno_changes\x18\x06 \x01(\x08\"j\n\x0bTVolumeLink\x12\x11\n\tcontainer\x18\x01 \x02(\t\x12\x0e\n\x06target\x18\x02 \x01(\t\x12\x10\n\x08required\x18\x03 \x01(\x08\x12\x11\n\tread_only\x18\x04 \x01(\x08\x12\x13\n\x0bhost_target\x18\x05 \x01(\t\"U\n\x0fTVolumeResource\x12\r\n\x05limit\x18\x01 \x01(\x04\x12\x11\n\tguarantee\x18\x02 \x01(\x04\x12\r\n\x05usage\x18\x03 \x01(\x04\x12\x11\n\tavailable\x18\x04 \x01(\x04\"U\n\x10TVolumeDirectory\x12\x0c\n\x04path\x18\x01 \x02(\t\x12\x1e\n\x04\x63red\x18\x02 \x01(\x0b\x32\x10.Porto.rpc.TCred\x12\x13\n\x0bpermissions\x18\x03 \x01(\x07\"3\n\x0eTVolumeSymlink\x12\x0c\n\x04path\x18\x01 \x02(\t\x12\x13\n\x0btarget_path\x18\x02 \x02(\t\">\n\x0cTVolumeShare\x12\x0c\n\x04path\x18\x01 \x02(\t\x12\x13\n\x0borigin_path\x18\x02 \x02(\t\x12\x0b\n\x03\x63ow\x18\x03 \x01(\x08\"\xc8\x05\n\x0bTVolumeSpec\x12\x0c\n\x04path\x18\x01 \x01(\t\x12\x11\n\tcontainer\x18\x02 \x01(\t\x12%\n\x05links\x18\x03 \x03(\x0b\x32\x16.Porto.rpc.TVolumeLink\x12\n\n\x02id\x18\x04 \x01(\t\x12\r\n\x05state\x18\x05 \x01(\t\x12\x15\n\rprivate_value\x18\x06 \x01(\t\x12\x13\n\x0b\x64\x65vice_name\x18\x07 \x01(\t\x12\x0f\n\x07\x62\x61\x63kend\x18\n \x01(\t\x12\r\n\x05place\x18\x0b \x01(\t\x12\x0f\n\x07storage\x18\x0c \x01(\t\x12\x0e\n\x06layers\x18\r \x03(\t\x12\x11\n\tread_only\x18\x0e \x01(\x08\x12\x1e\n\x04\x63red\x18\x14 \x01(\x0b\x32\x10.Porto.rpc.TCred\x12\x13\n\x0bpermissions\x18\x15 \x01(\x07\x12)\n\x05space\x18\x16 \x01(\x0b\x32\x1a.Porto.rpc.TVolumeResource\x12*\n\x06inodes\x18\x17 \x01(\x0b\x32\x1a.Porto.rpc.TVolumeResource\x12\x1f\n\x05owner\x18\x1e \x01(\x0b\x32\x10.Porto.rpc.TCred\x12\x17\n\x0fowner_container\x18\x1f \x01(\t\x12\x11\n\tplace_key\x18  \x01(\t\x12\x0f\n\x07\x63reator\x18! \x01(\t\x12\x11\n\tauto_path\x18\" \x01(\x08\x12\x14\n\x0c\x64\x65vice_index\x18# \x01(\r\x12\x12\n\nbuild_time\x18% \x01(\x04\x12\x30\n\x0b\x64irectories\x18( \x03(\x0b\x32\x1b.Porto.rpc.TVolumeDirectory\x12+\n\x08symlinks\x18) \x03(\x0b\x32\x19.Porto.rpc.TVolumeSymlink\x12\'\n\x06shares\x18* \x03(\x0b\x32\x17.Porto.rpc.TVolumeShare\x12\x13\n\x0b\x63hange_time\x18\x32 \x01(\x04\x12\x12\n\nno_changes\x18\x33 \x01(\x08\"u\n\x11TLayerDescription\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x12\n\nowner_user\x18\x02 \x02(\t\x12\x13\n\x0bowner_group\x18\x03 \x02(\t\x12\x12\n\nlast_usage\x18\x04 \x02(\x04\x12\x15\n\rprivate_value\x18\x05 \x02(\t\"w\n\x13TStorageDescription\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x12\n\nowner_user\x18\x02 \x02(\t\x12\x13\n\x0bowner_group\x18\x03 \x02(\t\x12\x12\n\nlast_usage\x18\x04 \x02(\x04\x12\x15\n\rprivate_value\x18\x05 \x02(\t\"\x83\x02\n\x0cTMetaStorage\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\r\n\x05place\x18\x02 \x01(\t\x12\x15\n\rprivate_value\x18\x03 \x01(\t\x12\x13\n\x0bspace_limit\x18\x04 \x01(\x04\x12\x13\n\x0binode_limit\x18\x05 \x01(\x04\x12\x12\n\nspace_used\x18\x06 \x01(\x04\x12\x17\n\x0fspace_available\x18\x07 \x01(\x04\x12\x12\n\ninode_used\x18\x08 \x01(\x04\x12\x17\n\x0finode_available\x18\t \x01(\x04\x12\x12\n\nowner_user\x18\n \x01(\t\x12\x13\n\x0bowner_group\x18\x0b \x01(\t\x12\x12\n\nlast_usage\x18\x0c \x01(\x04\"\x11\n\x0fTVersionRequest\"1\n\x10TVersionResponse\x12\x0b\n\x03tag\x18\x01 \x02(\t\x12\x10\n\x08revision\x18\x02 \x02(\t\"\x13\n\x11TGetSystemRequest\"\x9d\x0b\n\x12TGetSystemResponse\x12\x15\n\rporto_version\x18\x01 \x02(\t\x12\x16\n\x0eporto_revision\x18\x02 \x02(\t\x12\x16\n\x0ekernel_version\x18\x03 \x02(\t\x12\x0e\n\x06\x65rrors\x18\x04 \x02(\x06\x12\x10\n\x08warnings\x18\x05 \x02(\x06\x12\x14\n\x0cporto_starts\x18\x06 \x02(\x06\x12\x14\n\x0cporto_uptime\x18\x07 \x02(\x06\x12\x15\n\rmaster_uptime\x18\x08 \x02(\x06\x12\x0e\n\x06taints\x18\t \x01(\x06\x12\x0e\n\x06\x66rozen\x18\n \x01(\x08\x12\x0f\n\x07verbose\x18\x64 \x02(\x08\x12\r\n\x05\x64\x65\x62ug\x18\x65 \x02(\x08\x12\x11\n\tlog_lines\x18\x66 \x02(\x06\x12\x11\n\tlog_bytes\x18g \x02(\x06\x12\x1b\n\x13stream_rotate_bytes\x18h \x02(\x06\x12\x1c\n\x14stream_rotate_errors\x18i \x02(\x06\x12\x16\n\x0elog_lines_lost\x18j \x02(\x06\x12\x16\n\x0elog_bytes_lost\x18k \x02(\x06\x12\x10\n\x08log_open\x18l \x02(\x06\x12\x18\n\x0f\x63ontainer_count\x18\xc8\x01 \x02(\x06\x12\x18\n\x0f\x63ontainer_limit\x18\xc9\x01 \x02(\x06\x12\x1a\n\x11\x63ontainer_running\x18\xca\x01 \x02(\x06\x12\x1a\n\x11\x63ontainer_created\x18\xcb\x01 \x02(\x06\x12\x1a\n\x11\x63ontainer_started\x18\xcc\x01 \x02(\x06\x12\x1f\n\x16\x63ontainer_start_failed\x18\xcd\x01 \x02(\x06\x12\x16\n\rcontainer_oom\x18\xce\x01 \x02(\x06\x12\x19\n\x10\x63ontainer_buried\x18\xcf\x01 \x02(\x06\x12\x17\n\x0e\x63ontainer_lost\x18\xd0\x01 \x02(\x06\x12\x1a\n\x11\x63ontainer_tainted\x18\xd1\x01 \x01(\x06\x12\x15\n\x0cvolume_count\x18\xac\x02 \x02(\x06\x12\x15\n\x0cvolume_limit\x18\xad\x02 \x02(\x06\x12\x17\n\x0evolume_created\x18\xaf\x02 \x02(\x06\x12\x16\n\rvolume_failed\x18\xb0\x02 \x02(\x06\x12\x15\n\x0cvolume_links\x18\xb1\x02 \x02(\x06\x12\x1d\n\x14volume_links_mounted\x18\xb2\x02 \x02(\x06\x12\x14\n\x0bvolume_lost\x18\xb3\x02 \x02(\x06\x12\x15\n\x0clayer_import\x18\x86\x03 \x02(\x06\x12\x15\n\x0clayer_export\x18\x87\x03 \x02(\x06\x12\x15\n\x0clayer_remove\x18\x88\x03 \x02(\x06\x12\x15\n\x0c\x63lient_count\x18\x90\x03 \x02(\x06\x12\x13\n\nclient_max\x18\x91\x03 \x02(\x06\x12\x19\n\x10\x63lient_connected\x18\x92\x03 \x02(\x06\x12\x17\n\x0erequest_queued\x18\xf4\x03 \x02(\x06\x12\x1a\n\x11request_completed\x18\xf5\x03 \x02(\x06\x12\x17\n\x0erequest_failed\x18\xf6\x03 \x02(\x06\x12\x18\n\x0frequest_threads\x18\xf7\x03 \x02(\x06\x12\x1a\n\x11request_longer_1s\x18\xf8\x03 \x02(\x06\x12\x1a\n\x11request_longer_3s\x18\xf9\x03 \x02(\x06\x12\x1b\n\x12request_longer_30s\x18\xfa\x03 \x02(\x06\x12\x1a\n\x11request_longer_5m\x18\xfb\x03 \x02(\x06\x12\x14\n\x0b\x66\x61il_system\x18\xd8\x04 \x02(\x06\x12\x1b\n\x12\x66\x61il_invalid_value\x18\xd9\x04 \x02(\x06\x12\x1d\n\x14\x66\x61il_invalid_command\x18\xda\x04 \x02(\x06\x12\x1e\n\x15\x66\x61il_memory_guarantee\x18\xdb\x04 \x01(\x06\x12\x16\n\rnetwork_count\x18\xbc\x05 \x01(\x06\x12\x18\n\x0fnetwork_created\x18\xbd\x05 \x01(\x06\x12\x19\n\x10network_problems\x18\xbe\x05 \x01(\x06\x12\x18\n\x0fnetwork_repairs\x18\xbf\x05 \x01(\x06\"C\n\x11TSetSystemRequest\x12\x0e\n\x06\x66rozen\x18\n \x01(\x08\x12\x0f\n\x07verbose\x18\x64 \x01(\x08\x12\r\n\x05\x64\x65\x62ug\x18\x65 \x01(\x08\"\x14\n\x12TSetSystemResponse\"{\n\x14TNewContainerRequest\x12,\n\tcontainer\x18\x01 \x02(\x0b\x32\x19.Porto.rpc.TContainerSpec\x12&\n\x06volume\x18\x02 \x03(\x0b\x32\x16.Porto.rpc.TVolumeSpec\x12\r\n\x05start\x18\x03 \x01(\x08\"m\n\x15TNewContainerResponse\x12,\n\tcontainer\x18\x01 \x02(\x0b\x32\x19.Porto.rpc.TContainerSpec\x12&\n\x06volume\x18\x02 \x03(\x0b\x32\x16.Porto.rpc.TVolumeSpec\"D\n\x14TSetContainerRequest\x12,\n\tcontainer\x18\x01 \x02(\x0b\x32\x19.Porto.rpc.TContainerSpec\"\x17\n\x15TSetContainerResponse\"\\\n\x14TGetContainerRequest\x12\x0c\n\x04name\x18\x01 \x03(\t\x12\r\n\x05label\x18\x02 \x03(\t\x12\x10\n\x08property\x18\x03 \x03(\t\x12\x15\n\rchanged_since\x18\x04 \x01(\x04\"a\n\x15TGetContainerResponse\x12,\n\tcontainer\x18\x01 \x03(\x0b\x32\x19.Porto.rpc.TContainerSpec\x12\x1a\n\x12\x61\x62solute_namespace\x18\x02 \x01(\t\"\xf3\x02\n\x10TContainerSample\x12\x0c\n\x04time\x18\x01 \x02(\x04\x12\x11\n\tcpu_usage\x18\x02 \x01(\x04\x12\x18\n\x10\x63pu_usage_system\x18\x03 \x01(\x04\x12\x14\n\x0cmemory_usage\x18\x04 \x01(\x04\x12\x12\n\nanon_usage\x18\x05 \x01(\x04\x12\x0f\n\x07io_read\x18\x06 \x01(\x04\x12\x10\n\x08io_write\x18\x07 \x01(\x04\x12\x0e\n\x06io_ops\x18\x08 \x01(\x04\x12\x14\n\x0cnet_rx_bytes\x18\t \x01(\x04\x12\x14\n\x0cnet_tx_bytes\x18\n \x01(\x04\x12\x16\n\x0e\x63pu_usage_rate\x18\x14 \x01(\x04\x12\x17\n\x0f\x63pu_system_rate\x18\x15 \x01(\x04\x12\x14\n\x0cio_read_rate\x18\x16 \x01(\x04\x12\x15\n\rio_write_rate\x18\x17 \x01(\x04\x12\x13\n\x0bio_ops_rate\x18\x18 \x01(\x04\x12\x13\n\x0bnet_rx_rate\x18\x19 \x01(\x04\x12\x13\n\x0bnet_tx_rate\x18\x1a \x01(\x04\"p\n\x11TContainerSamples\x12\x0c\n\x04name\x18\x01 \x02(\t\x12+\n\x06sample\x18\x02 \x03(\x0b\x32\x1b.Porto.rpc.TContainerSample\x12 \n\x05\x65rror\x18\x03 \x01(\x0b\x32\x11.Porto.rpc.TError\"1\n\x12TGetSamplesRequest\x12\x0c\n\x04name\x18\x01 \x03(\t\x12\r\n\x05\x63ount\x18\x02 \x01(\r\"[\n\x13TGetSamplesResponse\x12/\n\tcontainer\x18\x01 \x03(\x0b\x32\x1c.Porto.rpc.TContainerSamples\x12\x13\n\x0binterval_ms\x18\x02 \x01(\x04\"\x84\x01\n\x0eTContainerStat\x12\x12\n\nuint_value\x18\x01 \x01(\x04\x12&\n\tmap_value\x18\x02 \x01(\x0b\x32\x13.Porto.rpc.TUintMap\x12\x14\n\x0cstring_value\x18\x03 \x01(\t\x12 \n\x05\x65rror\x18\x04 \x01(\x0b\x32\x11.Porto.rpc.TError\"j\n\x0fTContainerStats\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\'\n\x04stat\x18\x02 \x03(\x0b\x32\x19.Porto.rpc.TContainerStat\x12 \n\x05\x65rror\x18\x03 \x01(\x0b\x32\x11.Porto.rpc.TError\"2\n\x10TGetStatsRequest\x12\x0c\n\x04name\x18\x01 \x03(\t\x12\x10\n\x08property\x18\x02 \x03(\t\"B\n\x11TGetStatsResponse\x12-\n\tcontainer\x18\x01 \x03(\x0b\x32\x1a.Porto.rpc.TContainerStats\"(\n\x13TListChangesRequest\x12\x11\n\tsince_gen\x18\x01 \x01(\x04\"C\n\x0eTChangedObject\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x12\n\ngeneration\x18\x02 \x02(\x04\x12\x0f\n\x07removed\x18\x03 \x01(\x08\"\x91\x01\n\x14TListChangesResponse\x12\x12\n\ngeneration\x18\x01 \x02(\x04\x12\x0c\n\x04\x66ull\x18\x02 \x01(\x08\x12,\n\tcontainer\x18\x03 \x03(\x0b\x32\x19.Porto.rpc.TChangedObject\x12)\n\x06volume\x18\x04 \x03(\x0b\x32\x19.Porto.rpc.TChangedObject\"\x1f\n\x1dTContainerPropertyListRequest\"\xd4\x01\n\x1eTContainerPropertyListResponse\x12S\n\x04list\x18\x01 \x03(\x0b\x32\x45.Porto.rpc.TContainerPropertyListResponse.TContainerPropertyListEntry\x1a]\n\x1bTContainerPropertyListEntry\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0c\n\x04\x64\x65sc\x18\x02 \x02(\t\x12\x11\n\tread_only\x18\x03 \x01(\x08\x12\x0f\n\x07\x64ynamic\x18\x04 \x01(\x08\"\x1b\n\x19TContainerDataListRequest\"\xa0\x01\n\x1aTContainerDataListResponse\x12K\n\x04list\x18\x01 \x03(\x0b\x32=.Porto.rpc.TContainerDataListResponse.TContainerDataListEntry\x1a\x35\n\x17TContainerDataListEntry\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0c\n\x04\x64\x65sc\x18\x02 \x02(\t\"\'\n\x17TContainerCreateRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\"(\n\x18TContainerDestroyRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\"K\n\x15TContainerListRequest\x12\x0c\n\x04mask\x18\x01 \x01(\t\x12\x15\n\rchanged_since\x18\x02 \x01(\x04\x12\r\n\x05label\x18\x03 \x03(\t\"B\n\x16TContainerListResponse\x12\x0c\n\x04name\x18\x01 \x03(\t\x12\x1a\n\x12\x61\x62solute_namespace\x18\x02 \x01(\t\"Z\n\x1cTContainerGetPropertyRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x10\n\x08property\x18\x02 \x02(\t\x12\x0c\n\x04sync\x18\x03 \x01(\x08\x12\x0c\n\x04real\x18\x04 \x01(\x08\".\n\x1dTContainerGetPropertyResponse\x12\r\n\x05value\x18\x01 \x02(\t\"R\n\x18TContainerGetDataRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0c\n\x04\x64\x61ta\x18\x02 \x02(\t\x12\x0c\n\x04sync\x18\x03 \x01(\x08\x12\x0c\n\x04real\x18\x04 \x01(\x08\"*\n\x19TContainerGetDataResponse\x12\r\n\x05value\x18\x01 \x02(\t\"M\n\x1cTContainerSetPropertyRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x10\n\x08property\x18\x02 \x02(\t\x12\r\n\x05value\x18\x03 \x02(\t\"\x8a\x01\n\x14TContainerGetRequest\x12\x0c\n\x04name\x18\x01 \x03(\t\x12\x10\n\x08variable\x18\x02 \x03(\t\x12\x10\n\x08nonblock\x18\x03 \x01(\x08\x12\x0c\n\x04sync\x18\x04 \x01(\x08\x12\x0c\n\x04real\x18\x05 \x01(\x08\x12\x15\n\rchanged_since\x18\x06 \x01(\x04\x12\r\n\x05label\x18\x07 \x03(\t\"\xf6\x02\n\x15TContainerGetResponse\x12H\n\x04list\x18\x01 \x03(\x0b\x32:.Porto.rpc.TContainerGetResponse.TContainerGetListResponse\x1aq\n\x1aTContainerGetValueResponse\x12\x10\n\x08variable\x18\x01 \x02(\t\x12 \n\x05\x65rror\x18\x02 \x01(\x0e\x32\x11.Porto.rpc.EError\x12\x10\n\x08\x65rrorMsg\x18\x03 \x01(\t\x12\r\n\x05value\x18\x04 \x01(\t\x1a\x9f\x01\n\x19TContainerGetListResponse\x12\x0c\n\x04name\x18\x01 \x02(\t\x12K\n\x06keyval\x18\x02 \x03(\x0b\x32;.Porto.rpc.TContainerGetResponse.TContainerGetValueResponse\x12\x13\n\x0b\x63hange_time\x18\x03 \x01(\x04\x12\x12\n\nno_changes\x18\x04 \x01(\x08\"&\n\x16TContainerStartRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\"(\n\x18TContainerRespawnRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\"9\n\x15TContainerStopRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x12\n\ntimeout_ms\x18\x02 \x01(\r\"&\n\x16TContainerPauseRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\"\'\n\x17TContainerResumeRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\"H\n\x13TConvertPathRequest\x12\x0c\n\x04path\x18\x01 \x02(\t\x12\x0e\n\x06source\x18\x02 \x02(\t\x12\x13\n\x0b\x64\x65stination\x18\x03 \x02(\t\"$\n\x14TConvertPathResponse\x12\x0c\n\x04path\x18\x01 \x02(\t\"X\n\x15TContainerWaitRequest\x12\x0c\n\x04name\x18\x01 \x03(\t\x12\x12\n\ntimeout_ms\x18\x02 \x01(\r\x12\r\n\x05label\x18\x03 \x03(\t\x12\x0e\n\x06volume\x18\x04 \x03(\t\"a\n\x16TContainerWaitResponse\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\r\n\x05state\x18\x02 \x01(\t\x12\x0c\n\x04when\x18\x03 \x01(\x04\x12\r\n\x05label\x18\x04 \x01(\t\x12\r\n\x05value\x18\x05 \x01(\t\"f\n\x14TFollowStreamRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0e\n\x06stream\x18\x02 \x01(\t\x12\x0e\n\x06offset\x18\x03 \x01(\x04\x12\x12\n\nchunk_size\x18\x04 \x01(\x04\x12\x0c\n\x04stop\x18\x05 \x01(\x08\"`\n\x15TFollowStreamResponse\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0e\n\x06stream\x18\x02 \x02(\t\x12\x0e\n\x06offset\x18\x03 \x01(\x04\x12\x0c\n\x04\x64\x61ta\x18\x04 \x01(\x0c\x12\x0b\n\x03\x65nd\x18\x05 \x01(\x08\"2\n\x15TContainerKillRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0b\n\x03sig\x18\x02 \x02(\x05\"@\n\x15TAttachProcessRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0b\n\x03pid\x18\x02 \x02(\r\x12\x0c\n\x04\x63omm\x18\x03 \x02(\t\"2\n\x15TLocateProcessRequest\x12\x0b\n\x03pid\x18\x01 \x02(\r\x12\x0c\n\x04\x63omm\x18\x02 \x02(\t\"&\n\x16TLocateProcessResponse\x12\x0c\n\x04name\x18\x01 \x02(\t\"N\n\x11TFindLabelRequest\x12\x0c\n\x04mask\x18\x01 \x01(\t\x12\r\n\x05state\x18\x02 \x01(\t\x12\r\n\x05label\x18\x03 \x02(\t\x12\r\n\x05value\x18\x04 \x01(\t\"\x9f\x01\n\x12TFindLabelResponse\x12;\n\x04list\x18\x01 \x03(\x0b\x32-.Porto.rpc.TFindLabelResponse.TFindLabelEntry\x1aL\n\x0fTFindLabelEntry\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\r\n\x05state\x18\x02 \x02(\t\x12\r\n\x05label\x18\x03 \x02(\t\x12\r\n\x05value\x18\x04 \x02(\t\"a\n\x10TSetLabelRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\r\n\x05label\x18\x02 \x02(\t\x12\r\n\x05value\x18\x03 \x02(\t\x12\x12\n\nprev_value\x18\x04 \x01(\t\x12\r\n\x05state\x18\x05 \x01(\t\"6\n\x11TSetLabelResponse\x12\x12\n\nprev_value\x18\x01 \x01(\t\x12\r\n\x05state\x18\x02 \x01(\t\"?\n\x10TIncLabelRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\r\n\x05label\x18\x02 \x02(\t\x12\x0e\n\x03\x61\x64\x64\x18\x03 \x01(\x03:\x01\x31\"#\n\x11TIncLabelResponse\x12\x0e\n\x06result\x18\x01 \x02(\x03\"H\n\x12TSetSymlinkRequest\x12\x11\n\tcontainer\x18\x01 \x02(\t\x12\x0f\n\x07symlink\x18\x02 \x02(\t\x12\x0e\n\x06target\x18\x03 \x01(\t\"P\n\x11TNewVolumeRequest\x12&\n\x06volume\x18\x01 \x02(\x0b\x32\x16.Porto.rpc.TVolumeSpec\x12\x13\n\x0b\x61sync_build\x18\x02 \x01(\x08\"<\n\x12TNewVolumeResponse\x12&\n\x06volume\x18\x01 \x02(\x0b\x32\x16.Porto.rpc.TVolumeSpec\"Y\n\x11TGetVolumeRequest\x12\x11\n\tcontainer\x18\x01 \x01(\t\x12\x0c\n\x04path\x18\x02 \x03(\t\x12\x15\n\rchanged_since\x18\x03 \x01(\x04\x12\x0c\n\x04sync\x18\x04 \x01(\x08\"<\n\x12TGetVolumeResponse\x12&\n\x06volume\x18\x01 \x03(\x0b\x32\x16.Porto.rpc.TVolumeSpec\"\x1c\n\x1aTVolumePropertyListRequest\"\xae\x01\n\x1bTVolumePropertyListResponse\x12U\n\nproperties\x18\x01 \x03(\x0b\x32\x41.Porto.rpc.TVolumePropertyListResponse.TVolumePropertyDescription\x1a\x38\n\x1aTVolumePropertyDescription\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0c\n\x04\x64\x65sc\x18\x02 \x02(\t\"i\n\x14TVolumeCreateRequest\x12\x0c\n\x04path\x18\x01 \x01(\t\x12.\n\nproperties\x18\x02 \x03(\x0b\x32\x1a.Porto.rpc.TVolumeProperty\x12\x13\n\x0b\x61sync_build\x18\x03 \x01(\x08\"j\n\x12TVolumeLinkRequest\x12\x0c\n\x04path\x18\x01 \x02(\t\x12\x11\n\tcontainer\x18\x02 \x01(\t\x12\x0e\n\x06target\x18\x03 \x01(\t\x12\x10\n\x08required\x18\x04 \x01(\x08\x12\x11\n\tread_only\x18\x05 \x01(\x08\"W\n\x14TVolumeUnlinkRequest\x12\x0c\n\x04path\x18\x01 \x02(\t\x12\x11\n\tcontainer\x18\x02 \x01(\t\x12\x0e\n\x06strict\x18\x03 \x01(\x08\x12\x0e\n\x06target\x18\x04 \x01(\t\"Z\n\x12TVolumeListRequest\x12\x0c\n\x04path\x18\x01 \x01(\t\x12\x11\n\tcontainer\x18\x02 \x01(\t\x12\x15\n\rchanged_since\x18\x03 \x01(\x04\x12\x0c\n\x04sync\x18\x04 \x01(\x08\"E\n\x13TVolumeListResponse\x12.\n\x07volumes\x18\x01 \x03(\x0b\x32\x1d.Porto.rpc.TVolumeDescription\"R\n\x12TVolumeTuneRequest\x12\x0c\n\x04path\x18\x01 \x02(\t\x12.\n\nproperties\x18\x02 \x03(\x0b\x32\x1a.Porto.rpc.TVolumeProperty\"0\n\x11TLayerListRequest\x12\r\n\x05place\x18\x01 \x01(\t\x12\x0c\n\x04mask\x18\x02 \x01(\t\"\xaf\x01\n\x12TLayerListResponse\x12\r\n\x05layer\x18\x01 \x03(\t\x12,\n\x06layers\x18\x02 \x03(\x0b\x32\x1c.Porto.rpc.TLayerDescription\x12\x13\n\x0b\x64\x65\x64up_files\x18\x03 \x01(\x04\x12\x13\n\x0b\x64\x65\x64up_bytes\x18\x04 \x01(\x04\x12\x32\n\timporting\x18\x05 \x03(\x0b\x32\x1f.Porto.rpc.TLayerImportProgress\"\x82\x01\n\x14TLayerImportProgress\x12\r\n\x05layer\x18\x01 \x02(\t\x12\x14\n\x0c\x61rchive_size\x18\x02 \x01(\x04\x12\x14\n\x0c\x61rchive_read\x18\x03 \x01(\x04\x12\x0f\n\x07\x65ntries\x18\x04 \x01(\x04\x12\r\n\x05\x62ytes\x18\x05 \x01(\x04\x12\x0f\n\x07time_ms\x18\x06 \x01(\x04\"|\n\x13TLayerImportRequest\x12\r\n\x05layer\x18\x01 \x02(\t\x12\x0f\n\x07tarball\x18\x02 \x02(\t\x12\r\n\x05merge\x18\x03 \x02(\x08\x12\r\n\x05place\x18\x04 \x01(\t\x12\x15\n\rprivate_value\x18\x05 \x01(\t\x12\x10\n\x08\x63ompress\x18\x06 \x01(\t\"f\n\x13TLayerExportRequest\x12\x0e\n\x06volume\x18\x01 \x02(\t\x12\x0f\n\x07tarball\x18\x02 \x02(\t\x12\r\n\x05layer\x18\x03 \x01(\t\x12\r\n\x05place\x18\x04 \x01(\t\x12\x10\n\x08\x63ompress\x18\x05 \x01(\t\"3\n\x13TLayerRemoveRequest\x12\r\n\x05layer\x18\x01 \x02(\t\x12\r\n\x05place\x18\x02 \x01(\t\"7\n\x17TLayerGetPrivateRequest\x12\r\n\x05layer\x18\x01 \x02(\t\x12\r\n\x05place\x18\x02 \x01(\t\"1\n\x18TLayerGetPrivateResponse\x12\x15\n\rprivate_value\x18\x01 \x01(\t\"N\n\x17TLayerSetPrivateRequest\x12\r\n\x05layer\x18\x01 \x02(\t\x12\r\n\x05place\x18\x02 \x01(\t\x12\x15\n\rprivate_value\x18\x03 \x02(\t\"2\n\x13TStorageListRequest\x12\r\n\x05place\x18\x01 \x01(\t\x12\x0c\n\x04mask\x18\x02 \x01(\t\"x\n\x14TStorageListResponse\x12\x30\n\x08storages\x18\x01 \x03(\x0b\x32\x1e.Porto.rpc.TStorageDescription\x12.\n\rmeta_storages\x18\x02 \x03(\x0b\x32\x17.Porto.rpc.TMetaStorage\"4\n\x15TStorageRemoveRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\r\n\x05place\x18\x02 \x01(\t\"n\n\x15TStorageImportRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0f\n\x07tarball\x18\x02 \x02(\t\x12\r\n\x05place\x18\x03 \x01(\t\x12\x15\n\rprivate_value\x18\x05 \x01(\t\x12\x10\n\x08\x63ompress\x18\x06 \x01(\t\"W\n\x15TStorageExportRequest\x12\x0c\n\x04name\x18\x01 \x02(\t\x12\x0f\n\x07tarball\x18\x02 \x02(\t\x12\r\n\x05place\x18\x03 \x01(\t\x12\x10\n\x08\x63ompress\x18\x04 \x01(\t*\xaf\x05\n\x06\x45\x45rror\x12\x0b\n\x07Success\x10\x00\x12\x0b\n\x07Unknown\x10\x01\x12\x11\n\rInvalidMethod\x10\x02\x12\x1a\n\x16\x43ontainerAlreadyExists\x10\x03\x12\x19\n\x15\x43ontainerDoesNotExist\x10\x04\x12\x13\n\x0fInvalidProperty\x10\x05\x12\x0f\n\x0bInvalidData\x10\x06\x12\x10\n\x0cInvalidValue\x10\x07\x12\x10\n\x0cInvalidState\x10\x08\x12\x10\n\x0cNotSupported\x10\t\x12\x18\n\x14ResourceNotAvailable\x10\n\x12\x0e\n\nPermission\x10\x0b\x12\x17\n\x13VolumeAlreadyExists\x10\x0c\x12\x12\n\x0eVolumeNotFound\x10\r\x12\x0b\n\x07NoSpace\x10\x0e\x12\x08\n\x04\x42usy\x10\x0f\x12\x17\n\x13VolumeAlreadyLinked\x10\x10\x12\x13\n\x0fVolumeNotLinked\x10\x11\x12\x16\n\x12LayerAlreadyExists\x10\x12\x12\x11\n\rLayerNotFound\x10\x13\x12\x0b\n\x07NoValue\x10\x14\x12\x12\n\x0eVolumeNotReady\x10\x15\x12\x12\n\x0eInvalidCommand\x10\x16\x12\r\n\tLostError\x10\x17\x12\x12\n\x0e\x44\x65viceNotFound\x10\x18\x12\x0f\n\x0bInvalidPath\x10\x19\x12\x19\n\x15InvalidNetworkAddress\x10\x1a\x12\x0f\n\x0bPortoFrozen\x10\x1b\x12\x11\n\rLabelNotFound\x10\x1c\x12\x10\n\x0cInvalidLabel\x10\x1d\x12\r\n\x08NotFound\x10\x94\x03\x12\x10\n\x0bSocketError\x10\xf6\x03\x12\x16\n\x11SocketUnavailable\x10\xf7\x03\x12\x12\n\rSocketTimeout\x10\xf8\x03\x12\n\n\x05Taint\x10\x9a\x05\x12\x0b\n\x06Queued\x10\xe8\x07')
+
+_builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, globals())
+_builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'rpc_pb2', globals())
+if _descriptor._USE_C_DESCRIPTORS == False:
+
+  DESCRIPTOR._options = None
+  _EERROR._serialized_start=22090
+  _EERROR._serialized_end=22777
+  _TPORTOREQUEST._serialized_start=25
+  _TPORTOREQUEST._serialized_end=3208
+  _TPORTORESPONSE._serialized_start=3211
+  _TPORTORESPONSE._serialized_end=4975
+  _TSTRINGMAP._serialized_start=4977
+  _TSTRINGMAP._serialized_end=5101
+  _TSTRINGMAP_TSTRINGMAPENTRY._serialized_start=5058
+  _TSTRINGMAP_TSTRINGMAPENTRY._serialized_end=5101
+  _TUINTMAP._serialized_start=5103
+  _TUINTMAP._serialized_end=5219
+  _TUINTMAP_TUINTMAPENTRY._serialized_start=5178
+  _TUINTMAP_TUINTMAPENTRY._serialized_end=5219
+  _TERROR._serialized_start=5221
+  _TERROR._serialized_end=5287
+  _TCRED._serialized_start=5289
+  _TCRED._serialized_end=5364
+  _TCAPABILITIES._serialized_start=5366
+  _TCAPABILITIES._serialized_end=5407
+  _TCONTAINERCOMMANDARGV._serialized_start=5409
+  _TCONTAINERCOMMANDARGV._serialized_end=5446
+  _TCONTAINERENVVAR._serialized_start=5448
+  _TCONTAINERENVVAR._serialized_end=5510
+  _TCONTAINERENV._serialized_start=5512
+  _TCONTAINERENV._serialized_end=5584
+  _TCONTAINERULIMIT._serialized_start=5586
+  _TCONTAINERULIMIT._serialized_end=5684
+  _TCONTAINERULIMITS._serialized_start=5686
+  _TCONTAINERULIMITS._serialized_end=5765
+  _TCONTAINERCONTROLLERS._serialized_start=5767
+  _TCONTAINERCONTROLLERS._serialized_end=5810
+  _TCONTAINERCGROUP._serialized_start=5812
+  _TCONTAINERCGROUP._serialized_end=5883
+  _TCONTAINERCGROUPS._serialized_start=5885
+  _TCONTAINERCGROUPS._serialized_end=5949
+  _TCONTAINERCPUSET._serialized_start=5951
+  _TCONTAINERCPUSET._serialized_end=6040
+  _TCONTAINERBINDMOUNT._serialized_start=6042
+  _TCONTAINERBINDMOUNT._serialized_end=6109
+  _TCONTAINERBINDMOUNTS._serialized_start=6111
+  _TCONTAINERBINDMOUNTS._serialized_end=6179
+  _TCONTAINERVOLUMELINK._serialized_start=6181
+  _TCONTAINERVOLUMELINK._serialized_end=6272
+  _TCONTAINERVOLUMELINKS._serialized_start=6274
+  _TCONTAINERVOLUMELINKS._serialized_end=6344
+  _TCONTAINERVOLUMES._serialized_start=6346
+  _TCONTAINERVOLUMES._serialized_end=6381
+  _TCONTAINERPLACE._serialized_start=6383
+  _TCONTAINERPLACE._serialized_end=6430
+  _TCONTAINERPLACECONFIG._serialized_start=6432
+  _TCONTAINERPLACECONFIG._serialized_end=6496
+  _TCONTAINERDEVICE._serialized_start=6498
+  _TCONTAINERDEVICE._serialized_end=6548
+  _TCONTAINERDEVICES._serialized_start=6550
+  _TCONTAINERDEVICES._serialized_end=6629
+  _TCONTAINERNETOPTION._serialized_start=6631
+  _TCONTAINERNETOPTION._serialized_end=6678
+  _TCONTAINERNETCONFIG._serialized_start=6680
+  _TCONTAINERNETCONFIG._serialized_end=6765
+  _TCONTAINERIPLIMIT._serialized_start=6767
+  _TCONTAINERIPLIMIT._serialized_end=6814
+  _TCONTAINERIPCONFIG._serialized_start=6816
+  _TCONTAINERIPCONFIG._serialized_end=6934
+  _TCONTAINERIPCONFIG_TCONTAINERIP._serialized_start=6895
+  _TCONTAINERIPCONFIG_TCONTAINERIP._serialized_end=6934
+  _TVMSTAT._serialized_start=6937
+  _TVMSTAT._serialized_end=7170
+  _TCONTAINERSPEC._serialized_start=7173
+  _TCONTAINERSPEC._serialized_end=11481
+  _TVOLUMEPROPERTY._serialized_start=11483
+  _TVOLUMEPROPERTY._serialized_end=11529
+  _TVOLUMEDESCRIPTION._serialized_start=11532
+  _TVOLUMEDESCRIPTION._serialized_end=11714
+  _TVOLUMELINK._serialized_start=11716
+  _TVOLUMELINK._serialized_end=11822
+  _TVOLUMERESOURCE._serialized_start=11824
+  _TVOLUMERESOURCE._serialized_end=11909
+  _TVOLUMEDIRECTORY._serialized_start=11911
+  _TVOLUMEDIRECTORY._serialized_end=11996
+  _TVOLUMESYMLINK._serialized_start=11998
+  _TVOLUMESYMLINK._serialized_end=12049
+  _TVOLUMESHARE._serialized_start=12051
+  _TVOLUMESHARE._serialized_end=12113
+  _TVOLUMESPEC._serialized_start=12116
+  _TVOLUMESPEC._serialized_end=12828
+  _TLAYERDESCRIPTION._serialized_start=12830
+  _TLAYERDESCRIPTION._serialized_end=12947
+  _TSTORAGEDESCRIPTION._serialized_start=12949
+  _TSTORAGEDESCRIPTION._serialized_end=13068
+  _TMETASTORAGE._serialized_start=13071
+  _TMETASTORAGE._serialized_end=13330
+  _TVERSIONREQUEST._serialized_start=13332
+  _TVERSIONREQUEST._serialized_end=13349
+  _TVERSIONRESPONSE._serialized_start=13351
+  _TVERSIONRESPONSE._serialized_end=13400
+  _TGETSYSTEMREQUEST._serialized_start=13402
+  _TGETSYSTEMREQUEST._serialized_end=13421
+  _TGETSYSTEMRESPONSE._serialized_start=13424
+  _TGETSYSTEMRESPONSE._serialized_end=14861
+  _TSETSYSTEMREQUEST._serialized_start=14863
+  _TSETSYSTEMREQUEST._serialized_end=14930
+  _TSETSYSTEMRESPONSE._serialized_start=14932
+  _TSETSYSTEMRESPONSE._serialized_end=14952
+  _TNEWCONTAINERREQUEST._serialized_start=14954
+  _TNEWCONTAINERREQUEST._serialized_end=15077
+  _TNEWCONTAINERRESPONSE._serialized_start=15079
+  _TNEWCONTAINERRESPONSE._serialized_end=15188
+  _TSETCONTAINERREQUEST._serialized_start=15190
+  _TSETCONTAINERREQUEST._serialized_end=15258
+  _TSETCONTAINERRESPONSE._serialized_start=15260
+  _TSETCONTAINERRESPONSE._serialized_end=15283
+  _TGETCONTAINERREQUEST._serialized_start=15285
+  _TGETCONTAINERREQUEST._serialized_end=15377
+  _TGETCONTAINERRESPONSE._serialized_start=15379
+  _TGETCONTAINERRESPONSE._serialized_end=15476
+  _TCONTAINERSAMPLE._serialized_start=15479
+  _TCONTAINERSAMPLE._serialized_end=15850
+  _TCONTAINERSAMPLES._serialized_start=15852
+  _TCONTAINERSAMPLES._serialized_end=15964
+  _TGETSAMPLESREQUEST._serialized_start=15966
+  _TGETSAMPLESREQUEST._serialized_end=16015
+  _TGETSAMPLESRESPONSE._serialized_start=16017
+  _TGETSAMPLESRESPONSE._serialized_end=16108
+  _TCONTAINERSTAT._serialized_start=16111
+  _TCONTAINERSTAT._serialized_end=16243
+  _TCONTAINERSTATS._serialized_start=16245
+  _TCONTAINERSTATS._serialized_end=16351
+  _TGETSTATSREQUEST._serialized_start=16353
+  _TGETSTATSREQUEST._serialized_end=16403
+  _TGETSTATSRESPONSE._serialized_start=16405
+  _TGETSTATSRESPONSE._serialized_end=16471
+  _TLISTCHANGESREQUEST._serialized_start=16473
+  _TLISTCHANGESREQUEST._serialized_end=16513
+  _TCHANGEDOBJECT._serialized_start=16515
+  _TCHANGEDOBJECT._serialized_end=16582
+  _TLISTCHANGESRESPONSE._serialized_start=16585
+  _TLISTCHANGESRESPONSE._serialized_end=16730
+  _TCONTAINERPROPERTYLISTREQUEST._serialized_start=16732
+  _TCONTAINERPROPERTYLISTREQUEST._serialized_end=16763
+  _TCONTAINERPROPERTYLISTRESPONSE._serialized_start=16766
+  _TCONTAINERPROPERTYLISTRESPONSE._serialized_end=16978
+  _TCONTAINERPROPERTYLISTRESPONSE_TCONTAINERPROPERTYLISTENTRY._serialized_start=16885
+  _TCONTAINERPROPERTYLISTRESPONSE_TCONTAINERPROPERTYLISTENTRY._serialized_end=16978
+  _TCONTAINERDATALISTREQUEST._serialized_start=16980
+  _TCONTAINERDATALISTREQUEST._serialized_end=17007
+  _TCONTAINERDATALISTRESPONSE._serialized_start=17010
+  _TCONTAINERDATALISTRESPONSE._serialized_end=17170
+  _TCONTAINERDATALISTRESPONSE_TCONTAINERDATALISTENTRY._serialized_start=17117
+  _TCONTAINERDATALISTRESPONSE_TCONTAINERDATALISTENTRY._serialized_end=17170
+  _TCONTAINERCREATEREQUEST._serialized_start=17172
+  _TCONTAINERCREATEREQUEST._serialized_end=17211
+  _TCONTAINERDESTROYREQUEST._serialized_start=17213
+  _TCONTAINERDESTROYREQUEST._serialized_end=17253
+  _TCONTAINERLISTREQUEST._serialized_start=17255
+  _TCONTAINERLISTREQUEST._serialized_end=17330
+  _TCONTAINERLISTRESPONSE._serialized_start=17332
+  _TCONTAINERLISTRESPONSE._serialized_end=17398
+  _TCONTAINERGETPROPERTYREQUEST._serialized_start=17400
+  _TCONTAINERGETPROPERTYREQUEST._serialized_end=17490
+  _TCONTAINERGETPROPERTYRESPONSE._serialized_start=17492
+  _TCONTAINERGETPROPERTYRESPONSE._serialized_end=17538
+  _TCONTAINERGETDATAREQUEST._serialized_start=17540
+  _TCONTAINERGETDATAREQUEST._serialized_end=17622
+  _TCONTAINERGETDATARESPONSE._serialized_start=17624
+  _TCONTAINERGETDATARESPONSE._serialized_end=17666
+  _TCONTAINERSETPROPERTYREQUEST._serialized_start=17668
+  _TCONTAINERSETPROPERTYREQUEST._serialized_end=17745
+  _TCONTAINERGETREQUEST._serialized_start=17748
+  _TCONTAINERGETREQUEST._serialized_end=17886
+  _TCONTAINERGETRESPONSE._serialized_start=17889
+  _TCONTAINERGETRESPONSE._serialized_end=18263
+  _TCONTAINERGETRESPONSE_TCONTAINERGETVALUERESPONSE._serialized_start=17988
+  _TCONTAINERGETRESPONSE_TCONTAINERGETVALUERESPONSE._serialized_end=18101
+  _TCONTAINERGETRESPONSE_TCONTAINERGETLISTRESPONSE._serialized_start=18104
+  _TCONTAINERGETRESPONSE_TCONTAINERGETLISTRESPONSE._serialized_end=18263
+  _TCONTAINERSTARTREQUEST._serialized_start=18265
+  _TCONTAINERSTARTREQUEST._serialized_end=18303
+  _TCONTAINERRESPAWNREQUEST._serialized_start=18305
+  _TCONTAINERRESPAWNREQUEST._serialized_end=18345
+  _TCONTAINERSTOPREQUEST._serialized_start=18347
+  _TCONTAINERSTOPREQUEST._serialized_end=18404
+  _TCONTAINERPAUSEREQUEST._serialized_start=18406
+  _TCONTAINERPAUSEREQUEST._serialized_end=18444
+  _TCONTAINERRESUMEREQUEST._serialized_start=18446
+  _TCONTAINERRESUMEREQUEST._serialized_end=18485
+  _TCONVERTPATHREQUEST._serialized_start=18487
+  _TCONVERTPATHREQUEST._serialized_end=18559
+  _TCONVERTPATHRESPONSE._serialized_start=18561
+  _TCONVERTPATHRESPONSE._serialized_end=18597
+  _TCONTAINERWAITREQUEST._serialized_start=18599
+  _TCONTAINERWAITREQUEST._serialized_end=18687
+  _TCONTAINERWAITRESPONSE._serialized_start=18689
+  _TCONTAINERWAITRESPONSE._serialized_end=18786
+  _TFOLLOWSTREAMREQUEST._serialized_start=18788
+  _TFOLLOWSTREAMREQUEST._serialized_end=18890
+  _TFOLLOWSTREAMRESPONSE._serialized_start=18892
+  _TFOLLOWSTREAMRESPONSE._serialized_end=18988
+  _TCONTAINERKILLREQUEST._serialized_start=18990
+  _TCONTAINERKILLREQUEST._serialized_end=19040
+  _TATTACHPROCESSREQUEST._serialized_start=19042
+  _TATTACHPROCESSREQUEST._serialized_end=19106
+  _TLOCATEPROCESSREQUEST._serialized_start=19108
+  _TLOCATEPROCESSREQUEST._serialized_end=19158
+  _TLOCATEPROCESSRESPONSE._serialized_start=19160
+  _TLOCATEPROCESSRESPONSE._serialized_end=19198
+  _TFINDLABELREQUEST._serialized_start=19200
+  _TFINDLABELREQUEST._serialized_end=19278
+  _TFINDLABELRESPONSE._serialized_start=19281
+  _TFINDLABELRESPONSE._serialized_end=19440
+  _TFINDLABELRESPONSE_TFINDLABELENTRY._serialized_start=19364
+  _TFINDLABELRESPONSE_TFINDLABELENTRY._serialized_end=19440
+  _TSETLABELREQUEST._serialized_start=19442
+  _TSETLABELREQUEST._serialized_end=19539
+  _TSETLABELRESPONSE._serialized_start=19541
+  _TSETLABELRESPONSE._serialized_end=19595
+  _TINCLABELREQUEST._serialized_start=19597
+  _TINCLABELREQUEST._serialized_end=19660
+  _TINCLABELRESPONSE._serialized_start=19662
+  _TINCLABELRESPONSE._serialized_end=19697
+  _TSETSYMLINKREQUEST._serialized_start=19699
+  _TSETSYMLINKREQUEST._serialized_end=19771
+  _TNEWVOLUMEREQUEST._serialized_start=19773
+  _TNEWVOLUMEREQUEST._serialized_end=19853
+  _TNEWVOLUMERESPONSE._serialized_start=19855
+  _TNEWVOLUMERESPONSE._serialized_end=19915
+  _TGETVOLUMEREQUEST._serialized_start=19917
+  _TGETVOLUMEREQUEST._serialized_end=20006
+  _TGETVOLUMERESPONSE._serialized_start=20008
+  _TGETVOLUMERESPONSE._serialized_end=20068
+  _TVOLUMEPROPERTYLISTREQUEST._serialized_start=20070
+  _TVOLUMEPROPERTYLISTREQUEST._serialized_end=20098
+  _TVOLUMEPROPERTYLISTRESPONSE._serialized_start=20101
+  _TVOLUMEPROPERTYLISTRESPONSE._serialized_end=20275
+  _TVOLUMEPROPERTYLISTRESPONSE_TVOLUMEPROPERTYDESCRIPTION._serialized_start=20219
+  _TVOLUMEPROPERTYLISTRESPONSE_TVOLUMEPROPERTYDESCRIPTION._serialized_end=20275
+  _TVOLUMECREATEREQUEST._serialized_start=20277
+  _TVOLUMECREATEREQUEST._serialized_end=20382
+  _TVOLUMELINKREQUEST._serialized_start=20384
+  _TVOLUMELINKREQUEST._serialized_end=20490
+  _TVOLUMEUNLINKREQUEST._serialized_start=20492
+  _TVOLUMEUNLINKREQUEST._serialized_end=20579
+  _TVOLUMELISTREQUEST._serialized_start=20581
+  _TVOLUMELISTREQUEST._serialized_end=20671
+  _TVOLUMELISTRESPONSE._serialized_start=20673
+  _TVOLUMELISTRESPONSE._serialized_end=20742
+  _TVOLUMETUNEREQUEST._serialized_start=20744
+  _TVOLUMETUNEREQUEST._serialized_end=20826
+  _TLAYERLISTREQUEST._serialized_start=20828
+  _TLAYERLISTREQUEST._serialized_end=20876
+  _TLAYERLISTRESPONSE._serialized_start=20879
+  _TLAYERLISTRESPONSE._serialized_end=21054
+  _TLAYERIMPORTPROGRESS._serialized_start=21057
+  _TLAYERIMPORTPROGRESS._serialized_end=21187
+  _TLAYERIMPORTREQUEST._serialized_start=21189
+  _TLAYERIMPORTREQUEST._serialized_end=21313
+  _TLAYEREXPORTREQUEST._serialized_start=21315
+  _TLAYEREXPORTREQUEST._serialized_end=21417
+  _TLAYERREMOVEREQUEST._serialized_start=21419
+  _TLAYERREMOVEREQUEST._serialized_end=21470
+  _TLAYERGETPRIVATEREQUEST._serialized_start=21472
+  _TLAYERGETPRIVATEREQUEST._serialized_end=21527
+  _TLAYERGETPRIVATERESPONSE._serialized_start=21529
+  _TLAYERGETPRIVATERESPONSE._serialized_end=21578
+  _TLAYERSETPRIVATEREQUEST._serialized_start=21580
+  _TLAYERSETPRIVATEREQUEST._serialized_end=21658
+  _TSTORAGELISTREQUEST._serialized_start=21660
+  _TSTORAGELISTREQUEST._serialized_end=21710
+  _TSTORAGELISTRESPONSE._serialized_start=21712
+  _TSTORAGELISTRESPONSE._serialized_end=21832
+  _TSTORAGEREMOVEREQUEST._serialized_start=21834
+  _TSTORAGEREMOVEREQUEST._serialized_end=21886
+  _TSTORAGEIMPORTREQUEST._serialized_start=21888
+  _TSTORAGEIMPORTREQUEST._serialized_end=21998
+  _TSTORAGEEXPORTREQUEST._serialized_start=22000
+  _TSTORAGEEXPORTREQUEST._serialized_end=22087
+# @@protoc_insertion_point(module_scope)
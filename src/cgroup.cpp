@@ -136,6 +136,8 @@ bool TCgroup::Has(const TString &knob) const {
 TError TCgroup::Get(const TString &knob, TString &value) const {
     if (!Subsystem)
         return TError("Cannot get from null cgroup");
+    if (TCgroupCollector::Current)
+        return TCgroupCollector::Current->Read(Knob(knob), value);
     return Knob(knob).ReadAll(value);
 }
 
@@ -186,25 +188,108 @@ TError TCgroup::SetBool(const TString &knob, bool value) const {
 }
 
 TError TCgroup::GetUintMap(const TString &knob, TUintMap &value) const {
-    if (!Subsystem)
-        return TError("Cannot get from null cgroup");
+    std::vector<TString> lines;
+    TError error = GetLines(knob, lines);
+    if (error)
+        return error;
+
+    for (auto &line: lines) {
+        auto sep = line.find(' ');
+        uint64_t val;
 
-    FILE *file = fopen(Knob(knob).c_str(), "r");
-    char *key;
-    unsigned long long val;
+        if (sep != TString::npos && !StringToUint64(line.substr(sep + 1), val))
+            value[line.substr(0, sep)] = val;
+    }
 
-    if (!file)
-        return TError::System("Cannot open knob " + knob);
+    return OK;
+}
+
+/* Appends lines of knob */
+TError TCgroup::GetLines(const TString &knob, std::vector<TString> &lines) const {
+    TString text;
+    TError error = Get(knob, text);
+    if (error)
+        return error;
 
-    while (fscanf(file, "%ms %llu\n", &key, &val) == 2) {
-        value[TString(key)] = val;
-        free(key);
+    for (TString::size_type pos = 0, end; pos < text.size(); pos = end + 1) {
+        end = text.find('\n', pos);
+        if (end == TString::npos)
+            end = text.size();
+        lines.push_back(text.substr(pos, end - pos));
     }
 
-    fclose(file);
     return OK;
 }
 
+TError TKnobCache::Read(const TPath &path, TString &value) {
+    std::unique_lock<std::mutex> lock(Mutex);
+    std::shared_ptr<TFile> file;
+    TError error;
+
+    if (!Dirs.count(path.DirName().ToString())) {
+        lock.unlock();
+        return path.ReadAll(value, 1 << 20);
+    }
+
+    auto it = Files.find(path.ToString());
+    if (it != Files.end()) {
+        file = it->second;
+        lock.unlock();
+
+        error = file->PreadAll(value, 1 << 20);
+        if (!error)
+            return OK;
+
+        /* Cgroup might be recreated, reopen */
+        lock.lock();
+        Files.erase(path.ToString());
+    }
+
+    file = std::make_shared<TFile>();
+    error = file->OpenRead(path);
+    if (!error)
+        error = file->PreadAll(value, 1 << 20);
+    if (error)
+        return TError(error, "Cannot read {}", path);
+
+    /* Do not keep too much fds for one container */
+    if (Files.size() < CGROUP_KNOB_CACHE_MAX)
+        Files[path.ToString()] = file;
+
+    return OK;
+}
+
+bool TKnobCache::HasDirs() {
+    std::unique_lock<std::mutex> lock(Mutex);
+    return !Dirs.empty();
+}
+
+void TKnobCache::SetDirs(const std::unordered_set<TString> &dirs) {
+    std::unique_lock<std::mutex> lock(Mutex);
+    Dirs = dirs;
+}
+
+void TKnobCache::Clear() {
+    std::unique_lock<std::mutex> lock(Mutex);
+    Files.clear();
+    Dirs.clear();
+}
+
+__thread TCgroupCollector *TCgroupCollector::Current = nullptr;
+
+TError TCgroupCollector::Read(const TPath &path, TString &value) {
+    auto it = Values.find(path.ToString());
+    if (it != Values.end()) {
+        value = it->second;
+        return OK;
+    }
+
+    TError error = Cache.Read(path, value);
+    if (!error)
+        Values[path.ToString()] = value;
+    return error;
+}
+
 TError TCgroup::Attach(pid_t pid, bool thread) const {
     if (Secondary())
         return TError("Cannot attach to secondary cgroup " + Type());
@@ -973,7 +1058,7 @@ TError TBlkioSubsystem::GetIoStat(TCgroup &cg, enum IoStat stat, TUintMap &map)
     } else
         knob = (stat & IoStat::Iops) ? "blkio.io_serviced_recursive" : "blkio.io_service_bytes_recursive";
 
-    error = cg.Knob(knob).ReadLines(lines);
+    error = cg.GetLines(knob, lines);
     if (error)
         return error;
 
@@ -987,7 +1072,7 @@ TError TBlkioSubsystem::GetIoStat(TCgroup &cg, enum IoStat stat, TUintMap &map)
         }
 
         for (auto &child_cg: list) {
-            error = child_cg.Knob(knob).ReadLines(lines);
+            error = child_cg.GetLines(knob, lines);
             if (error && error.Errno != ENOENT) {
                 L_WRN("Cannot get io stat {}", error);
                 return error;
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <string>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "common.hpp"
 #include "config.hpp"
@@ -133,9 +137,54 @@ public:
     TError SetBool(const TString &knob, bool value) const;
 
     TError GetUintMap(const TString &knob, TUintMap &value) const;
+    TError GetLines(const TString &knob, std::vector<TString> &lines) const;
     TError SetSuffix(const TString suffix);
 };
 
+constexpr size_t CGROUP_KNOB_CACHE_MAX = 16;
+
+/*
+ * Open knob fds of one container, kept between requests.
+ * Knobs are read by pread at offset 0 without path lookup and open.
+ * Only knobs of container's own cgroups are kept, others are read
+ * directly: they could be removed while this container lives.
+ */
+class TKnobCache : public TPortoNonCopyable {
+    std::mutex Mutex;
+    std::unordered_map<TString, std::shared_ptr<TFile>> Files;
+    std::unordered_set<TString> Dirs;
+
+public:
+    TError Read(const TPath &path, TString &value);
+    bool HasDirs();
+    void SetDirs(const std::unordered_set<TString> &dirs);
+    void Clear();
+};
+
+/*
+ * Collects statistics of one container: while it is active in current
+ * thread each knob is read at most once and value is shared between
+ * properties, knob fds are cached in container's TKnobCache.
+ */
+class TCgroupCollector : public TPortoNonCopyable {
+    TKnobCache &Cache;
+    TCgroupCollector *Prev;
+    std::unordered_map<TString, TString> Values;
+
+public:
+    static __thread TCgroupCollector *Current;
+
+    TCgroupCollector(TKnobCache &cache) : Cache(cache), Prev(Current) {
+        Current = this;
+    }
+
+    ~TCgroupCollector() {
+        Current = Prev;
+    }
+
+    TError Read(const TPath &path, TString &value);
+};
+
 class TMemorySubsystem : public TSubsystem {
 public:
     const TString STAT = "memory.stat";
@@ -0,0 +1,63 @@
+#include "changelog.hpp"
+#include "config.hpp"
+#include "util/log.hpp"
+#include "util/unix.hpp"
+
+TChangeLog ChangeLog;
+
+void TChangeLog::Init() {
+    std::lock_guard<std::mutex> lock(Mutex);
+    Generation = ForgottenGen = GetCurrentTimeMs() * 1000;
+    Log.clear();
+    Index.clear();
+    Removed.clear();
+}
+
+uint64_t TChangeLog::Stamp(EChangeKind kind, const TString &name, bool removed) {
+    std::lock_guard<std::mutex> lock(Mutex);
+    uint64_t gen = ++Generation;
+
+    auto key = std::make_pair(kind, name);
+    auto it = Index.find(key);
+    if (it != Index.end()) {
+        Log.erase(it->second);
+        Removed.erase(it->second);
+        it->second = gen;
+    } else
+        Index.emplace(key, gen);
+
+    Log[gen] = { kind, name, removed };
+
+    if (removed) {
+        Removed.insert(gen);
+        while (Removed.size() > config().daemon().change_log_removed()) {
+            uint64_t old = *Removed.begin();
+            auto &rec = Log[old];
+            Index.erase(std::make_pair(rec.Kind, rec.Name));
+            Log.erase(old);
+            Removed.erase(Removed.begin());
+            ForgottenGen = std::max(ForgottenGen, old);
+        }
+    }
+
+    Statistics->ChangeLogSize = Log.size();
+
+    return gen;
+}
+
+bool TChangeLog::Collect(uint64_t since, uint64_t &generation,
+                         const std::function<void(EChangeKind kind, const TString &name,
+                                                  uint64_t gen, bool removed)> &fn) {
+    std::lock_guard<std::mutex> lock(Mutex);
+
+    bool full = since < ForgottenGen || since > Generation;
+
+    generation = Generation;
+
+    for (auto it = full ? Log.begin() : Log.upper_bound(since); it != Log.end(); ++it) {
+        if (!full || !it->second.Removed)
+            fn(it->second.Kind, it->second.Name, it->first, it->second.Removed);
+    }
+
+    return !full;
+}
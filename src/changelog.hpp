@@ -0,0 +1,61 @@
+#pragma once
+
+#include <mutex>
+#include <map>
+#include <set>
+#include <functional>
+
+#include "common.hpp"
+
+/*
+ * Per-daemon change feed: every mutation of container or volume stamps
+ * object with next generation. Log keeps only the latest generation of
+ * each live object plus limited number of removals, so readers could
+ * fetch changes since known generation in O(changes).
+ *
+ * Generations start from daemon start time in microseconds, thus they
+ * are monotonic across restarts and older generation forces full resync.
+ */
+
+enum class EChangeKind {
+    Container,
+    Volume,
+};
+
+class TChangeLog : public TPortoNonCopyable {
+    struct TRecord {
+        EChangeKind Kind;
+        TString Name;
+        bool Removed;
+    };
+
+    std::mutex Mutex;
+    uint64_t Generation = 0;
+    uint64_t ForgottenGen = 0;          /* changes before are lost */
+    std::map<uint64_t, TRecord> Log;
+    std::map<std::pair<EChangeKind, TString>, uint64_t> Index;
+    std::set<uint64_t> Removed;
+
+    uint64_t Stamp(EChangeKind kind, const TString &name, bool removed);
+
+public:
+    void Init();
+
+    uint64_t Touch(EChangeKind kind, const TString &name) {
+        return Stamp(kind, name, false);
+    }
+
+    uint64_t Remove(EChangeKind kind, const TString &name) {
+        return Stamp(kind, name, true);
+    }
+
+    /*
+     * Returns false if changes since this generation are lost,
+     * then reports all live objects.
+     */
+    bool Collect(uint64_t since, uint64_t &generation,
+                 const std::function<void(EChangeKind kind, const TString &name,
+                                          uint64_t gen, bool removed)> &fn);
+};
+
+extern TChangeLog ChangeLog;
@@ -30,6 +30,7 @@ __thread TClient *CL = nullptr;
 TClient::TClient(int fd) : TEpollSource(fd) {
     ConnectionTime = GetCurrentTimeMs();
     ActivityTimeMs = ConnectionTime;
+    EpollEvents = EPOLLIN;
     if (fd >= 0)
         Statistics->ClientsCount++;
 }
@@ -45,12 +46,27 @@ TClient::~TClient() {
     CloseConnection();
 }
 
+std::shared_ptr<TClient> TClient::Clone() const {
+    auto client = std::make_shared<TClient>(-1);
+    client->Id = Id;
+    client->Cred = Cred;
+    client->TaskCred = TaskCred;
+    client->Pid = Pid;
+    client->Comm = Comm;
+    client->UserCtGroup = UserCtGroup;
+    client->ClientContainer = ClientContainer;
+    client->AccessLevel = AccessLevel;
+    client->PortoNamespace = PortoNamespace;
+    client->WriteNamespace = WriteNamespace;
+    return client;
+}
+
 void TClient::CloseConnection() {
     auto lock = Lock();
 
     if (Fd >= 0) {
-        if (InEpoll)
-            EpollLoop->RemoveSource(Fd);
+        if (Loop)
+            Loop->RemoveSource(Fd);
         ConnectionTime = GetCurrentTimeMs() - ConnectionTime;
         L_VERBOSE("Disconnected {} time={} ms", Id, ConnectionTime);
         close(Fd);
@@ -69,6 +85,9 @@ void TClient::CloseConnection() {
         }
     }
     WeakContainers.clear();
+
+    /* Break reference loop request -> client */
+    PendingRequests.clear();
 }
 
 void TClient::StartRequest() {
@@ -77,8 +96,9 @@ void TClient::StartRequest() {
     CL = this;
 }
 
-void TClient::FinishRequest() {
-    ReleaseContainer();
+void TClient::FinishRequest(bool release) {
+    if (release)
+        ReleaseContainer();
     PORTO_ASSERT(CL == this);
     CL = nullptr;
 }
@@ -234,8 +254,17 @@ TError TClient::ControlVolume(const TPath &path, std::shared_ptr<TVolume> &volum
     if (AccessLevel <= EAccessLevel::ReadOnly)
         return TError(EError::Permission, "Write access to porto denied");
     auto link = TVolume::ResolveLink(ClientContainer->RootPath / path);
-    if (!link)
-        return TError(EError::VolumeNotFound, "Volume {} not found", path);
+    if (!link) {
+        /* Volume in asynchronous build is not mounted yet */
+        volume = TVolume::FindBuilding(ClientContainer->RootPath / path);
+        if (!volume)
+            return TError(EError::VolumeNotFound, "Volume {} not found", path);
+        if (CanControl(volume->VolumeOwner)) {
+            volume = nullptr;
+            return TError(EError::Permission, "Cannot control volume {}", path);
+        }
+        return OK;
+    }
     if (CanControl(link->Volume->VolumeOwner))
         return TError(EError::Permission, "Cannot control volume {}", path);
     if (!read_only && link->ReadOnly)
@@ -246,13 +275,14 @@ TError TClient::ControlVolume(const TPath &path, std::shared_ptr<TVolume> &volum
 
 TError TClient::ReadContainer(const TString &relative_name,
                               std::shared_ptr<TContainer> &ct) {
-    auto lock = LockContainers();
+    /* Lookup does not need ContainersMutex */
     TError error = ResolveContainer(relative_name, ct);
     if (error)
         return error;
-    if (LockedContainer) {
+    /* In pipelined mode concurrent read-write request might hold lock */
+    if (LockedContainer && !Pipelined) {
         L_WRN("Stale locked container CT{}:{}", LockedContainer->Id, LockedContainer->Name);
-        ReleaseContainer(true);
+        ReleaseContainer();
     }
     return OK;
 }
@@ -419,16 +449,26 @@ TError TClient::WriteAccess(const TFile &file) {
     return error;
 }
 
-TError TClient::ReadRequest(rpc::TPortoRequest &request) {
+TError TClient::RecvRequests() {
     if (Fd < 0)
         return TError("Connection closed");
 
-    if (Offset >= Buffer.size())
-        Buffer.resize(Offset + 4096);
+    /* Move incomplete request to the beginning */
+    if (Offset) {
+        if (Offset < Length)
+            memmove(&Buffer[0], &Buffer[Offset], Length - Offset);
+        Length -= Offset;
+        Offset = 0;
+    }
 
-    ssize_t len = recv(Fd, &Buffer[Offset], Length ? (Length - Offset) : 1, MSG_DONTWAIT);
+    if (Buffer.size() < Length + 4096)
+        Buffer.resize(Length + 4096);
+
+    /* Read everything available, might be several requests */
+    ssize_t len = recv(Fd, &Buffer[Length], Buffer.size() - Length, MSG_DONTWAIT);
+    Statistics->ClientRecvCalls++;
     if (len > 0)
-        Offset += len;
+        Length += len;
     else if (len == 0)
         return TError("recv return zero");
     else if (errno != EAGAIN && errno != EWOULDBLOCK)
@@ -436,38 +476,97 @@ TError TClient::ReadRequest(rpc::TPortoRequest &request) {
 
     ActivityTimeMs = GetCurrentTimeMs();
 
-    if (Length && Offset < Length)
+    return OK;
+}
+
+TError TClient::ReadRequest(rpc::TPortoRequest &request) {
+    if (Offset >= Length)
         return TError::Queued();
 
-    Receiving = true;
-    google::protobuf::io::CodedInputStream input(&Buffer[0], Offset);
+    google::protobuf::io::CodedInputStream input(&Buffer[Offset], Length - Offset);
 
     uint32_t length;
-    if (!input.ReadVarint32(&length))
+    if (!input.ReadVarint32(&length)) {
+        if (Length - Offset >= google::protobuf::io::CodedOutputStream::VarintSize32(UINT32_MAX))
+            return TError("invalid request length");
         return TError::Queued();
+    }
 
-    if (!Length) {
-        if (length > config().daemon().max_msg_len())
-            return TError("oversized request: {}", length);
-
-        Length = length + google::protobuf::io::CodedOutputStream::VarintSize32(length);
-        if (Buffer.size() < Length)
-            Buffer.resize(Length + 4096);
+    if (length > config().daemon().max_msg_len())
+        return TError("oversized request: {}", length);
 
-        if (Offset < Length)
-            return TError::Queued();
+    uint64_t size = length + google::protobuf::io::CodedOutputStream::VarintSize32(length);
+    if (Offset + size > Length) {
+        if (Buffer.size() < Offset + size)
+            Buffer.resize(Offset + size);
+        return TError::Queued();
     }
 
-    if (!request.ParseFromCodedStream(&input))
+    /* Parse right from receive buffer */
+    if (!request.ParseFromArray(&Buffer[Offset + size - length], length))
         return TError("cannot parse request");
 
-    if (Offset > Length)
-        return TError("garbage after request");
+    Offset += size;
+    if (Offset == Length)
+        Offset = Length = 0;
+
+    return OK;
+}
+
+TError TClient::ProcessRequests() {
+    TError error;
+
+    while (CanReceive() && Offset < Length) {
+        if (!Request)
+            Request = std::unique_ptr<TRequest>(new TRequest());
+
+        error = ReadRequest(Request->Req);
+        if (error)
+            break;
+
+        /* Do not change identity under requests in flight */
+        if (!Processing) {
+            error = IdentifyClient(false);
+            if (error)
+                break;
+        }
+
+        QueueRequest();
+    }
+
+    if (error == EError::Queued)
+        error = OK;
+
+    if (error) {
+        /* Might be called not from event loop, let it close connection */
+        if (Fd >= 0 && shutdown(Fd, SHUT_RDWR))
+            L_ERR("Cannot shutdown client: {}", TError::System("shutdown"));
+        return error;
+    }
+
+    return UpdateEvents();
+}
+
+bool TClient::CanReceive() const {
+    if (Pipelined)
+        return Processing < config().daemon().max_client_requests();
+    return !Processing && !Sending;
+}
+
+TError TClient::UpdateEvents() {
+    uint32_t events = 0;
+
+    if (CanReceive())
+        events |= EPOLLIN;
 
-    Length = Offset = 0;
-    Receiving = false;
+    if (Sending)
+        events |= EPOLLOUT;
 
-    return EpollLoop->StopInput(Fd);
+    if (Fd < 0 || !Loop || events == EpollEvents)
+        return OK;
+
+    EpollEvents = events;
+    return Loop->ModifySourceEvents(Fd, events);
 }
 
 TError TClient::SendResponse(bool first) {
@@ -475,10 +574,10 @@ TError TClient::SendResponse(bool first) {
     if (Fd < 0)
         return OK; /* Connection closed */
 
-next:
-    ssize_t len = send(Fd, &Buffer[Offset], Length - Offset, MSG_DONTWAIT);
+    ssize_t len = send(Fd, &SendBuffer[SendOffset], SendLength - SendOffset, MSG_DONTWAIT);
+    Statistics->ClientSendCalls++;
     if (len > 0)
-        Offset += len;
+        SendOffset += len;
     else if (len == 0) {
         if (!first)
             return TError("send return zero");
@@ -490,60 +589,48 @@ next:
 
     ActivityTimeMs = GetCurrentTimeMs();
 
-    if (Offset >= Length) {
-        if (ShutdownPortod && shutdown(Fd, SHUT_RDWR))
+    if (SendOffset >= SendLength) {
+        if (ShutdownPortod && !Processing && shutdown(Fd, SHUT_RDWR))
             L_ERR("Cannot shutdown client: {}", TError::System("shutdown"));
 
-        Length = Offset = 0;
-
-        if (!ReportQueue.empty()) {
-            QueueReport(ReportQueue.front(), true);
-            ReportQueue.pop_front();
-            goto next;
-        }
-
+        SendLength = SendOffset = 0;
         Sending = false;
 
-        /* Out of order message */
-        if (Processing)
-            return OK;
-
-        return EpollLoop->StartInput(Fd);
+        /* Handle requests which are already received */
+        return ProcessRequests();
     }
 
     if (first) {
         Sending = true;
-        return EpollLoop->StartOutput(Fd);
+        return UpdateEvents();
     }
 
     return TError::Queued();
 }
 
 TError TClient::QueueResponse(rpc::TPortoResponse &response) {
-
-    if (Receiving)
-        return TError(EError::Busy, "QueueResponse while Receiving");
-
     uint32_t length = response.ByteSize();
     size_t lengthSize = google::protobuf::io::CodedOutputStream::VarintSize32(length);
 
-    size_t tail = Length;
-    Length += lengthSize + length;
+    size_t tail = SendLength;
+    SendLength += lengthSize + length;
 
-    if (Buffer.size() < Length)
-        Buffer.resize(Length);
+    if (SendBuffer.size() < SendLength)
+        SendBuffer.resize(SendLength);
 
-    google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(length, &Buffer[tail]);
-    if (!response.SerializeToArray(&Buffer[tail + lengthSize], length))
+    google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(length, &SendBuffer[tail]);
+    if (!response.SerializeToArray(&SendBuffer[tail + lengthSize], length))
         return TError("cannot serialize response");
 
     return OK;
 }
 
-TError TClient::QueueReport(const TContainerReport &report, bool async) {
+TError TClient::QueueReport(const TContainerReport &report, bool async, uint64_t tag) {
     rpc::TPortoResponse rsp;
 
     rsp.set_error(EError::Success);
+    if (tag)
+        rsp.set_tag(tag);
     auto wait = async ? rsp.mutable_asyncwait() : rsp.mutable_wait();
     wait->set_name(report.Name);
     wait->set_state(report.State);
@@ -563,25 +650,43 @@ TError TClient::QueueReport(const TContainerReport &report, bool async) {
 }
 
 TError TClient::MakeReport(const TString &name, const TString &state, bool async,
-                           const TString &label, const TString &value) {
+                           const TString &label, const TString &value, uint64_t tag) {
     auto lock = Lock();
     TError error;
 
-    if (async) {
-        if (Sending || Receiving) {
-            ReportQueue.emplace_back(name, state, time(nullptr), label, value);
-            return OK;
-        }
-    } else
-        Processing = false;
+    /* Sync wait completes request */
+    if (!async)
+        Processing--;
 
-    error = QueueReport({name, state, time(nullptr), label, value}, async);
+    error = QueueReport({name, state, time(nullptr), label, value}, async, tag);
     if (error)
         return error;
 
+    if (Sending)
+        return UpdateEvents();
+
+    return SendResponse(true);
+}
+
+TError TClient::PushResponse(rpc::TPortoResponse &response) {
+    auto lock = Lock();
+    TError error;
+
+    error = QueueResponse(response);
+    if (error)
+        return error;
+
+    if (Sending)
+        return UpdateEvents();
+
     return SendResponse(true);
 }
 
+uint64_t TClient::SendPending() {
+    auto lock = Lock();
+    return SendLength - SendOffset;
+}
+
 TError TClient::Event(uint32_t events) {
     auto lock = Lock();
     TError error;
@@ -592,24 +697,11 @@ TError TClient::Event(uint32_t events) {
             return error;
     }
 
-    if ((!Processing && !Sending) && (events & EPOLLIN)) {
-        if (!Request)
-            Request = std::unique_ptr<TRequest>(new TRequest());
-
-        error = ReadRequest(Request->Req);
-        if (!error) {
-            error = IdentifyClient(false);
-            if (!error)
-                QueueRequest();
-
-            if (!error && !ReportQueue.empty()) {
-                QueueReport(ReportQueue.front(), true);
-                ReportQueue.pop_front();
-                error = SendResponse(true);
-            }
-        }
-
-        if (error && error != EError::Queued)
+    if (CanReceive() && (events & EPOLLIN)) {
+        error = RecvRequests();
+        if (!error)
+            error = ProcessRequests();
+        if (error)
             return error;
     }
 
@@ -623,9 +715,37 @@ void TClient::QueueRequest() {
     Request->Client = shared_from_this();
 
     ClientContainer->ContainerRequests++;
-    Processing = true;
+    Processing++;
     WaitRequest = Request->Req.has_wait() || Request->Req.has_asyncwait();
 
+    if (Request->Req.has_tag())
+        Pipelined = true;
+
+    /* Pipelined read-write requests are serialized: client has one locked container */
+    if (Pipelined) {
+        Request->Classify();
+        if (!Request->RoReq) {
+            if (WriteRequest) {
+                PendingRequests.push_back(std::move(Request));
+                return;
+            }
+            WriteRequest = true;
+        }
+    }
+
     QueueRpcRequest(Request);
     Request = nullptr;
 }
+
+void TClient::CompleteRequest(bool write) {
+    Processing--;
+
+    if (write && WriteRequest) {
+        WriteRequest = false;
+        if (!PendingRequests.empty()) {
+            WriteRequest = true;
+            QueueRpcRequest(PendingRequests.front());
+            PendingRequests.pop_front();
+        }
+    }
+}
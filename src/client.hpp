@@ -29,16 +29,22 @@ public:
     std::shared_ptr<TContainer> ClientContainer;
     std::shared_ptr<TContainer> LockedContainer;
     uint64_t ActivityTimeMs = 0;
-    bool Processing = false;
+    uint32_t Processing = 0;    /* requests in flight */
     bool Sending = false;
-    bool Receiving = false;
     bool WaitRequest = false;
-    bool InEpoll = false;
+    TEpollLoop *Loop = nullptr;     /* serves this connection */
+
+    /* Pipelined mode: tagged requests are handled concurrently */
+    bool Pipelined = false;
+    bool WriteRequest = false;  /* read-write request in flight */
 
     TClient(int fd);
     TClient(const TString &special);
     ~TClient();
 
+    /* Same identity without connection, for background jobs */
+    std::shared_ptr<TClient> Clone() const;
+
     std::unique_lock<std::mutex> Lock() {
         return std::unique_lock<std::mutex>(Mutex);
     }
@@ -54,7 +60,7 @@ public:
     }
 
     bool IsBlockShutdown() const {
-        return (Processing && !WaitRequest) || Offset;
+        return (Processing && !WaitRequest) || Length || SendOffset;
     }
 
     bool CanSetUidGid() const;
@@ -67,7 +73,7 @@ public:
     void CloseConnection();
 
     void StartRequest();
-    void FinishRequest();
+    void FinishRequest(bool release = true);
 
     TError IdentifyClient(bool initial);
     TString RelativeName(const TString &name) const;
@@ -93,16 +99,24 @@ public:
 
     std::shared_ptr<TContainerWaiter> SyncWaiter;
     std::shared_ptr<TContainerWaiter> AsyncWaiter;
-    std::list<TContainerReport> ReportQueue;
 
     TError Event(uint32_t events);
+    TError RecvRequests();
     TError ReadRequest(rpc::TPortoRequest &request);
+    TError ProcessRequests();
     void QueueRequest();
+    void CompleteRequest(bool write);
     TError SendResponse(bool first);
+    TError UpdateEvents();
     TError QueueResponse(rpc::TPortoResponse &response);
-    TError QueueReport(const TContainerReport &report, bool async);
+    TError QueueReport(const TContainerReport &report, bool async, uint64_t tag);
     TError MakeReport(const TString &name, const TString &state, bool async,
-                      const TString &label = "", const TString &value = "");
+                      const TString &label = "", const TString &value = "",
+                      uint64_t tag = 0);
+
+    /* Response not bound to request, for streaming */
+    TError PushResponse(rpc::TPortoResponse &response);
+    uint64_t SendPending();
 
     std::list<std::weak_ptr<TContainer>> WeakContainers;
 
@@ -110,10 +124,20 @@ private:
     std::mutex Mutex;
     uint64_t ConnectionTime = 0;
 
+    /* Received data: Buffer[Offset..Length) is not parsed yet */
     uint64_t Length = 0;
     uint64_t Offset = 0;
     std::vector<uint8_t> Buffer;
     std::unique_ptr<TRequest> Request;
+
+    uint64_t SendLength = 0;
+    uint64_t SendOffset = 0;
+    std::vector<uint8_t> SendBuffer;
+
+    uint32_t EpollEvents = 0;
+    std::list<std::unique_ptr<TRequest>> PendingRequests;
+
+    bool CanReceive() const;
 };
 
 extern TClient SystemClient;
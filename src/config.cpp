@@ -52,10 +52,20 @@ static void DefaultConfig() {
 
     config().set_keyvalue_limit(1 << 20);
     config().set_keyvalue_size(32 << 20);
+    config().set_keyvalue_journal(true);
 
     config().mutable_daemon()->set_rw_threads(20);
     config().mutable_daemon()->set_ro_threads(10);
     config().mutable_daemon()->set_io_threads(5);
+    config().mutable_daemon()->set_max_client_requests(32);
+    config().mutable_daemon()->set_io_loops(2);
+    config().mutable_daemon()->set_sampler_interval_ms(5000);
+    config().mutable_daemon()->set_sampler_history(120);
+    config().mutable_daemon()->set_change_log_removed(65536);
+    config().mutable_daemon()->set_restore_threads(8);
+    config().mutable_daemon()->set_follow_interval_ms(200);
+    config().mutable_daemon()->set_event_threads(4);
+    config().mutable_daemon()->set_max_follow_per_client(16);
 
     config().mutable_daemon()->set_max_clients(1000);
     config().mutable_daemon()->set_max_clients_in_container(500);
@@ -127,6 +137,7 @@ static void DefaultConfig() {
     config().mutable_volumes()->set_max_total(3000);
     config().mutable_volumes()->set_place_load_limit("default: 2; /ssd: 4");
     config().mutable_volumes()->set_squashfs_compression("gzip");
+    config().mutable_volumes()->set_loop_pool_classes("1G; 4G; 16G");
 
     config().mutable_network()->set_device_qdisc("default: hfsc");
 
@@ -4,7 +4,9 @@
 #include <csignal>
 #include <cstdlib>
 #include <algorithm>
+#include <set>
 #include <condition_variable>
+#include <unordered_map>
 
 #include "portod.hpp"
 #include "container.hpp"
@@ -27,6 +29,7 @@
 #include "client.hpp"
 #include "filesystem.hpp"
 #include "rpc.hpp"
+#include "changelog.hpp"
 
 extern "C" {
 #include <sys/sysinfo.h>
@@ -43,9 +46,27 @@ extern "C" {
 }
 
 std::mutex ContainersMutex;
-static std::condition_variable ContainersCV;
 std::shared_ptr<TContainer> RootContainer;
 std::map<TString, std::shared_ptr<TContainer>> Containers;
+
+/*
+ * Locks of different first-level subtrees never block each other,
+ * so waiters sleep at condvar of own subtree. Index 0 is for root.
+ */
+#define NR_CONTAINERS_CV 64
+static std::condition_variable ContainersCV[NR_CONTAINERS_CV];
+
+/*
+ * Name index for lookups without ContainersMutex: sharded copy-on-write
+ * hash maps, updated under ContainersMutex, published atomically.
+ */
+#define NR_CONTAINERS_INDEX 64
+typedef std::unordered_map<TString, std::shared_ptr<TContainer>> TContainersIndex;
+static std::shared_ptr<const TContainersIndex> ContainersIndex[NR_CONTAINERS_INDEX];
+
+static std::shared_ptr<const TContainersIndex> &ContainersIndexShard(const TString &name) {
+    return ContainersIndex[std::hash<TString>()(name) % NR_CONTAINERS_INDEX];
+}
 TPath ContainersKV;
 TIdMap ContainerIdMap(1, CONTAINER_ID_MAX);
 
@@ -116,9 +137,11 @@ TString TContainer::ParentName(const TString &name) {
 }
 
 std::shared_ptr<TContainer> TContainer::Find(const TString &name) {
-    PORTO_LOCKED(ContainersMutex);
-    auto it = Containers.find(name);
-    if (it == Containers.end())
+    auto index = std::atomic_load(&ContainersIndexShard(name));
+    if (!index)
+        return nullptr;
+    auto it = index->find(name);
+    if (it == index->end())
         return nullptr;
     return it->second;
 }
@@ -145,14 +168,33 @@ TError TContainer::FindTaskContainer(pid_t pid, std::shared_ptr<TContainer> &ct)
     TString name = cg.Name;
     std::replace(name.begin(), name.end(), '%', '/');
 
-    auto containers_lock = LockContainers();
-
     if (!StringStartsWith(name, prefix))
         return TContainer::Find(ROOT_CONTAINER, ct);
 
     return TContainer::Find(name.substr(prefix.length()), ct);
 }
 
+std::condition_variable &TContainer::LocksCV() {
+    auto ct = this;
+    if (IsRoot())
+        return ContainersCV[0];
+    while (ct->Level > 1)
+        ct = ct->Parent.get();
+    return ContainersCV[1 + ct->Id % (NR_CONTAINERS_CV - 1)];
+}
+
+void TContainer::NotifyLocks() {
+    PORTO_LOCKED(ContainersMutex);
+    if (IsRoot()) {
+        for (auto &cv: ContainersCV)
+            cv.notify_all();
+    } else {
+        LocksCV().notify_all();
+        /* root waits for whole tree */
+        ContainersCV[0].notify_all();
+    }
+}
+
 /* lock subtree shared or exclusive */
 TError TContainer::LockAction(std::unique_lock<std::mutex> &containers_lock, bool shared) {
     L_DBG("LockAction{} CT{}:{}", (shared ? "Shared" : ""), Id, Name);
@@ -173,7 +215,7 @@ TError TContainer::LockAction(std::unique_lock<std::mutex> &containers_lock, boo
             break;
         if (!shared)
             PendingWrite = true;
-        ContainersCV.wait(containers_lock);
+        LocksCV().wait(containers_lock);
     }
     PendingWrite = false;
     ActionLocked += shared ? 1 : -1;
@@ -202,8 +244,7 @@ void TContainer::UnlockAction(bool containers_locked) {
     }
     PORTO_ASSERT(ActionLocked);
     ActionLocked += (ActionLocked > 0) ? -1 : 1;
-    /* not so effective and fair but simple */
-    ContainersCV.notify_all();
+    NotifyLocks();
     if (!containers_locked)
         ContainersMutex.unlock();
 }
@@ -227,7 +268,7 @@ void TContainer::DowngradeActionLock() {
     }
 
     ActionLocked = 1;
-    ContainersCV.notify_all();
+    NotifyLocks();
 }
 
 /* only after downgrade */
@@ -244,7 +285,7 @@ void TContainer::UpgradeActionLock() {
     }
 
     while (ActionLocked != 1)
-        ContainersCV.wait(lock);
+        LocksCV().wait(lock);
 
     ActionLocked = -1;
     LastActionPid = GetTid();
@@ -256,7 +297,7 @@ void TContainer::LockStateRead() {
     auto lock = LockContainers();
     L_DBG("LockStateRead CT{}:{}", Id, Name);
     while (StateLocked < 0)
-        ContainersCV.wait(lock);
+        LocksCV().wait(lock);
     StateLocked++;
     LastStatePid = GetTid();
 }
@@ -265,10 +306,10 @@ void TContainer::LockStateWrite() {
     auto lock = LockContainers();
     L_DBG("LockStateWrite CT{}:{}", Id, Name);
     while (StateLocked < 0)
-        ContainersCV.wait(lock);
+        LocksCV().wait(lock);
     StateLocked = -1 - StateLocked;
     while (StateLocked != -1)
-        ContainersCV.wait(lock);
+        LocksCV().wait(lock);
     LastStatePid = GetTid();
 }
 
@@ -277,7 +318,7 @@ void TContainer::DowngradeStateLock() {
     L_DBG("DowngradeStateLock CT{}:{}", Id, Name);
     PORTO_ASSERT(StateLocked == -1);
     StateLocked = 1;
-    ContainersCV.notify_all();
+    NotifyLocks();
 }
 
 void TContainer::UnlockState() {
@@ -287,7 +328,7 @@ void TContainer::UnlockState() {
     if (StateLocked > 0)
         --StateLocked;
     else if (++StateLocked >= -1)
-        ContainersCV.notify_all();
+        NotifyLocks();
 }
 
 void TContainer::DumpLocks() {
@@ -304,20 +345,95 @@ void TContainer::DumpLocks() {
     }
 }
 
+/* Owners of wait and seize tasks by pid, entries are checked at lookup */
+static std::mutex TaskPidsMutex;
+static std::unordered_map<pid_t, std::weak_ptr<TContainer>> TaskPids;
+
+void TContainer::IndexTaskPids() {
+    std::lock_guard<std::mutex> lock(TaskPidsMutex);
+    for (auto pid: {WaitTask.Pid, SeizeTask.Pid})
+        if (pid)
+            TaskPids[pid] = shared_from_this();
+}
+
+std::shared_ptr<TContainer> TContainer::FindTaskPid(pid_t pid) {
+    std::lock_guard<std::mutex> lock(TaskPidsMutex);
+    auto it = TaskPids.find(pid);
+    if (it == TaskPids.end())
+        return nullptr;
+    auto ct = it->second.lock();
+    if (ct && (ct->WaitTask.Pid == pid || ct->SeizeTask.Pid == pid))
+        return ct;
+    return nullptr;
+}
+
+/* Task has been reaped: drop entry unless pid is reused by another task */
+void TContainer::ForgetTaskPid(pid_t pid) {
+    std::lock_guard<std::mutex> lock(TaskPidsMutex);
+    auto it = TaskPids.find(pid);
+    if (it == TaskPids.end())
+        return;
+    auto ct = it->second.lock();
+    if (!ct || (ct->WaitTask.Pid != pid && ct->SeizeTask.Pid != pid))
+        TaskPids.erase(it);
+}
+
+/* label -> value -> containers, under ContainersMutex */
+static std::map<TString, std::map<TString, std::set<TContainer *>>> LabelIndex;
+
+static void IndexLabel(TContainer *ct, const TString &label, const TString &value, bool add) {
+    if (add) {
+        LabelIndex[label][value].insert(ct);
+        return;
+    }
+
+    auto it = LabelIndex.find(label);
+    if (it == LabelIndex.end())
+        return;
+    auto val = it->second.find(value);
+    if (val != it->second.end()) {
+        val->second.erase(ct);
+        if (val->second.empty())
+            it->second.erase(val);
+    }
+    if (it->second.empty())
+        LabelIndex.erase(it);
+}
+
 void TContainer::Register() {
     PORTO_LOCKED(ContainersMutex);
     Containers[Name] = shared_from_this();
+
+    auto &shard = ContainersIndexShard(Name);
+    auto index = std::make_shared<TContainersIndex>();
+    if (shard)
+        *index = *shard;
+    (*index)[Name] = shared_from_this();
+    std::atomic_store(&shard, std::shared_ptr<const TContainersIndex>(index));
+
     if (Parent)
         Parent->Children.emplace_back(shared_from_this());
     Statistics->ContainersCreated++;
+    ChangeLog.Touch(EChangeKind::Container, Name);
 }
 
 void TContainer::Unregister() {
     PORTO_LOCKED(ContainersMutex);
     Containers.erase(Name);
+
+    for (auto &it: Labels)
+        IndexLabel(this, it.first, it.second, false);
+
+    auto &shard = ContainersIndexShard(Name);
+    auto index = std::make_shared<TContainersIndex>(*shard);
+    index->erase(Name);
+    std::atomic_store(&shard, std::shared_ptr<const TContainersIndex>(index));
+
     if (Parent)
         Parent->Children.remove(shared_from_this());
 
+    ChangeLog.Remove(EChangeKind::Container, Name);
+
     TError error = ContainerIdMap.Put(Id);
     if (error)
         L_WRN("Cannot put CT{}:{} id: {}", Id, Name, error);
@@ -594,7 +710,7 @@ TError TContainer::Restore(const TKeyValue &kv, std::shared_ptr<TContainer> &ct)
 
     lock.unlock();
 
-    error = SystemClient.LockContainer(ct);
+    error = CL->LockContainer(ct);
     if (error)
         goto err;
 
@@ -612,11 +728,15 @@ TError TContainer::Restore(const TKeyValue &kv, std::shared_ptr<TContainer> &ct)
     /* Restore cgroups only for running containers */
     if (ct->State != EContainerState::Stopped &&
             ct->State != EContainerState::Dead) {
+        uint64_t start = GetCurrentTimeUs();
 
         error = TNetwork::RestoreNetwork(*ct);
+        Statistics->RestoreNetworkUs += GetCurrentTimeUs() - start;
         if (error)
             goto err;
 
+        start = GetCurrentTimeUs();
+
         error = ct->PrepareCgroups();
         if (error)
             goto err;
@@ -677,13 +797,22 @@ TError TContainer::Restore(const TKeyValue &kv, std::shared_ptr<TContainer> &ct)
         ct->PropagateCpuLimit();
 
         error = ct->SyncCgroups();
+        Statistics->RestoreCgroupsUs += GetCurrentTimeUs() - start;
         if (error)
             goto err;
     }
 
+    ct->IndexTaskPids();
+
     if (ct->State == EContainerState::Dead && ct->AutoRespawn)
         ct->ScheduleRespawn();
 
+    if (ct->State == EContainerState::Dead)
+        ct->ScheduleAging();
+    else if (ct->State == EContainerState::Running ||
+             ct->State == EContainerState::Paused)
+        TStdStream::WatchRotation(ct);
+
     /* Do not apply dynamic properties to dead container */
     if (ct->State == EContainerState::Dead)
         memset(ct->PropDirty, 0, sizeof(ct->PropDirty));
@@ -695,7 +824,7 @@ TError TContainer::Restore(const TKeyValue &kv, std::shared_ptr<TContainer> &ct)
     if (ct->State == EContainerState::Stopped)
         ct->RemoveWorkDir();
 
-    SystemClient.ReleaseContainer();
+    CL->ReleaseContainer();
 
     return OK;
 
@@ -704,7 +833,7 @@ err:
     ct->SetState(EContainerState::Stopped);
     ct->RemoveWorkDir();
     lock.lock();
-    SystemClient.ReleaseContainer(true);
+    CL->ReleaseContainer(true);
     ct->Unregister();
     ct = nullptr;
     return error;
@@ -798,11 +927,50 @@ TError TContainer::GetLabel(const TString &label, TString &value) const {
     return TError(EError::LabelNotFound, "Label {} is not set", label);
 }
 
+void TContainer::FindLabel(const TString &label, const TString &value,
+                           std::vector<std::pair<TContainer *, TString>> &found) {
+    PORTO_LOCKED(ContainersMutex);
+
+    auto add = [&](const TString &name, const std::map<TString, std::set<TContainer *>> &values) {
+        for (auto &val: values) {
+            if (!value.empty() && val.first != value)
+                continue;
+            for (auto ct: val.second)
+                found.emplace_back(ct, name);
+        }
+    };
+
+    auto wild = label.find_first_of("*?");
+    if (wild == TString::npos) {
+        auto it = LabelIndex.find(label);
+        if (it != LabelIndex.end())
+            add(it->first, it->second);
+    } else {
+        /* keys are ordered, scan only range with literal prefix */
+        auto prefix = label.substr(0, wild);
+        for (auto it = LabelIndex.lower_bound(prefix);
+                it != LabelIndex.end() && StringStartsWith(it->first, prefix); ++it)
+            if (StringMatch(it->first, label))
+                add(it->first, it->second);
+    }
+
+    std::sort(found.begin(), found.end(), [](const std::pair<TContainer *, TString> &a,
+                                             const std::pair<TContainer *, TString> &b) {
+        return a.first->Name < b.first->Name ||
+            (a.first->Name == b.first->Name && a.second < b.second);
+    });
+}
+
 void TContainer::SetLabel(const TString &label, const TString &value) {
-    if (value.empty())
+    auto it = Labels.find(label);
+    if (it != Labels.end())
+        IndexLabel(this, label, it->second, false);
+    if (value.empty()) {
         Labels.erase(label);
-    else
+    } else {
         Labels[label] = value;
+        IndexLabel(this, label, value, true);
+    }
     SetProp(EProperty::LABELS);
 }
 
@@ -830,10 +998,13 @@ TError TContainer::IncLabel(const TString &label, int64_t &result, int64_t add)
 
     val += add;
 
-    if (it == Labels.end())
+    if (it == Labels.end()) {
         Labels[label] = std::to_string(val);
-    else
+    } else {
+        IndexLabel(this, label, it->second, false);
         it->second = std::to_string(val);
+    }
+    IndexLabel(this, label, std::to_string(val), true);
 
     result = val;
 
@@ -980,6 +1151,8 @@ void TContainer::SetState(EContainerState next) {
     auto prev = State;
     State = next;
 
+    ChangeLog.Touch(EChangeKind::Container, Name);
+
     if (prev == EContainerState::Starting || next == EContainerState::Starting) {
         for (auto p = Parent; p; p = p->Parent)
             p->StartingChildren += next == EContainerState::Starting ? 1 : -1;
@@ -993,6 +1166,15 @@ void TContainer::SetState(EContainerState next) {
     if (next == EContainerState::Dead && AutoRespawn)
         ScheduleRespawn();
 
+    if (State == EContainerState::Dead)
+        ScheduleAging();
+
+    if (next == EContainerState::Running)
+        TStdStream::WatchRotation(shared_from_this());
+    else if ((prev == EContainerState::Running || prev == EContainerState::Paused) &&
+             next != EContainerState::Paused)
+        TStdStream::UnwatchRotation(*this);
+
     DowngradeStateLock();
 
     if (prev == EContainerState::Running || next == EContainerState::Running) {
@@ -2905,6 +3087,18 @@ void TContainer::FreeRuntimeResources() {
     }
 }
 
+/* Cache keeps knobs of own cgroups, dirs are reset with cache when resources are freed */
+TKnobCache &TContainer::GetKnobCache() {
+    if (!KnobCache.HasDirs() && (IsRoot() || HasResources())) {
+        std::unordered_set<TString> dirs;
+        for (auto hy: Hierarchies)
+            if (IsRoot() || (Controllers & hy->Controllers))
+                dirs.insert(GetCgroup(*hy).Path().ToString());
+        KnobCache.SetDirs(dirs);
+    }
+    return KnobCache;
+}
+
 void TContainer::FreeResources() {
     TError error;
 
@@ -2915,6 +3109,8 @@ void TContainer::FreeResources() {
     OomKillsRaw = 0;
     ClearProp(EProperty::OOM_KILLS);
 
+    KnobCache.Clear();
+
     for (auto hy: Hierarchies) {
         if (Controllers & hy->Controllers) {
             auto cg = GetCgroup(*hy);
@@ -3263,6 +3459,13 @@ TError TContainer::ScheduleRespawn() {
     return error;
 }
 
+void TContainer::ScheduleAging() {
+    uint64_t now = GetCurrentTimeMs();
+    uint64_t deadline = DeathTime + AgingTime;
+    TEvent e(EEventType::DestroyAgedContainer, shared_from_this());
+    EventQueue->Add(deadline > now ? deadline - now : 0, e);
+}
+
 TError TContainer::Respawn() {
     TError error;
 
@@ -3495,6 +3698,54 @@ TError TContainer::GetProperty(const TString &origProperty, TString &value) cons
     return error;
 }
 
+TError TContainer::GetStat(const TString &origProperty, rpc::TContainerStat &stat) const {
+    TString property = origProperty;
+    TString idx;
+    TError error;
+
+    if (ParsePropertyName(property, idx) && !idx.length())
+        return TError(EError::InvalidProperty, "Empty property index");
+
+    auto it = ContainerProperties.find(property);
+    if (it == ContainerProperties.end()) {
+        /* labels and cgroup knobs have only string values */
+        TString value;
+        error = GetProperty(origProperty, value);
+        if (!error)
+            stat.set_string_value(value);
+        return error;
+    }
+    auto prop = it->second;
+
+    CT = const_cast<TContainer *>(this);
+    error = prop->CanGet();
+    if (!error)
+        error = prop->GetStat(stat);
+    if (!error && idx.length()) {
+        bool found = false;
+        if (stat.has_map_value()) {
+            for (auto &kv: stat.map_value().map()) {
+                if (kv.key() == idx) {
+                    stat.set_uint_value(kv.val());
+                    found = true;
+                    break;
+                }
+            }
+            stat.clear_map_value();
+        }
+        if (!found) {
+            TString value;
+            stat.Clear();
+            error = prop->GetIndexed(idx, value);
+            if (!error)
+                stat.set_string_value(value);
+        }
+    }
+    CT = nullptr;
+
+    return error;
+}
+
 TError TContainer::SetProperty(const TString &origProperty,
                                const TString &origValue) {
     if (IsRoot())
@@ -3573,6 +3824,7 @@ TError TContainer::Load(const rpc::TContainerSpec &spec) {
     CT = this;
     LockStateWrite();
     ChangeTime = time(nullptr);
+    ChangeLog.Touch(EChangeKind::Container, Name);
     for (auto &it :ContainerProperties) {
         auto prop = it.second;
         if (!prop->Has(spec))
@@ -3622,6 +3874,7 @@ TError TContainer::Save(void) {
     TError error;
 
     ChangeTime = time(nullptr);
+    ChangeLog.Touch(EChangeKind::Container, Name);
 
     /* These are not properties */
     node.Set(P_RAW_ID, std::to_string(Id));
@@ -3654,7 +3907,7 @@ TError TContainer::Save(void) {
     if (error)
         return error;
 
-    return node.Save();
+    return node.Save(KvJournal);
 }
 
 TError TContainer::Load(const TKeyValue &node) {
@@ -3768,6 +4021,7 @@ TError TContainer::Seize() {
 
     if (SeizeTask.Pid) {
         SetProp(EProperty::SEIZE_PID);
+        IndexTaskPids();
         return OK;
     }
 
@@ -3991,15 +4245,8 @@ void TContainer::Event(const TEvent &event) {
     {
         bool delivered = false;
 
-        auto lock = LockContainers();
-        for (auto &it: Containers) {
-            if (it.second->WaitTask.Pid != event.Exit.Pid &&
-                    it.second->SeizeTask.Pid != event.Exit.Pid)
-                continue;
-            ct = it.second;
-            break;
-        }
-        lock.unlock();
+        if (!ct)
+            ct = FindTaskPid(event.Exit.Pid);
 
         if (ct && !CL->LockContainer(ct)) {
             if (ct->WaitTask.Pid == event.Exit.Pid ||
@@ -4010,6 +4257,8 @@ void TContainer::Event(const TEvent &event) {
             CL->ReleaseContainer();
         }
 
+        ForgetTaskPid(event.Exit.Pid);
+
         if (event.Type == EEventType::Exit) {
             AckExitStatus(event.Exit.Pid);
         } else {
@@ -4060,17 +4309,7 @@ void TContainer::Event(const TEvent &event) {
 
     case EEventType::RotateLogs:
     {
-        for (auto &ct: RootContainer->Subtree()) {
-            if (ct->State == EContainerState::Dead &&
-                    GetCurrentTimeMs() >= ct->DeathTime + ct->AgingTime) {
-                TEvent ev(EEventType::DestroyAgedContainer, ct);
-                EventQueue->Add(0, ev);
-            }
-            if (ct->State == EContainerState::Running) {
-                ct->Stdout.Rotate(*ct);
-                ct->Stderr.Rotate(*ct);
-            }
-        }
+        TStdStream::RotateLogs();
 
         struct stat st;
         if (!StdLog && LogFile && !LogFile.Stat(st) && !st.st_nlink)
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <map>
 #include <memory>
 #include <atomic>
 #include <condition_variable>
@@ -10,11 +11,13 @@
 #include "util/unix.hpp"
 #include "util/log.hpp"
 #include "util/idmap.hpp"
+#include "cgroup.hpp"
 #include "task.hpp"
 #include "stream.hpp"
 #include "property.hpp"
 #include "network.hpp"
 #include "device.hpp"
+#include "kvalue.hpp"
 
 class TEpollSource;
 class TCgroup;
@@ -64,6 +67,9 @@ class TContainer : public std::enable_shared_from_this<TContainer>,
     pid_t LastStatePid = 0;
     pid_t LastActionPid = 0;
 
+    std::condition_variable &LocksCV();
+    void NotifyLocks();
+
     TFile OomEvent;
 
     std::shared_ptr<TEpollSource> Source;
@@ -227,6 +233,7 @@ public:
     TError MayRespawn();
     TError Respawn();
     TError ScheduleRespawn();
+    void ScheduleAging();
 
     TStringMap Labels;
     TString Private;
@@ -269,6 +276,9 @@ public:
 
     /* Protected with NetStateMutex and container lock */
     TNetClass NetClass;
+    TKnobCache KnobCache;
+    TKnobCache &GetKnobCache();
+    TKeyValueJournal KvJournal;
 
     TPath GetCwd() const;
     int GetExitCode() const;
@@ -386,6 +396,7 @@ public:
     TError EnableControllers(uint64_t controllers);
     TError HasProperty(const TString &property) const;
     TError GetProperty(const TString &property, TString &value) const;
+    TError GetStat(const TString &property, rpc::TContainerStat &stat) const;
     TError SetProperty(const TString &property, const TString &value);
 
     TError Load(const rpc::TContainerSpec &spec);
@@ -397,6 +408,15 @@ public:
     void SetLabel(const TString &label, const TString &value);
     TError IncLabel(const TString &label, int64_t &result, int64_t add = 1);
 
+    /* Index of wait and seize task pids for routing exit events */
+    void IndexTaskPids();
+    static std::shared_ptr<TContainer> FindTaskPid(pid_t pid);
+    static void ForgetTaskPid(pid_t pid);
+
+    /* Containers with label name or wildcard and value if set, ordered by name */
+    static void FindLabel(const TString &label, const TString &value,
+                          std::vector<std::pair<TContainer *, TString>> &found);
+
     void ForgetPid();
     void SyncState();
     TError Seize();
@@ -411,6 +431,7 @@ public:
 
     /* protected with VolumesLock and container lock */
     std::list<std::shared_ptr<TVolumeLink>> VolumeLinks;
+    std::multimap<const TVolume *, std::list<std::shared_ptr<TVolumeLink>>::iterator> VolumeLinkIndex;
     int VolumeMounts = 0;
 
     /* protected with VolumesLock */
@@ -16,13 +16,7 @@ static TError EpollCreate(int &epfd) {
 }
 
 TError TEpollLoop::Create() {
-    TError error = EpollCreate(EpollFd);
-    if (error)
-        return error;
-
-    Statistics->EpollSources = 0;
-
-    return OK;
+    return EpollCreate(EpollFd);
 }
 
 void TEpollLoop::Destroy() {
@@ -55,6 +49,9 @@ TError TEpollLoop::GetEvents(std::vector<struct epoll_event> &evts, int timeout)
     for (int i = 0; i < nr; i++)
         evts.push_back(Events[i]);
 
+    if (nr > 0)
+        EventsCount += nr;
+
     return OK;
 }
 
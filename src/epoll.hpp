@@ -2,6 +2,7 @@
 
 #include <map>
 #include <memory>
+#include <atomic>
 
 #include "common.hpp"
 #include "util/locks.hpp"
@@ -31,9 +32,9 @@ class TEpollLoop : public TLockable, public TPortoNonCopyable {
 
     std::vector<std::weak_ptr<TEpollSource>> Sources;
 
-    TError ModifySourceEvents(int fd, uint32_t events) const;
-
 public:
+    std::atomic<uint64_t> EventsCount{0};
+
     TError Create();
     void Destroy();
     ~TEpollLoop();
@@ -45,6 +46,7 @@ public:
     TError StartInput(int fd) const;
     TError StopInput(int fd) const;
     TError StartOutput(int fd) const;
+    TError ModifySourceEvents(int fd, uint32_t events) const;
 
     TError GetEvents(std::vector<struct epoll_event> &evts, int timeout);
 };
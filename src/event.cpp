@@ -2,50 +2,9 @@
 #include "event.hpp"
 #include "util/log.hpp"
 #include "util/unix.hpp"
-#include "util/worker.hpp"
 #include "container.hpp"
 #include "client.hpp"
 
-class TEventWorker : public TWorker<TEvent, std::priority_queue<TEvent>> {
-public:
-    TEventWorker(const size_t nr) : TWorker("portod-EV", nr), client("<event>") {}
-
-    TClient client;
-
-    const TEvent &Top() override {
-        return Queue.top();
-    }
-
-    void Wait(TScopedLock &lock) override {
-        if (!Valid)
-            return;
-
-        Statistics->QueuedEvents = Queue.size();
-
-        if (Queue.size()) {
-            auto now = GetCurrentTimeMs();
-            if (Top().DueMs <= now)
-                return;
-            auto timeout = Top().DueMs - now;
-            Cv.wait_for(lock, std::chrono::milliseconds(timeout));
-        } else {
-            TWorker::Wait(lock);
-        }
-    }
-
-    bool Handle(const TEvent &event) override {
-        if (event.DueMs <= GetCurrentTimeMs()) {
-            client.ClientContainer = RootContainer;
-            client.StartRequest();
-            TContainer::Event(event);
-            client.FinishRequest();
-            return true;
-        }
-
-        return false;
-    }
-};
-
 TString TEvent::GetMsg() const {
     switch (Type) {
         case EEventType::ChildExit:
@@ -71,24 +30,167 @@ TString TEvent::GetMsg() const {
     }
 }
 
-bool TEvent::operator<(const TEvent& rhs) const {
-    return DueMs >= rhs.DueMs;
+TString TEvent::TypeName(EEventType type) {
+    switch (type) {
+        case EEventType::Exit:
+            return "exit";
+        case EEventType::ChildExit:
+            return "child_exit";
+        case EEventType::RotateLogs:
+            return "rotate_logs";
+        case EEventType::Respawn:
+            return "respawn";
+        case EEventType::OOM:
+            return "oom";
+        case EEventType::WaitTimeout:
+            return "wait_timeout";
+        case EEventType::DestroyAgedContainer:
+            return "destroy_aged";
+        case EEventType::DestroyWeakContainer:
+            return "destroy_weak";
+        default:
+            return "unknown";
+    }
+}
+
+TEventQueue::TEventQueue() {
+    for (int type = 0; type < EVENT_TYPES; type++) {
+        Handled[type] = 0;
+        for (int i = 0; i < HIST_SIZE; i++)
+            LatencyHist[type][i] = 0;
+    }
+
+    /* shards exist before start: events could be added during restore */
+    for (unsigned i = 0; i < std::max(config().daemon().event_threads(), 1u); i++)
+        Shards.emplace_back(new TShard);
 }
 
 void TEventQueue::Add(uint64_t timeoutMs, const TEvent &e) {
-    TEvent copy = e;
-    copy.DueMs = GetCurrentTimeMs() + timeoutMs;
-    Worker->Push(copy);
+    TScheduled item = { 0, e };
+    auto ct = item.Event.Container.lock();
+
+    /* exit events are sharded by container which owns the task */
+    if (!ct && (e.Type == EEventType::Exit || e.Type == EEventType::ChildExit)) {
+        ct = TContainer::FindTaskPid(e.Exit.Pid);
+        item.Event.Container = ct;
+    }
+
+    if (ct && !ct->IsRoot()) {
+        auto top = ct->Name.substr(0, ct->Name.find('/'));
+        item.Shard = std::hash<TString>()(top) % Shards.size();
+    }
+
+    std::lock_guard<std::mutex> lock(Mutex);
+    auto now = GetCurrentTimeMs();
+    auto dispatch = [this](TScheduled &&due) { Dispatch(std::move(due)); };
+
+    item.Event.DueMs = now + timeoutMs;
+    Statistics->QueuedEvents = ++Queued;
+
+    /* keep due order: expire earlier events before immediate one */
+    Wheel.Advance(now, dispatch);
+    Wheel.Insert(item.Event.DueMs, item);
+    if (timeoutMs)
+        Wakeup.notify_one();
+    else
+        Wheel.Advance(now, dispatch);
 }
 
-TEventQueue::TEventQueue() {
-    Worker = std::make_shared<TEventWorker>(1);
+void TEventQueue::Dispatch(TScheduled &&item) {
+    auto &shard = *Shards[item.Shard];
+    std::lock_guard<std::mutex> lock(shard.Mutex);
+    shard.Queue.push_back(std::move(item.Event));
+    shard.Wakeup.notify_one();
+}
+
+void TEventQueue::TimerFn() {
+    SetProcessName("portod-EQ");
+
+    std::unique_lock<std::mutex> lock(Mutex);
+    while (!ShouldStop) {
+        auto now = GetCurrentTimeMs();
+        Wheel.Advance(now, [this](TScheduled &&due) { Dispatch(std::move(due)); });
+
+        auto due = Wheel.NextDueMs();
+        if (due == UINT64_MAX)
+            Wakeup.wait(lock);
+        else if (due > now)
+            Wakeup.wait_for(lock, std::chrono::milliseconds(due - now));
+    }
+}
+
+void TEventQueue::ShardFn(TShard &shard, int index) {
+    SetProcessName("portod-EV" + std::to_string(index));
+
+    TClient client("<event>");
+
+    std::unique_lock<std::mutex> lock(shard.Mutex);
+    while (!ShouldStop) {
+        if (shard.Queue.empty()) {
+            shard.Wakeup.wait(lock);
+            continue;
+        }
+
+        TEvent event = std::move(shard.Queue.front());
+        shard.Queue.pop_front();
+        lock.unlock();
+
+        Statistics->QueuedEvents = --Queued;
+
+        auto now = GetCurrentTimeMs();
+        auto latency = now > event.DueMs ? now - event.DueMs : 0;
+        int type = (int)event.Type;
+        Handled[type]++;
+        for (int i = 0; i < HIST_SIZE; i++)
+            if (latency <= LatencyBuckets[i])
+                LatencyHist[type][i]++;
+
+        client.ClientContainer = RootContainer;
+        client.StartRequest();
+        TContainer::Event(event);
+        client.FinishRequest();
+
+        lock.lock();
+    }
 }
 
 void TEventQueue::Start() {
-    Worker->Start();
+    ShouldStop = false;
+    for (unsigned i = 0; i < Shards.size(); i++)
+        Shards[i]->Thread = std::unique_ptr<std::thread>(
+                new std::thread(&TEventQueue::ShardFn, this, std::ref(*Shards[i]), i));
+    Timer = std::unique_ptr<std::thread>(new std::thread(&TEventQueue::TimerFn, this));
 }
 
 void TEventQueue::Stop() {
-    Worker->Stop();
+    if (!Timer)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        ShouldStop = true;
+        Wakeup.notify_all();
+    }
+    Timer->join();
+    Timer = nullptr;
+
+    for (auto &shard: Shards) {
+        {
+            std::lock_guard<std::mutex> lock(shard->Mutex);
+            shard->Wakeup.notify_all();
+        }
+        shard->Thread->join();
+        shard->Thread = nullptr;
+    }
+}
+
+void TEventQueue::Dump(TUintMap &stat) {
+    for (int type = 0; type < EVENT_TYPES; type++) {
+        auto prefix = "event:" + TEvent::TypeName((EEventType)type) + ":";
+        stat[prefix + "handled"] = Handled[type];
+        for (int i = 0; i < HIST_SIZE; i++) {
+            auto le = LatencyBuckets[i] == UINT64_MAX ? TString("inf") : std::to_string(LatencyBuckets[i]);
+            stat[prefix + "latency_ms_le_" + le] = LatencyHist[type][i];
+        }
+    }
 }
@@ -2,8 +2,15 @@
 
 #include <string>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <deque>
+#include <vector>
 
-#include "util/worker.hpp"
+#include "util/timerwheel.hpp"
+#include "util/string.hpp"
 
 class TContainer;
 class TContainerWaiter;
@@ -19,7 +26,7 @@ enum class EEventType {
     DestroyWeakContainer,
 };
 
-class TEventWorker;
+constexpr int EVENT_TYPES = (int)EEventType::DestroyWeakContainer + 1;
 
 class TEvent {
 public:
@@ -40,13 +47,46 @@ public:
     TEvent(EEventType type, std::shared_ptr<TContainer> container = nullptr) :
         Type(type), Container(container) {}
 
-    bool operator<(const TEvent& rhs) const;
-
     TString GetMsg() const;
+    static TString TypeName(EEventType type);
 };
 
+/*
+ * Scheduled events wait in timer wheel, due events are handled by pool
+ * of workers. Events are sharded by top-level container: events of one
+ * container subtree are handled by one worker in order of due time.
+ * Exit events find owner by task pid index, global events go to first worker.
+ */
 class TEventQueue {
-    std::shared_ptr<TEventWorker> Worker;
+    static constexpr int HIST_SIZE = 6;
+    const uint64_t LatencyBuckets[HIST_SIZE] = { 1, 10, 100, 1000, 10000, UINT64_MAX };
+
+    struct TScheduled {
+        size_t Shard;
+        TEvent Event;
+    };
+
+    struct TShard {
+        std::mutex Mutex;
+        std::condition_variable Wakeup;
+        std::deque<TEvent> Queue;
+        std::unique_ptr<std::thread> Thread;
+    };
+
+    std::mutex Mutex;
+    std::condition_variable Wakeup;
+    TTimerWheel<TScheduled> Wheel;
+    std::unique_ptr<std::thread> Timer;
+    std::vector<std::unique_ptr<TShard>> Shards;
+    std::atomic<bool> ShouldStop{false};
+
+    std::atomic<uint64_t> Queued{0};
+    std::atomic<uint64_t> Handled[EVENT_TYPES];
+    std::atomic<uint64_t> LatencyHist[EVENT_TYPES][HIST_SIZE];
+
+    void Dispatch(TScheduled &&item);
+    void TimerFn();
+    void ShardFn(TShard &shard, int index);
 
 public:
     TEventQueue();
@@ -54,4 +94,5 @@ public:
     void Stop();
 
     void Add(uint64_t timeoutMs, const TEvent &e);
+    void Dump(TUintMap &stat);
 };
@@ -3,6 +3,9 @@
 #include "util/path.hpp"
 #include "util/log.hpp"
 #include "util/unix.hpp"
+#include "util/copy.hpp"
+#include "util/remove.hpp"
+#include "config.hpp"
 
 extern "C" {
 #include <unistd.h>
@@ -143,6 +146,20 @@ TError CopyRecursive(const TPath &src, const TPath &dst) {
     TError error;
     TFile dir;
 
+    if (config().volumes().copy_threads()) {
+        TTreeCopy copy;
+        uint64_t start = GetCurrentTimeMs();
+
+        copy.Threads = config().volumes().copy_threads();
+        error = copy.Copy(src, dst);
+        if (!error)
+            L_ACT("Copied {} files {} dirs {} bytes ({} cloned) in {} ms",
+                  (uint64_t)copy.Files, (uint64_t)copy.Directories,
+                  (uint64_t)copy.Bytes, (uint64_t)copy.ClonedBytes,
+                  GetCurrentTimeMs() - start);
+        return error;
+    }
+
     error = dir.OpenDir(dst);
     if (error)
         return error;
@@ -156,6 +173,12 @@ TError ClearRecursive(const TPath &path) {
     TError error;
     TFile dir;
 
+    if (config().volumes().remove_threads()) {
+        TTreeRemove remove;
+        remove.Threads = config().volumes().remove_threads();
+        return remove.Clear(path);
+    }
+
     error = dir.OpenDir(path);
     if (error)
         return error;
@@ -167,6 +190,17 @@ TError RemoveRecursive(const TPath &path) {
     TError error;
     TFile dir;
 
+    if (config().volumes().remove_threads()) {
+        TTreeRemove remove;
+        uint64_t start = GetCurrentTimeMs();
+
+        remove.Threads = config().volumes().remove_threads();
+        error = remove.Remove(path);
+        L_ACT("Removed {} files {} dirs in {} ms", (uint64_t)remove.Files,
+              (uint64_t)remove.Directories, GetCurrentTimeMs() - start);
+        return error;
+    }
+
     error = dir.OpenDir(path.NormalPath().DirName());
     if (error)
         return error;
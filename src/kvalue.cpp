@@ -8,6 +8,7 @@
 extern "C" {
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/stat.h>
 }
 
 TError TKeyValue::Load() {
@@ -25,8 +26,18 @@ TError TKeyValue::Load() {
     while (size) {
         uint32_t len;
 
-        if (!input.ReadVarint32(&len))
+        /*
+         * Crash while appending journal record leaves torn tail: keep
+         * records before it, node is compacted at first save after restore.
+         */
+        if (!input.ReadVarint32(&len) ||
+                size < (ssize_t)(google::protobuf::io::CodedOutputStream::VarintSize32(len) + len)) {
+            if ((size_t)size < buf.size()) {
+                L_WRN("KeyValue: drop torn tail of {} at {}", Path, buf.size() - size);
+                break;
+            }
             return TError("KeyValue: corrupted storage");
+        }
 
         size -= google::protobuf::io::CodedOutputStream::VarintSize32(len);
         size -= len;
@@ -46,17 +57,7 @@ TError TKeyValue::Load() {
     return OK;
 }
 
-TError TKeyValue::Save() {
-    TString buf;
-    kv::TNode node;
-    TError error;
-
-    for (const auto &pair: Data) {
-        auto kv = node.add_pairs();
-        kv->set_key(pair.first);
-        kv->set_val(pair.second);
-    }
-
+static TError SerializeRecord(const kv::TNode &node, TString &buf) {
     uint32_t len = node.ByteSize();
     size_t lenLen = google::protobuf::io::CodedOutputStream::VarintSize32(len);
 
@@ -69,6 +70,24 @@ TError TKeyValue::Save() {
     if (!node.SerializeToArray((uint8_t *)&buf[lenLen], len))
         return TError("KeyValue: cannot serialize");
 
+    return OK;
+}
+
+TError TKeyValue::Save() {
+    TString buf;
+    kv::TNode node;
+    TError error;
+
+    for (const auto &pair: Data) {
+        auto kv = node.add_pairs();
+        kv->set_key(pair.first);
+        kv->set_val(pair.second);
+    }
+
+    error = SerializeRecord(node, buf);
+    if (error)
+        return error;
+
     TPath tmpPath(Path.ToString() + ".tmp");
     error = tmpPath.Mkfile(0640);
     if (!error)
@@ -84,6 +103,74 @@ TError TKeyValue::Save() {
     return error;
 }
 
+TError TKeyValue::Save(TKeyValueJournal &journal) {
+    std::lock_guard<std::mutex> lock(journal.Mutex);
+    struct stat st;
+    TString buf;
+    kv::TNode node;
+    TFile file;
+    TError error;
+
+    if (!config().keyvalue_journal() || !journal.Valid)
+        goto compact;
+
+    for (const auto &pair: Data) {
+        auto it = journal.Saved.find(pair.first);
+        if (it != journal.Saved.end() && it->second == pair.second)
+            continue;
+        auto kv = node.add_pairs();
+        kv->set_key(pair.first);
+        kv->set_val(pair.second);
+    }
+
+    /*
+     * Removal cannot be expressed as delta readable by older portod,
+     * it would restore removed key with empty value. Rewrite whole node.
+     */
+    for (const auto &pair: journal.Saved)
+        if (!Data.count(pair.first))
+            goto compact;
+
+    if (!node.pairs_size())
+        return OK;
+
+    error = SerializeRecord(node, buf);
+    if (error ||
+            journal.FileSize + buf.size() > config().keyvalue_limit() ||
+            journal.FileSize + buf.size() > journal.CompactSize * 2)
+        goto compact;
+
+    error = file.OpenAppend(Path);
+    if (!error)
+        error = file.WriteAll(buf);
+    if (error) {
+        L_WRN("Cannot append keyvalue record {}: {}", Path, error);
+        goto compact;
+    }
+
+    journal.Saved = Data;
+    journal.FileSize += buf.size();
+    Statistics->KeyValueAppends++;
+    return OK;
+
+compact:
+    journal.Valid = false;
+
+    error = Save();
+    if (error)
+        return error;
+
+    error = Path.StatStrict(st);
+    if (error)
+        return OK;
+
+    journal.Saved = Data;
+    journal.FileSize = journal.CompactSize = st.st_size;
+    journal.Valid = true;
+    Statistics->KeyValueRewrites++;
+    return OK;
+}
+
 TError TKeyValue::Mount(const TPath &root) {
     TError error;
     TMount mount;
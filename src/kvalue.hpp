@@ -3,9 +3,23 @@
 #include <string>
 #include <map>
 #include <list>
+#include <mutex>
 #include "common.hpp"
 #include "util/path.hpp"
 
+/*
+ * Last saved content of node. Node is a sequence of records, later
+ * override earlier, so changes could be appended as delta records.
+ * Node is rewritten (compacted) when deltas outgrow full record.
+ */
+struct TKeyValueJournal {
+    std::mutex Mutex;
+    std::map<TString, TString> Saved;
+    uint64_t FileSize = 0;
+    uint64_t CompactSize = 0;
+    bool Valid = false;
+};
+
 class TKeyValue {
 public:
     TPath Path;
@@ -38,6 +52,7 @@ public:
 
     TError Load();
     TError Save();
+    TError Save(TKeyValueJournal &journal);
 
     static TError Mount(const TPath &root);
     static TError ListAll(const TPath &root, std::list<TKeyValue> &nodes);
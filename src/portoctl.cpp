@@ -1431,6 +1431,76 @@ public:
     }
 };
 
+class TSamplesCmd final : public ICmd {
+public:
+    TSamplesCmd(Porto::Connection *api) : ICmd(api, "samples", 0,
+             "[-c <count>] [-r] [container|wildcard] ...",
+             "show resource usage history collected by portod",
+             "    -c <count>    last samples, default: all\n"
+             "    -r            raw counters instead of rates\n"
+             ) {}
+
+    int Execute(TCommandEnviroment *env) final override {
+        uint32_t count = 0;
+        bool raw = false;
+        const auto &containers = env->GetOpts({
+            { 'c', true, [&](const char *arg) { count = std::stoi(arg); } },
+            { 'r', false, [&](const char *) { raw = true; } },
+        });
+
+        auto rsp = Api->GetSamples(containers, count);
+        if (!rsp) {
+            PrintError("Can't get samples");
+            return EXIT_FAILURE;
+        }
+
+        for (auto &ct: rsp->container()) {
+            if (ct.has_error()) {
+                PrintError("Can't get samples of " + ct.name(),
+                           TError(ct.error().error(), ct.error().msg()));
+                continue;
+            }
+
+            if (rsp->container_size() > 1)
+                fmt::print("{}:\n", ct.name());
+
+            if (raw)
+                fmt::print("{:<20} {:>16} {:>16} {:>12} {:>12} {:>14} {:>14} {:>12} {:>14} {:>14}\n",
+                           "time", "cpu_usage", "cpu_system", "memory", "anon",
+                           "io_read", "io_write", "io_ops", "net_rx", "net_tx");
+            else
+                fmt::print("{:<20} {:>8} {:>8} {:>10} {:>10} {:>10} {:>10} {:>8} {:>10} {:>10}\n",
+                           "time", "cpu", "system", "memory", "anon",
+                           "read/s", "write/s", "iops", "rx/s", "tx/s");
+
+            for (auto &s: ct.sample()) {
+                auto time = FormatTime(s.time() / 1000);
+                if (raw)
+                    fmt::print("{:<20} {:>16} {:>16} {:>12} {:>12} {:>14} {:>14} {:>12} {:>14} {:>14}\n",
+                               time, s.cpu_usage(), s.cpu_usage_system(),
+                               s.memory_usage(), s.anon_usage(),
+                               s.io_read(), s.io_write(), s.io_ops(),
+                               s.net_rx_bytes(), s.net_tx_bytes());
+                else if (s.has_cpu_usage_rate())
+                    fmt::print("{:<20} {:>8.2f} {:>8.2f} {:>10} {:>10} {:>10} {:>10} {:>8} {:>10} {:>10}\n",
+                               time, s.cpu_usage_rate() / 1e9, s.cpu_system_rate() / 1e9,
+                               StringFormatSize(s.memory_usage()),
+                               StringFormatSize(s.anon_usage()),
+                               StringFormatSize(s.io_read_rate()),
+                               StringFormatSize(s.io_write_rate()),
+                               s.io_ops_rate(),
+                               StringFormatSize(s.net_rx_rate()),
+                               StringFormatSize(s.net_tx_rate()));
+            }
+
+            if (rsp->container_size() > 1)
+                fmt::print("\n");
+        }
+
+        return EXIT_SUCCESS;
+    }
+};
+
 class TListCmd final : public ICmd {
 public:
     TListCmd(Porto::Connection *api) : ICmd(api, "list", 0,
@@ -2252,6 +2322,18 @@ public:
                         std::cout << "\tprivate\t" << l.private_value() << std::endl;
                     std::cout << std::endl;
                 }
+                for (const auto &i: list->importing()) {
+                    if (!verbose)
+                        break;
+                    std::cout << i.layer() << std::endl;
+                    std::cout << "\timporting\t" << StringFormatSize(i.archive_read()) << " of " <<
+                        StringFormatSize(i.archive_size()) << ", unpacked " << i.entries() << " entries " <<
+                        StringFormatSize(i.bytes()) << " in " << StringFormatDuration(i.time_ms()) << std::endl;
+                    std::cout << std::endl;
+                }
+                if (verbose && list->dedup_files())
+                    std::cout << "dedup\t" << list->dedup_files() << " files, " <<
+                        StringFormatSize(list->dedup_bytes()) << " saved" << std::endl;
             }
         } else if (get_private) {
             if (args.size() < 1)
@@ -2834,6 +2916,7 @@ int main(int argc, char *argv[]) {
     handler.RegisterCommand<TGcCmd>();
     handler.RegisterCommand<TFindCmd>();
     handler.RegisterCommand<TWaitCmd>();
+    handler.RegisterCommand<TSamplesCmd>();
 
     handler.RegisterCommand<TCreateVolumeCmd>();
     handler.RegisterCommand<TLinkVolumeCmd>();
@@ -3,6 +3,12 @@
 #include <algorithm>
 #include <csignal>
 #include <iostream>
+#include <thread>
+#include <deque>
+#include <set>
+#include <map>
+#include <condition_variable>
+#include <atomic>
 
 #include "version.hpp"
 #include "kvalue.hpp"
@@ -18,6 +24,8 @@
 #include "storage.hpp"
 #include "helpers.hpp"
 #include "core.hpp"
+#include "sampler.hpp"
+#include "changelog.hpp"
 #include "util/log.hpp"
 #include "util/signal.hpp"
 #include "util/unix.hpp"
@@ -33,6 +41,7 @@ extern "C" {
 #include <unistd.h>
 #include <sys/un.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <poll.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -51,6 +60,7 @@ static TPidFile MasterPidFile(PORTO_MASTER_PIDFILE, PORTOD_MASTER_NAME, "portod"
 static TPidFile PortodPidFile(PORTO_PIDFILE, PORTOD_NAME, "portod-slave");
 
 std::unique_ptr<TEpollLoop> EpollLoop;
+std::vector<std::unique_ptr<TEpollLoop>> IoLoops;
 std::unique_ptr<TEventQueue> EventQueue;
 
 static pid_t MasterPid;
@@ -248,25 +258,79 @@ retry:
     return 0;
 }
 
-static std::map<int, std::shared_ptr<TClient>> Clients;
+/*
+ * Client connections are sharded between epoll loops by fd.
+ * Shard 0 is served by main loop, others by IoLoops in own threads.
+ */
+struct TClientShard {
+    TEpollLoop *Loop;
+    std::mutex Mutex;
+    std::map<int, std::shared_ptr<TClient>> Clients;
+};
+
+static std::vector<std::unique_ptr<TClientShard>> ClientShards;
+
+static TClientShard &ClientShard(int fd) {
+    return *ClientShards[fd % ClientShards.size()];
+}
+
+static bool ClientsEmpty() {
+    for (auto &shard: ClientShards) {
+        auto lock = std::unique_lock<std::mutex>(shard->Mutex);
+        if (!shard->Clients.empty())
+            return false;
+    }
+    return true;
+}
+
+static void DropClient(std::shared_ptr<TClient> client, int fd) {
+    auto &shard = ClientShard(fd);
+    auto lock = std::unique_lock<std::mutex>(shard.Mutex);
+    auto it = shard.Clients.find(fd);
+    /* fd might be already reused by another client */
+    if (it != shard.Clients.end() && it->second == client)
+        shard.Clients.erase(it);
+    lock.unlock();
+    client->CloseConnection();
+}
+
+static bool ClientEvent(TClientShard &shard, int fd, uint32_t events) {
+    auto lock = std::unique_lock<std::mutex>(shard.Mutex);
+    auto it = shard.Clients.find(fd);
+    if (it == shard.Clients.end())
+        return false;
+    auto client = it->second;
+    lock.unlock();
+
+    TError error = client->Event(events);
+    if (error)
+        DropClient(client, fd);
+    return true;
+}
 
 static TError DropIdleClient(std::shared_ptr<TContainer> from = nullptr) {
     uint64_t idle = config().daemon().client_idle_timeout() * 1000;
     uint64_t now = GetCurrentTimeMs();
     std::shared_ptr<TClient> victim;
+    int victimFd = -1;
 
-    for (auto &it: Clients) {
-        auto &client = it.second;
+    for (auto &shard: ClientShards) {
+        auto lock = std::unique_lock<std::mutex>(shard->Mutex);
 
-        if (client->Processing || client->Sending)
-            continue;
+        for (auto &it: shard->Clients) {
+            auto &client = it.second;
 
-        if (from && client->ClientContainer != from)
-            continue;
+            if (client->Processing || client->Sending)
+                continue;
 
-        if (now - client->ActivityTimeMs > idle) {
-            victim = client;
-            idle = now - client->ActivityTimeMs;
+            if (from && client->ClientContainer != from)
+                continue;
+
+            if (now - client->ActivityTimeMs > idle) {
+                victim = client;
+                victimFd = it.first;
+                idle = now - client->ActivityTimeMs;
+            }
         }
     }
 
@@ -276,8 +340,7 @@ static TError DropIdleClient(std::shared_ptr<TContainer> from = nullptr) {
                       (from ? from->Name : "globally"));
 
     L_SYS("Kick client {} idle={} ms", victim->Id, idle);
-    Clients.erase(victim->Fd);
-    victim->CloseConnection();
+    DropClient(victim, victimFd);
     return OK;
 }
 
@@ -323,12 +386,15 @@ static TError AcceptConnection(int listenFd) {
             return error;
     }
 
-    error = EpollLoop->AddSource(client);
+    auto &shard = ClientShard(client->Fd);
+    auto lock = std::unique_lock<std::mutex>(shard.Mutex);
+
+    error = shard.Loop->AddSource(client);
     if (error)
         return error;
 
-    client->InEpoll = true; /* FIXME cleanup this crap */
-    Clients[client->Fd] = client;
+    client->Loop = shard.Loop;
+    shard.Clients[client->Fd] = client;
 
     return OK;
 }
@@ -342,15 +408,56 @@ static void StartShutdown() {
     EpollLoop->RemoveSource(PORTO_SK_FD);
 
     /* Kick idle clients */
-    for (auto it = Clients.begin(); it != Clients.end(); ) {
-        auto client = it->second;
+    for (auto &shard: ClientShards) {
+        std::vector<std::shared_ptr<TClient>> idle;
+        auto lock = std::unique_lock<std::mutex>(shard->Mutex);
 
-        if (client->IsBlockShutdown()) {
-            L_SYS("Client blocks shutdown: {}", client->Id);
-            ++it;
-        } else {
+        for (auto it = shard->Clients.begin(); it != shard->Clients.end(); ) {
+            auto client = it->second;
+
+            if (client->IsBlockShutdown()) {
+                L_SYS("Client blocks shutdown: {}", client->Id);
+                ++it;
+            } else {
+                idle.push_back(client);
+                it = shard->Clients.erase(it);
+            }
+        }
+
+        lock.unlock();
+
+        for (auto &client: idle)
             client->CloseConnection();
-            it = Clients.erase(it);
+    }
+}
+
+static std::atomic<bool> StopIoLoops;
+
+static void IoLoop(int index, int wakeFd) {
+    auto &loop = IoLoops[index - 1];
+    auto &shard = *ClientShards[index];
+    std::vector<struct epoll_event> events;
+    TError error;
+
+    SetProcessName(fmt::format("portod-EP{}", index));
+
+    while (true) {
+        error = loop->GetEvents(events, 1000);
+        if (error) {
+            L_ERR("epoll error {}", error);
+            break;
+        }
+
+        for (auto ev : events) {
+            if (ev.data.fd == wakeFd) {
+                if (StopIoLoops)
+                    return;
+                continue;
+            }
+
+            auto source = loop->GetSource(ev.data.fd);
+            if (source)
+                ClientEvent(shard, source->Fd, ev.events);
         }
     }
 }
@@ -382,8 +489,43 @@ static void PortodServer() {
         return;
     }
 
+    /* One wakeup eventfd for stopping all additional loops */
+    int wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0) {
+        L_ERR("Can't create eventfd: {}", TError::System("eventfd"));
+        return;
+    }
+    auto wakeSource = std::make_shared<TEpollSource>(wakeFd);
+
+    int nr_loops = std::max(config().daemon().io_loops(), 1u);
+    for (int i = 0; i < nr_loops; i++) {
+        ClientShards.emplace_back(new TClientShard());
+        if (i == 0) {
+            ClientShards[i]->Loop = EpollLoop.get();
+            continue;
+        }
+        IoLoops.emplace_back(new TEpollLoop());
+        error = IoLoops.back()->Create();
+        if (!error)
+            error = IoLoops.back()->AddSource(wakeSource);
+        if (error) {
+            L_ERR("Can't create epoll loop: {}", error);
+            return;
+        }
+        ClientShards[i]->Loop = IoLoops.back().get();
+    }
+
     StartRpcQueue();
     EventQueue->Start();
+    StartSampler();
+    TStorage::StartTrashReaper();
+    TVolume::StartUsageRefresher();
+    TVolume::StartLoopPool();
+    TStdStream::StartFollower();
+
+    std::vector<std::unique_ptr<std::thread>> ioThreads;
+    for (int i = 1; i < nr_loops; i++)
+        ioThreads.emplace_back(new std::thread(&IoLoop, i, wakeFd));
 
     if (config().daemon().log_rotate_ms()) {
         TEvent ev(EEventType::RotateLogs);
@@ -470,13 +612,8 @@ static void PortodServer() {
                     EventQueue->Add(0, e);
                 }
 
-            } else if (Clients.find(source->Fd) != Clients.end()) {
-                auto client = Clients[source->Fd];
-                error = client->Event(ev.events);
-                if (error) {
-                    Clients.erase(source->Fd);
-                    client->CloseConnection();
-                }
+            } else if (ClientEvent(*ClientShards[0], source->Fd, ev.events)) {
+                continue;
             } else {
                 L_WRN("Unknown event {}", source->Fd);
                 EpollLoop->RemoveSource(source->Fd);
@@ -484,7 +621,7 @@ static void PortodServer() {
         }
 
         if (ShutdownPortod) {
-            if (Clients.empty()) {
+            if (ClientsEmpty()) {
                 L_SYS("All clients are gone");
                 break;
             }
@@ -498,13 +635,33 @@ static void PortodServer() {
 
 exit:
 
-    for (auto c : Clients)
-        c.second->CloseConnection();
-    Clients.clear();
+    StopIoLoops = true;
+    uint64_t wake = 1;
+    if (write(wakeFd, &wake, sizeof(wake)) != sizeof(wake))
+        L_ERR("Cannot wakeup epoll loops: {}", TError::System("write"));
+    for (auto &thread: ioThreads)
+        thread->join();
+    ioThreads.clear();
+
+    for (auto &shard: ClientShards) {
+        for (auto c : shard->Clients)
+            c.second->CloseConnection();
+        shard->Clients.clear();
+    }
+    ClientShards.clear();
 
     L_SYS("Stop threads...");
+    StopSampler();
+    TStorage::StopTrashReaper();
+    TVolume::StopUsageRefresher();
+    TStdStream::StopFollower();
     EventQueue->Stop();
     StopRpcQueue();
+
+    for (auto &loop: IoLoops)
+        loop->Destroy();
+    IoLoops.clear();
+    close(wakeFd);
 }
 
 static TError TuneLimits() {
@@ -512,17 +669,20 @@ static TError TuneLimits() {
     TError error;
 
     /*
-     * two FDs for each container: OOM event and netlink
+     * four FDs for each container: OOM event, netlink, stdout and stderr
+     * plus cached cgroup knobs
      * ten for each thread
-     * one for each client
+     * one for each client plus followed streams
      * plus some extra
      */
-    int maxFd = config().container().max_total() * 2 +
-                NR_SUPERUSER_CONTAINERS * 2 +
+    int maxFd = (config().container().max_total() +
+                 NR_SUPERUSER_CONTAINERS) * (4 + CGROUP_KNOB_CACHE_MAX) +
                 (config().daemon().ro_threads() +
                  config().daemon().rw_threads() +
-                 config().daemon().io_threads()) * 10 +
-                config().daemon().max_clients() +
+                 config().daemon().io_threads() +
+                 config().daemon().event_threads()) * 10 +
+                config().daemon().max_clients() *
+                    (1 + config().daemon().max_follow_per_client()) +
                 NR_SUPERUSER_CLIENTS +
                 1000;
 
@@ -601,9 +761,25 @@ static TError CreateRootContainer() {
     return OK;
 }
 
+static void RestoreContainer(TKeyValue &node) {
+    std::shared_ptr<TContainer> ct;
+    TError error;
+
+    error = TContainer::Restore(node, ct);
+    if (error) {
+        L_ERR("Cannot restore {}: {}", node.Name, error);
+        Statistics->ContainerLost++;
+        node.Path.Unlink();
+    }
+}
+
 static void RestoreContainers() {
     TIdMap ids(4, CONTAINER_ID_MAX - 4);
     std::list<TKeyValue> nodes;
+    uint64_t start = GetCurrentTimeMs();
+
+    Statistics->RestoreNetworkUs = 0;
+    Statistics->RestoreCgroupsUs = 0;
 
     TError error = TKeyValue::ListAll(ContainersKV, nodes);
     if (error)
@@ -647,19 +823,78 @@ static void RestoreContainers() {
 
     nodes.sort();
 
+    Statistics->RestoreKeyValueMs = GetCurrentTimeMs() - start;
+
+    /*
+     * Container is queued when its parent is restored (or failed),
+     * siblings and independent subtrees are restored in parallel.
+     */
+    std::map<TString, std::vector<TKeyValue *>> childs;
+    std::deque<TKeyValue *> queue;
+    std::set<TString> names;
+
+    for (auto &node : nodes)
+        names.insert(node.Name);
+
     for (auto &node : nodes) {
         if (node.Name[0] == '/')
             continue;
+        auto parent = TContainer::ParentName(node.Name);
+        if (parent == ROOT_CONTAINER || !names.count(parent))
+            queue.push_back(&node);
+        else
+            childs[parent].push_back(&node);
+    }
 
-        std::shared_ptr<TContainer> ct;
-        error = TContainer::Restore(node, ct);
-        if (error) {
-            L_ERR("Cannot restore {}: {}", node.Name, error);
-            Statistics->ContainerLost++;
-            node.Path.Unlink();
-            continue;
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned running = 0;
+
+    auto worker = [&]() {
+        TClient client("<restore>");
+        client.ClientContainer = RootContainer;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cv.wait(lock, [&]{ return !queue.empty() || !running; });
+            if (queue.empty())
+                break;
+            auto node = queue.front();
+            queue.pop_front();
+            running++;
+            lock.unlock();
+
+            client.StartRequest();
+            RestoreContainer(*node);
+            client.FinishRequest();
+
+            lock.lock();
+            running--;
+            auto it = childs.find(node->Name);
+            if (it != childs.end()) {
+                queue.insert(queue.end(), it->second.begin(), it->second.end());
+                childs.erase(it);
+            }
+            cv.notify_all();
         }
-    }
+    };
+
+    unsigned nr_threads = std::max(config().daemon().restore_threads(), 1u);
+    std::vector<std::thread> threads;
+
+    for (unsigned i = 0; i < nr_threads; i++)
+        threads.emplace_back(worker);
+
+    for (auto &thread: threads)
+        thread.join();
+
+    Statistics->RestoreContainersMs = GetCurrentTimeMs() - start;
+
+    L_SYS("Restored containers in {} ms, threads={} keyvalue={} ms network={} ms cgroups={} ms",
+          (uint64_t)Statistics->RestoreContainersMs, nr_threads,
+          (uint64_t)Statistics->RestoreKeyValueMs,
+          Statistics->RestoreNetworkUs / 1000,
+          Statistics->RestoreCgroupsUs / 1000);
 }
 
 static void CleanupCgroups() {
@@ -868,6 +1103,7 @@ static int Portod() {
     error = EpollLoop->Create();
     if (error)
         FatalError("Cannot initialize epoll", error);
+    Statistics->EpollSources = 0;
 
     TPath tmp_dir(PORTO_WORKDIR);
     if (!tmp_dir.IsDirectoryFollow()) {
@@ -879,6 +1115,8 @@ static int Portod() {
 
     SystemClient.StartRequest();
 
+    ChangeLog.Init();
+
     error = CreateRootContainer();
     if (error)
         FatalError("Cannot create root container", error);
@@ -892,7 +1130,9 @@ static int Portod() {
     TContainer::SyncPropertiesAll();
 
     L_SYS("Restore volumes...");
+    uint64_t volumes_start = GetCurrentTimeMs();
     TVolume::RestoreAll();
+    Statistics->RestoreVolumesMs = GetCurrentTimeMs() - volumes_start;
 
     DestroyContainers(true);
 
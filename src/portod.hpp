@@ -1,9 +1,13 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 class TEpollLoop;
 class TEventQueue;
 
 extern std::unique_ptr<TEpollLoop> EpollLoop;
+extern std::vector<std::unique_ptr<TEpollLoop>> IoLoops;
 extern std::unique_ptr<TEventQueue> EventQueue;
 
 extern TString PreviousVersion;
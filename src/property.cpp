@@ -6,12 +6,17 @@
 #include "container.hpp"
 #include "volume.hpp"
 #include "network.hpp"
+#include "epoll.hpp"
+#include "portod.hpp"
+#include "event.hpp"
+#include "rpc.hpp"
 #include "util/log.hpp"
 #include "util/string.hpp"
 #include "util/unix.hpp"
 #include "util/proc.hpp"
 #include "util/cred.hpp"
 #include <sstream>
+#include <type_traits>
 
 extern "C" {
 #include <sys/sysinfo.h>
@@ -55,6 +60,22 @@ TError TProperty::Load(const rpc::TContainerSpec &) {
 void TProperty::Dump(rpc::TContainerSpec &) {
 }
 
+TError TProperty::GetStat(rpc::TContainerStat &stat) {
+    TString value;
+    TError error = Get(value);
+    if (!error)
+        stat.set_string_value(value);
+    return error;
+}
+
+static void DumpStatMap(const TUintMap &map, rpc::TUintMap &dump) {
+    for (auto &it: map) {
+        auto kv = dump.add_map();
+        kv->set_key(it.first);
+        kv->set_val(it.second);
+    }
+}
+
 TString TProperty::GetDesc() const {
     auto desc = Desc;
     if (IsReadOnly)
@@ -158,6 +179,10 @@ public:
             return error;
         return Set(val);
     }
+    TError GetStat(rpc::TContainerStat &stat) {
+        DumpStatMap(Get(), *stat.mutable_map_value());
+        return OK;
+    }
     void DumpMap(rpc::TUintMap *dump) {
         for (auto &it: Get()) {
             auto kv = dump->add_map();
@@ -243,6 +268,15 @@ public:
         if (!Get(value))
             Dump(spec, value);
     }
+    TError GetStat(rpc::TContainerStat &stat) {
+        if (!std::is_same<T, uint64_t>::value)
+            return TProperty::GetStat(stat);
+        T value;
+        TError error = Get(value);
+        if (!error)
+            stat.set_uint_value(value);
+        return error;
+    }
     virtual bool Has(const rpc::TContainerSpec &) {
         return false;
     }
@@ -3517,6 +3551,8 @@ public:
     TError Set(int64_t val) {
         CT->AgingTime = val * 1000;
         CT->SetProp(EProperty::AGING_TIME);
+        if (CT->State == EContainerState::Dead)
+            CT->ScheduleAging();
         return OK;
     }
     void Dump(rpc::TContainerSpec &spec, int64_t val) {
@@ -4183,6 +4219,13 @@ public:
         value = std::to_string(it->second);
         return OK;
     }
+    TError GetStat(rpc::TContainerStat &stat) {
+        TVmStat st;
+        TError error = CT->GetVmStat(st);
+        if (!error)
+            DumpStatMap(st.Stat, *stat.mutable_map_value());
+        return error;
+    }
     void Dump(rpc::TContainerSpec &spec) {
         TVmStat st;
         if (CT->GetVmStat(st))
@@ -4541,8 +4584,7 @@ public:
         return TError(EError::ResourceNotAvailable, "Shared network");
     }
 
-    TError Get(TString &value) {
-        TUintMap stat;
+    void GetMap(TUintMap &stat) {
         auto lock = TNetwork::LockNetState();
         if (ClassStat) {
             for (auto &it : CT->NetClass.Fold->ClassStat)
@@ -4551,9 +4593,21 @@ public:
             for (auto &it: CT->Net->DeviceStat)
                 stat[it.first] = &it.second->*Member;
         }
+    }
+
+    TError Get(TString &value) {
+        TUintMap stat;
+        GetMap(stat);
         return UintMapToString(stat, value);
     }
 
+    TError GetStat(rpc::TContainerStat &value) {
+        TUintMap stat;
+        GetMap(stat);
+        DumpStatMap(stat, *value.mutable_map_value());
+        return OK;
+    }
+
     TError GetIndexed(const TString &index, TString &value) {
         auto lock = TNetwork::LockNetState();
         if (ClassStat) {
@@ -4598,21 +4652,8 @@ public:
         else
             return;
 
-        auto lock = TNetwork::LockNetState();
-        if (ClassStat) {
-            for (auto &it : CT->NetClass.Fold->ClassStat)
-                stat[it.first] = &it.second->*Member;
-        } else if (CT->Net) {
-            for (auto &it: CT->Net->DeviceStat)
-                stat[it.first] = &it.second->*Member;
-        }
-        lock.unlock();
-
-        for (auto &it: stat) {
-            auto kv = map->add_map();
-            kv->set_key(it.first);
-            kv->set_val(it.second);
-        }
+        GetMap(stat);
+        DumpStatMap(stat, *map);
     }
 };
 
@@ -4680,11 +4721,14 @@ public:
     void DumpMap(rpc::TUintMap &dump) {
         TUintMap map;
         GetMap(map);
-        for (auto &it: map) {
-            auto kv = dump.add_map();
-            kv->set_key(it.first);
-            kv->set_val(it.second);
-        }
+        DumpStatMap(map, dump);
+    }
+    TError GetStat(rpc::TContainerStat &stat) {
+        TUintMap map;
+        TError error = GetMap(map);
+        if (!error)
+            DumpStatMap(map, *stat.mutable_map_value());
+        return error;
     }
 };
 
@@ -4869,6 +4913,12 @@ public:
     void Populate(TUintMap &m);
     TError Get(TString &value);
     TError GetIndexed(const TString &index, TString &value);
+    TError GetStat(rpc::TContainerStat &stat) {
+        TUintMap m;
+        Populate(m);
+        DumpStatMap(m, *stat.mutable_map_value());
+        return OK;
+    }
     TPortoStat() : TProperty(P_PORTO_STAT, EProperty::NONE, "Porto statistics") {
         IsReadOnly = true;
         IsHidden = true;
@@ -4894,6 +4944,12 @@ void TPortoStat::Populate(TUintMap &m) {
     m["memory_usage_mb"] = usage / 1024 / 1024;
 
     m["epoll_sources"] = Statistics->EpollSources;
+    if (EpollLoop) {
+        m["epoll_loops"] = 1 + IoLoops.size();
+        m["epoll_loop0_events"] = EpollLoop->EventsCount;
+        for (unsigned i = 0; i < IoLoops.size(); i++)
+            m[fmt::format("epoll_loop{}_events", i + 1)] = IoLoops[i]->EventsCount;
+    }
 
     m["log_lines"] = Statistics->LogLines;
     m["log_bytes"] = Statistics->LogBytes;
@@ -4903,6 +4959,8 @@ void TPortoStat::Populate(TUintMap &m) {
 
     m["log_rotate_bytes"] = Statistics->LogRotateBytes;
     m["log_rotate_errors"] = Statistics->LogRotateErrors;
+    m["log_rotate_watched"] = Statistics->LogRotateWatched;
+    m["log_rotate_checks"] = Statistics->LogRotateChecks;
 
     m["containers"] = Statistics->ContainersCount - NR_SERVICE_CONTAINERS;
 
@@ -4920,6 +4978,20 @@ void TPortoStat::Populate(TUintMap &m) {
     m["layer_export"] = Statistics->LayerExport;
     m["layer_remove"] = Statistics->LayerRemove;
 
+    m["trash_queued"] = Statistics->TrashQueued;
+    m["trash_removed"] = Statistics->TrashRemoved;
+
+    m["loop_pool_hit"] = Statistics->LoopPoolHit;
+    m["loop_pool_miss"] = Statistics->LoopPoolMiss;
+    m["loop_pool_images"] = Statistics->LoopPoolImages;
+    m["layer_dedup_files"] = Statistics->LayerDedupFiles;
+    m["layer_dedup_bytes"] = Statistics->LayerDedupBytes;
+    m["layer_images_mounted"] = Statistics->LayerImagesMounted;
+    m["volume_usage_refreshes"] = Statistics->VolumeUsageRefreshes;
+    m["volume_usage_refresh_ms"] = Statistics->VolumeUsageRefreshMs;
+    m["stream_followers"] = Statistics->StreamFollowers;
+    m["stream_follow_bytes"] = Statistics->StreamFollowBytes;
+
     m["volumes"] = Statistics->VolumesCount;
     m["volumes_created"] = Statistics->VolumesCreated;
     m["volumes_failed"] = Statistics->VolumesFailed;
@@ -4936,6 +5008,22 @@ void TPortoStat::Populate(TUintMap &m) {
 
     m["clients"] = Statistics->ClientsCount;
     m["clients_connected"] = Statistics->ClientsConnected;
+    m["clients_recv_calls"] = Statistics->ClientRecvCalls;
+    m["clients_send_calls"] = Statistics->ClientSendCalls;
+
+    m["sampler_passes"] = Statistics->SamplerPasses;
+    m["sampler_time_ms"] = Statistics->SamplerTimeMs;
+
+    m["change_log_size"] = Statistics->ChangeLogSize;
+
+    m["keyvalue_appends"] = Statistics->KeyValueAppends;
+    m["keyvalue_rewrites"] = Statistics->KeyValueRewrites;
+
+    m["restore_containers_ms"] = Statistics->RestoreContainersMs;
+    m["restore_keyvalue_ms"] = Statistics->RestoreKeyValueMs;
+    m["restore_network_ms"] = Statistics->RestoreNetworkUs / 1000;
+    m["restore_cgroups_ms"] = Statistics->RestoreCgroupsUs / 1000;
+    m["restore_volumes_ms"] = Statistics->RestoreVolumesMs;
 
     m["container_clients"] = CT->ClientsCount;
     m["container_oom"] = CT->OomEvents;
@@ -4955,6 +5043,9 @@ void TPortoStat::Populate(TUintMap &m) {
     m["requests_longer_30s"] = Statistics->RequestsLonger30s;
     m["requests_longer_5m"] = Statistics->RequestsLonger5m;
     m["longest_read_request"] = Statistics->LongestRoRequest;
+
+    DumpIoQueueStat(m);
+    EventQueue->Dump(m);
 }
 
 TError TPortoStat::Get(TString &value) {
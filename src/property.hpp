@@ -283,6 +283,9 @@ public:
     virtual TError Load(const rpc::TContainerSpec &spec);
     virtual void Dump(rpc::TContainerSpec &spec);
 
+    /* Typed value for bulk statistics, string if not numeric */
+    virtual TError GetStat(rpc::TContainerStat &stat);
+
     virtual TError Start(void);
 };
 
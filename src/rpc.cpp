@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <queue>
+#include <set>
 
 #include "rpc.hpp"
 #include "client.hpp"
@@ -6,6 +8,9 @@
 #include "version.hpp"
 #include "property.hpp"
 #include "container.hpp"
+#include "cgroup.hpp"
+#include "sampler.hpp"
+#include "changelog.hpp"
 #include "volume.hpp"
 #include "waiter.hpp"
 #include "event.hpp"
@@ -46,7 +51,11 @@ void TRequest::Classify() {
         Req.has_locateprocess() ||
         Req.has_getsystem() ||
         Req.has_getcontainer() ||
-        Req.has_getvolume();
+        Req.has_getsamples() ||
+        Req.has_getstats() ||
+        Req.has_listchanges() ||
+        Req.has_getvolume() ||
+        Req.has_followstream();
 
     IoReq =
         Req.has_createvolume() ||
@@ -64,6 +73,53 @@ void TRequest::Classify() {
         Req.has_createmetastorage() ||
         Req.has_removemetastorage() ||
         Req.has_newvolume();
+
+    PlaceLoadReq =
+        Req.has_importlayer() ||
+        Req.has_exportlayer() ||
+        Req.has_removelayer() ||
+        Req.has_importstorage() ||
+        Req.has_exportstorage() ||
+        Req.has_removestorage();
+
+    IoPlace = "";
+
+    if (Req.has_importlayer())
+        IoPlace = Req.importlayer().place();
+    else if (Req.has_exportlayer())
+        IoPlace = Req.exportlayer().place();
+    else if (Req.has_removelayer())
+        IoPlace = Req.removelayer().place();
+    else if (Req.has_importstorage())
+        IoPlace = Req.importstorage().place();
+    else if (Req.has_exportstorage())
+        IoPlace = Req.exportstorage().place();
+    else if (Req.has_removestorage())
+        IoPlace = Req.removestorage().place();
+    else if (Req.has_createmetastorage())
+        IoPlace = Req.createmetastorage().place();
+    else if (Req.has_removemetastorage())
+        IoPlace = Req.removemetastorage().place();
+    else if (Req.has_newvolume())
+        IoPlace = Req.newvolume().volume().place();
+    else if (Req.has_createvolume()) {
+        for (auto &prop: Req.createvolume().properties())
+            if (prop.name() == V_PLACE)
+                IoPlace = prop.value();
+    }
+
+    /*
+     * Queue by place as handler resolves it, requests for places which
+     * are not permitted are queued at default place and fail in handler.
+     */
+    if (IoReq) {
+        TPath place = IoPlace;
+        if (Client->ClientContainer->ResolvePlace(place)) {
+            IoPlace = PORTO_PLACE;
+            PlaceLoadReq = false;
+        } else
+            IoPlace = place.ToString();
+    }
 }
 
 void TRequest::Parse() {
@@ -147,6 +203,15 @@ void TRequest::Parse() {
             opts.push_back(Req.asyncwait().name(i));
         if (Req.asyncwait().has_timeout_ms())
             opts.push_back(fmt::format("timeout={} ms", Req.asyncwait().timeout_ms()));
+    } else if (Req.has_followstream()) {
+        Cmd = "FollowStream";
+        Arg = Req.followstream().name();
+        if (Req.followstream().has_stream())
+            opts.push_back(Req.followstream().stream());
+        if (Req.followstream().has_offset())
+            opts.push_back(fmt::format("offset={}", Req.followstream().offset()));
+        if (Req.followstream().stop())
+            opts.push_back("stop");
     } else if (Req.has_propertylist() || Req.has_datalist()) {
         Cmd = "ListProperties";
     } else if (Req.has_kill()) {
@@ -305,6 +370,13 @@ void TRequest::Parse() {
         Opt = Req.setcontainer().ShortDebugString();
     } else if (Req.has_getcontainer()) {
         Cmd = "GetContainer";
+    } else if (Req.has_getsamples()) {
+        Cmd = "GetSamples";
+    } else if (Req.has_getstats()) {
+        Cmd = "GetStats";
+    } else if (Req.has_listchanges()) {
+        Cmd = "ListChanges";
+        Arg = std::to_string(Req.listchanges().since_gen());
     } else if (Req.has_getvolume()) {
         Cmd = "GetVolume";
     } else
@@ -469,10 +541,59 @@ noinline TError SetContainer(const rpc::TSetContainerRequest &req,
     return error;
 }
 
+/* Containers with any of labels "NAME" or "NAME=VALUE", name could be wildcard */
+template <typename T>
+static void SelectLabels(const T &selectors, std::set<TString> &selected) {
+    PORTO_LOCKED(ContainersMutex);
+
+    for (auto &sel: selectors) {
+        std::vector<std::pair<TContainer *, TString>> found;
+        auto sep = sel.find('=');
+        if (sep == TString::npos)
+            TContainer::FindLabel(sel, "", found);
+        else
+            TContainer::FindLabel(sel.substr(0, sep), sel.substr(sep + 1), found);
+        for (auto &it: found)
+            selected.insert(it.first->Name);
+    }
+}
+
+/* Visible container names matching any of masks, only labeled if selectors are set */
+template <typename T>
+static void ExpandMasks(const std::list<TString> &masks, const T &labels, bool root,
+                        std::set<TString> &selected, std::list<TString> &names) {
+    auto lock = LockContainers();
+
+    auto match = [&](const TContainer &ct) {
+        TString name;
+        if ((ct.IsRoot() && !root) || CL->ComposeName(ct.Name, name))
+            return;
+        for (auto &mask: masks) {
+            if (StringMatch(name, mask)) {
+                names.push_back(name);
+                break;
+            }
+        }
+    };
+
+    if (labels.size()) {
+        SelectLabels(labels, selected);
+        for (auto &name: selected) {
+            auto it = Containers.find(name);
+            if (it != Containers.end())
+                match(*it->second);
+        }
+    } else {
+        for (auto &it: Containers)
+            match(*it.second);
+    }
+}
+
 noinline TError GetContainer(const rpc::TGetContainerRequest &req,
                              rpc::TGetContainerResponse &rsp) {
     std::list<TString> masks, names;
     std::vector<TString> props;
+    std::set<TString> labeled;
     TError error;
 
     for(auto &prop: req.property())
@@ -489,21 +610,10 @@ noinline TError GetContainer(const rpc::TGetContainerRequest &req,
         masks.push_back("***");
 
     if (!masks.empty()) {
+        ExpandMasks(masks, req.label(), true, labeled, names);
+    } else if (req.label_size()) {
         auto lock = LockContainers();
-        for (auto &it: Containers) {
-            auto &ct = it.second;
-            TString name;
-            if (CL->ComposeName(ct->Name, name))
-                continue;
-            if (masks.empty())
-                names.push_back(name);
-            for (auto &mask: masks) {
-                if (StringMatch(name, mask)) {
-                    names.push_back(name);
-                    break;
-                }
-            }
-        }
+        SelectLabels(req.label(), labeled);
     }
 
     for (auto &name: names) {
@@ -513,24 +623,8 @@ noinline TError GetContainer(const rpc::TGetContainerRequest &req,
 
         error = CL->ResolveContainer(name, ct);
 
-        if (!error && req.label_size()) {
-            bool match = false;
-            for (auto &label: req.label()) {
-                if (label.find_first_of("*?") == TString::npos) {
-                    match = ct->Labels.find(label) != ct->Labels.end();
-                } else {
-                    for (auto &it: ct->Labels) {
-                        match = StringMatch(it.first, label);
-                        if (match)
-                            break;
-                    }
-                }
-                if (match)
-                    break;
-            }
-            if (!match)
-                continue;
-        }
+        if (!error && req.label_size() && !labeled.count(ct->Name))
+            continue;
 
         lock.unlock();
 
@@ -558,6 +652,141 @@ noinline TError GetContainer(const rpc::TGetContainerRequest &req,
     return OK;
 }
 
+/* Expand wildcards, empty list means all visible containers */
+template <typename T>
+static std::list<TString> ExpandContainerNames(const T &list) {
+    std::list<TString> names;
+
+    for (auto &name: list) {
+        if (name.find_first_of("*?") == TString::npos) {
+            names.push_back(name);
+            continue;
+        }
+        auto lock = LockContainers();
+        for (auto &it: Containers) {
+            TString ct_name;
+            if (!CL->ComposeName(it.second->Name, ct_name) &&
+                    StringMatch(ct_name, name))
+                names.push_back(ct_name);
+        }
+    }
+
+    if (list.empty()) {
+        auto lock = LockContainers();
+        for (auto &it: Containers) {
+            TString ct_name;
+            if (!CL->ComposeName(it.second->Name, ct_name))
+                names.push_back(ct_name);
+        }
+    }
+
+    return names;
+}
+
+noinline TError GetStats(const rpc::TGetStatsRequest &req,
+                         rpc::TGetStatsResponse &rsp) {
+    auto names = ExpandContainerNames(req.name());
+    TError error;
+
+    if (!req.property_size())
+        return TError(EError::InvalidValue, "No properties requested");
+
+    for (auto &name: names) {
+        std::shared_ptr<TContainer> ct;
+
+        error = CL->ResolveContainer(name, ct);
+        if (error && req.name_size() == 1 && names.size() == 1)
+            return error;
+
+        auto stats = rsp.add_container();
+        stats->set_name(name);
+        if (error) {
+            error.Dump(*stats->mutable_error());
+            continue;
+        }
+
+        ct->LockStateRead();
+
+        /* Read each cgroup knob once for all properties */
+        TCgroupCollector collector(ct->GetKnobCache());
+
+        for (auto &prop: req.property()) {
+            auto stat = stats->add_stat();
+            error = ct->GetStat(prop, *stat);
+            if (error) {
+                stat->Clear();
+                error.Dump(*stat->mutable_error());
+            }
+        }
+
+        ct->UnlockState();
+    }
+
+    return OK;
+}
+
+noinline TError ListChanges(const rpc::TListChangesRequest &req,
+                            rpc::TListChangesResponse &rsp) {
+    uint64_t generation;
+
+    /* Called under change log lock, must not take other locks */
+    auto add = [&](EChangeKind kind, const TString &name, uint64_t gen, bool removed) {
+        rpc::TChangedObject *obj;
+        TString client_name;
+
+        if (kind == EChangeKind::Container) {
+            if (CL->ComposeName(name, client_name))
+                return;
+            obj = rsp.add_container();
+        } else {
+            client_name = CL->ComposePath(name).ToString();
+            if (client_name.empty())
+                return;
+            obj = rsp.add_volume();
+        }
+
+        obj->set_name(client_name);
+        obj->set_generation(gen);
+        if (removed)
+            obj->set_removed(true);
+    };
+
+    if (!ChangeLog.Collect(req.since_gen(), generation, add))
+        rsp.set_full(true);
+
+    rsp.set_generation(generation);
+
+    return OK;
+}
+
+noinline TError GetSamples(const rpc::TGetSamplesRequest &req,
+                           rpc::TGetSamplesResponse &rsp) {
+    auto names = ExpandContainerNames(req.name());
+    TError error;
+
+    if (!config().daemon().sampler_interval_ms())
+        return TError(EError::NotSupported, "Sampler is disabled");
+
+    for (auto &name: names) {
+        std::shared_ptr<TContainer> ct;
+
+        error = CL->ResolveContainer(name, ct);
+        if (error && req.name_size() == 1 && names.size() == 1)
+            return error;
+
+        auto samples = rsp.add_container();
+        samples->set_name(name);
+        if (error)
+            error.Dump(*samples->mutable_error());
+        else
+            DumpSamples(ct->Name, req.count(), *samples);
+    }
+
+    rsp.set_interval_ms(config().daemon().sampler_interval_ms());
+
+    return OK;
+}
+
 static noinline TError CreateContainer(TString reqName, bool weak) {
     TString name;
     TError error = CL->ResolveName(reqName, name);
@@ -646,18 +875,30 @@ noinline TError ListContainers(const rpc::TContainerListRequest &req,
                                rpc::TPortoResponse &rsp) {
     TString mask = req.has_mask() ? req.mask() : "***";
     auto out = rsp.mutable_list();
+    std::set<TString> labeled;
 
     auto lock = LockContainers();
 
-    for (auto &it: Containers) {
-        auto &ct = it.second;
+    auto list = [&](const TContainer &ct) {
         TString name;
-        if (ct->IsRoot() || CL->ComposeName(ct->Name, name) ||
+        if (ct.IsRoot() || CL->ComposeName(ct.Name, name) ||
                 !StringMatch(name, mask))
-            continue;
-        if (req.has_changed_since() && ct->ChangeTime < req.changed_since())
-            continue;
+            return;
+        if (req.has_changed_since() && ct.ChangeTime < req.changed_since())
+            return;
         out->add_name(name);
+    };
+
+    if (req.label_size()) {
+        SelectLabels(req.label(), labeled);
+        for (auto &name: labeled) {
+            auto it = Containers.find(name);
+            if (it != Containers.end())
+                list(*it->second);
+        }
+    } else {
+        for (auto &it: Containers)
+            list(*it.second);
     }
 
     out->set_absolute_namespace(ROOT_PORTO_NAMESPACE + CL->PortoNamespace);
@@ -667,11 +908,19 @@ noinline TError ListContainers(const rpc::TContainerListRequest &req,
 
 noinline TError FindLabel(const rpc::TFindLabelRequest &req, rpc::TFindLabelResponse &rsp) {
     auto label = req.label();
-    bool wild_label = label.find_first_of("*?") != TString::npos;
+    std::vector<std::pair<TContainer *, TString>> found;
 
     auto lock = LockContainers();
-    for (auto &it: Containers) {
-        auto &ct = it.second;
+
+    /* ".LABEL" is inherited from parents, it is not indexed */
+    if (StringStartsWith(label, ".")) {
+        for (auto &it: Containers)
+            found.emplace_back(it.second.get(), label);
+    } else
+        TContainer::FindLabel(label, req.has_value() ? req.value() : "", found);
+
+    for (auto &it: found) {
+        auto ct = it.first;
         TString value;
         TString name;
 
@@ -685,25 +934,15 @@ noinline TError FindLabel(const rpc::TFindLabelRequest &req, rpc::TFindLabelResp
         if (req.has_mask() && !StringMatch(name, req.mask()))
             continue;
 
-        if (wild_label) {
-            for (auto &it: ct->Labels) {
-                if (StringMatch(it.first, label) &&
-                        (!req.has_value() || it.second == req.value())) {
-                    auto l = rsp.add_list();
-                    l->set_name(name);
-                    l->set_state(TContainer::StateName(ct->State));
-                    l->set_label(it.first);
-                    l->set_value(it.second);
-                }
-            }
-        } else if (!ct->GetLabel(label, value) &&
-                (!req.has_value() || value == req.value())) {
-            auto l = rsp.add_list();
-            l->set_name(name);
-            l->set_state(TContainer::StateName(ct->State));
-            l->set_label(label);
-            l->set_value(value);
-        }
+        if (ct->GetLabel(it.second, value) ||
+                (req.has_value() && value != req.value()))
+            continue;
+
+        auto l = rsp.add_list();
+        l->set_name(name);
+        l->set_state(TContainer::StateName(ct->State));
+        l->set_label(it.second);
+        l->set_value(value);
     }
 
     return OK;
@@ -790,7 +1029,10 @@ noinline TError GetContainerProperty(const rpc::TContainerGetPropertyRequest &re
         if (req.has_sync() && req.sync())
             ct->SyncProperty(req.property());
 
-        error = ct->GetProperty(req.property(), value);
+        {
+            TCgroupCollector collector(ct->GetKnobCache());
+            error = ct->GetProperty(req.property(), value);
+        }
         if (!error)
             rsp.mutable_getproperty()->set_value(value);
 out:
@@ -853,7 +1095,10 @@ noinline TError GetContainerData(const rpc::TContainerGetDataRequest &req,
         if (req.has_sync() && req.sync())
             ct->SyncProperty(req.data());
 
-        error = ct->GetProperty(req.data(), value);
+        {
+            TCgroupCollector collector(ct->GetKnobCache());
+            error = ct->GetProperty(req.data(), value);
+        }
         if (!error)
             rsp.mutable_getdata()->set_value(value);
 out:
@@ -866,10 +1111,9 @@ static void FillGetResponse(const rpc::TContainerGetRequest &req,
                             rpc::TContainerGetResponse &rsp,
                             TString &name) {
     std::shared_ptr<TContainer> ct;
+    std::unique_ptr<TCgroupCollector> collector;
 
-    auto lock = LockContainers();
     TError containerError = CL->ResolveContainer(name, ct);
-    lock.unlock();
 
     auto entry = rsp.add_list();
     entry->set_name(name);
@@ -877,6 +1121,9 @@ static void FillGetResponse(const rpc::TContainerGetRequest &req,
     if (!containerError) {
         ct->LockStateRead();
 
+        /* Read each cgroup knob once for all properties */
+        collector.reset(new TCgroupCollector(ct->GetKnobCache()));
+
         entry->set_change_time(ct->ChangeTime);
 
         if (req.has_changed_since() && ct->ChangeTime < req.changed_since()) {
@@ -907,6 +1154,7 @@ static void FillGetResponse(const rpc::TContainerGetRequest &req,
     }
 
 out:
+    collector.reset();
     if (!containerError)
         ct->UnlockState();
 }
@@ -915,6 +1163,7 @@ noinline TError GetContainerCombined(const rpc::TContainerGetRequest &req,
                                      rpc::TPortoResponse &rsp) {
     auto get = rsp.mutable_get();
     std::list <TString> masks, names;
+    std::set<TString> labeled;
 
     for (int i = 0; i < req.name_size(); i++) {
         auto name = req.name(i);
@@ -924,22 +1173,21 @@ noinline TError GetContainerCombined(const rpc::TContainerGetRequest &req,
             masks.push_back(name);
     }
 
-    if (!masks.empty()) {
+    /* label selection without names means all labeled containers */
+    if (req.label_size() && names.empty() && masks.empty())
+        masks.push_back("***");
+
+    if (!masks.empty())
+        ExpandMasks(masks, req.label(), false, labeled, names);
+
+    if (req.label_size()) {
         auto lock = LockContainers();
-        for (auto &it: Containers) {
-            auto &ct = it.second;
-            TString name;
-            if (ct->IsRoot() || CL->ComposeName(ct->Name, name))
-                continue;
-            if (masks.empty())
-                names.push_back(name);
-            for (auto &mask: masks) {
-                if (StringMatch(name, mask)) {
-                    names.push_back(name);
-                    break;
-                }
-            }
-        }
+        if (labeled.empty())
+            SelectLabels(req.label(), labeled);
+        names.remove_if([&](const TString &name) {
+            TString full_name;
+            return CL->ResolveName(name, full_name) || !labeled.count(full_name);
+        });
     }
 
     if (req.has_sync() && req.sync())
@@ -1003,18 +1251,23 @@ noinline TError Version(rpc::TPortoResponse &rsp) {
 }
 
 noinline TError WaitContainers(const rpc::TContainerWaitRequest &req, bool async,
-        rpc::TPortoResponse &rsp, std::shared_ptr<TClient> &client) {
+        rpc::TPortoResponse &rsp, std::shared_ptr<TClient> &client, uint64_t tag) {
     TString name, full_name;
     TError error;
 
-    if (!req.name_size() && !async)
+    if (!req.name_size() && !req.volume_size() && !async)
         return TError(EError::InvalidValue, "Containers to wait are not set");
 
     auto waiter = std::make_shared<TContainerWaiter>(async);
 
+    waiter->Tag = tag;
+
     for (auto &label: req.label())
         waiter->Labels.push_back(label);
 
+    for (auto &path: req.volume())
+        waiter->Volumes.push_back(path);
+
     auto lock = LockContainers();
 
     for (int i = 0; i < req.name_size(); i++) {
@@ -1051,13 +1304,13 @@ noinline TError WaitContainers(const rpc::TContainerWaitRequest &req, bool async
             continue;
 
         if (waiter->Labels.empty()) {
-            client->MakeReport(name, TContainer::StateName(ct->State), async);
+            client->MakeReport(name, TContainer::StateName(ct->State), async, "", "", tag);
             if (!async)
                 return TError::Queued();
         } else {
             for (auto &it: ct->Labels) {
                 if (waiter->ShouldReportLabel(it.first)) {
-                    client->MakeReport(name, TContainer::StateName(ct->State), async, it.first, it.second);
+                    client->MakeReport(name, TContainer::StateName(ct->State), async, it.first, it.second, tag);
                     if (!async)
                         return TError::Queued();
                 }
@@ -1072,13 +1325,13 @@ noinline TError WaitContainers(const rpc::TContainerWaitRequest &req, bool async
                 continue;
 
             if (waiter->Labels.empty()) {
-                client->MakeReport(name, TContainer::StateName(ct->State), async);
+                client->MakeReport(name, TContainer::StateName(ct->State), async, "", "", tag);
                 if (!async)
                     return TError::Queued();
             } else {
                 for (auto &it: ct->Labels) {
                     if (waiter->ShouldReportLabel(it.first)) {
-                        client->MakeReport(name, TContainer::StateName(ct->State), async, it.first, it.second);
+                        client->MakeReport(name, TContainer::StateName(ct->State), async, it.first, it.second, tag);
                         if (!async)
                             return TError::Queued();
                     }
@@ -1087,10 +1340,36 @@ noinline TError WaitContainers(const rpc::TContainerWaitRequest &req, bool async
         }
     }
 
+    /*
+     * Container and volume states are reported under ContainersMutex and
+     * VolumesMutex, keep both till activation to not miss changes.
+     * VolumesMutex nests inside ContainersMutex.
+     */
+    std::unique_lock<std::mutex> volumes_lock;
+
+    if (!waiter->Volumes.empty()) {
+        volumes_lock = LockVolumes();
+
+        for (auto &it: Volumes) {
+            auto &volume = it.second;
+            TPath path = volume->ComposePathLocked(*client->ClientContainer);
+            auto state = TVolume::StateName(volume->State);
+
+            if (!path || !waiter->ShouldReportVolume(path.ToString(), state))
+                continue;
+
+            client->MakeReport(path.ToString(), state, async, "", "", tag);
+            if (!async)
+                return TError::Queued();
+        }
+    }
+
     if (req.has_timeout_ms() && req.timeout_ms() == 0) {
-        client->MakeReport("", "timeout", async);
+        client->MakeReport("", "timeout", async, "", "", tag);
     } else {
-        waiter->Activate(client);
+        error = waiter->Activate(client);
+        if (error)
+            return error;
         if (req.timeout_ms()) {
             TEvent e(EEventType::WaitTimeout, nullptr);
             e.WaitTimeout.Waiter = waiter;
@@ -1101,6 +1380,43 @@ noinline TError WaitContainers(const rpc::TContainerWaitRequest &req, bool async
     return async ? OK : TError::Queued();
 }
 
+noinline TError FollowStream(const rpc::TFollowStreamRequest &req,
+                             std::shared_ptr<TClient> &client,
+                             bool has_tag, uint64_t tag) {
+    std::shared_ptr<TContainer> ct;
+    TError error;
+
+    error = CL->ReadContainer(req.name(), ct);
+    if (error)
+        return error;
+
+    int stream;
+    if (!req.has_stream() || req.stream() == "stdout")
+        stream = 1;
+    else if (req.stream() == "stderr")
+        stream = 2;
+    else
+        return TError(EError::InvalidValue, "Unknown stream {}", req.stream());
+
+    TString name = CL->RelativeName(ct->Name);
+
+    if (req.stop()) {
+        TStdStream::Unfollow(*client, name, stream);
+        return OK;
+    }
+
+    /* stream messages interleave with responses, client must match them by tag */
+    if (!client->Pipelined || !has_tag)
+        return TError(EError::InvalidValue, "FollowStream requires pipelined request with tag");
+
+    uint64_t chunk = req.chunk_size() ?: 65536;
+    if (chunk > config().daemon().max_msg_len() / 2)
+        return TError(EError::InvalidValue, "Too big chunk size {}", chunk);
+
+    auto &std_stream = stream == 1 ? ct->Stdout : ct->Stderr;
+    return std_stream.Follow(ct, client, name, req.has_offset(), req.offset(), chunk, tag);
+}
+
 noinline TError ConvertPath(const rpc::TConvertPathRequest &req,
                             rpc::TPortoResponse &rsp) {
     std::shared_ptr<TContainer> src, dst;
@@ -1166,7 +1482,7 @@ noinline TError CreateVolume(const rpc::TVolumeCreateRequest &req,
     if (error)
         goto err;
 
-    error = TVolume::Create(spec, volume);
+    error = TVolume::Create(spec, volume, req.async_build());
     if (error)
         goto err;
 
@@ -1225,7 +1541,15 @@ noinline TError UnlinkVolume(const rpc::TVolumeUnlinkRequest &req) {
     if (error)
         return error;
 
-    if (ct) {
+    /* Unlink of volume in asynchronous build cancels it */
+    auto volumes_lock = LockVolumes();
+    bool building = volume->AsyncBuild;
+    volumes_lock.unlock();
+
+    if (building) {
+        CL->ReleaseContainer();
+        error = volume->Destroy();
+    } else if (ct) {
         std::list<std::shared_ptr<TVolume>> unlinked;
         error = volume->UnlinkVolume(ct, req.has_target() ? req.target() : "***", unlinked, req.strict());
         CL->ReleaseContainer();
@@ -1251,7 +1575,7 @@ noinline TError ListVolumes(const rpc::TVolumeListRequest &req,
             entry->set_change_time(link->Volume->ChangeTime);
             entry->set_no_changes(true);
         } else
-            link->Volume->DumpDescription(link.get(), req.path(), entry);
+            link->Volume->DumpDescription(link.get(), req.path(), entry, req.sync());
         return OK;
     }
 
@@ -1283,7 +1607,7 @@ noinline TError ListVolumes(const rpc::TVolumeListRequest &req,
             entry->set_change_time(volume->ChangeTime);
             entry->set_no_changes(true);
         } else
-            volume->DumpDescription(it.second.get(), it.first, entry);
+            volume->DumpDescription(it.second.get(), it.first, entry, req.sync());
     }
 
     return OK;
@@ -1294,7 +1618,7 @@ noinline TError NewVolume(const rpc::TNewVolumeRequest &req,
     Statistics->VolumesCreated++;
 
     std::shared_ptr<TVolume> volume;
-    TError error = TVolume::Create(req.volume(), volume);
+    TError error = TVolume::Create(req.volume(), volume, req.async_build());
     if (error) {
         Statistics->VolumesFailed++;
         return error;
@@ -1331,7 +1655,7 @@ noinline TError GetVolume(const rpc::TGetVolumeRequest &req,
                 spec->set_change_time(volume->ChangeTime);
                 spec->set_no_changes(true);
             } else
-                volume->Dump(*spec);
+                volume->Dump(*spec, false, req.sync());
             spec->set_path(path);
             spec->set_container(ct_name);
         } else if (req.path().size() == 1)
@@ -1356,7 +1680,7 @@ noinline TError GetVolume(const rpc::TGetVolumeRequest &req,
                 spec->set_change_time(volume->ChangeTime);
                 spec->set_no_changes(true);
             } else
-                volume->Dump(*spec);
+                volume->Dump(*spec, false, req.sync());
             spec->set_path(it.first.ToString());
             spec->set_container(ct_name);
         }
@@ -1483,6 +1807,27 @@ noinline TError ListLayers(const rpc::TLayerListRequest &req,
         desc->set_last_usage(layer.LastUsage());
     }
 
+    uint64_t dedup_files, dedup_bytes;
+    TStorage::GetContentUsage(place.Place, dedup_files, dedup_bytes);
+    if (dedup_files) {
+        list->set_dedup_files(dedup_files);
+        list->set_dedup_bytes(dedup_bytes);
+    }
+
+    std::list<TImportProgress> imports;
+    TStorage::ListImports(place.Place, imports);
+    for (auto &import: imports) {
+        if (req.has_mask() && !StringMatch(import.Name, req.mask()))
+            continue;
+        auto progress = list->add_importing();
+        progress->set_layer(import.Name);
+        progress->set_archive_size(import.ArchiveSize);
+        progress->set_archive_read(import.ArchiveRead);
+        progress->set_entries(import.Entries);
+        progress->set_bytes(import.Bytes);
+        progress->set_time_ms(import.TimeMs);
+    }
+
     return error;
 }
 
@@ -1845,6 +2190,10 @@ TError TRequest::Check() {
     std::vector<const google::protobuf::FieldDescriptor *> req_fields;
     req_ref->ListFields(Req, &req_fields);
 
+    /* tag is not a method, fields are sorted by number */
+    if (Req.has_tag())
+        req_fields.pop_back();
+
     if (req_fields.size() != 1)
         return TError(EError::InvalidMethod, "Request has {} known methods", req_fields.size());
 
@@ -1889,6 +2238,12 @@ void TRequest::Handle() {
         error = SetContainer(Req.setcontainer(), *rsp.mutable_setcontainer());
     else if (Req.has_getcontainer())
         error = GetContainer(Req.getcontainer(), *rsp.mutable_getcontainer());
+    else if (Req.has_getsamples())
+        error = GetSamples(Req.getsamples(), *rsp.mutable_getsamples());
+    else if (Req.has_getstats())
+        error = GetStats(Req.getstats(), *rsp.mutable_getstats());
+    else if (Req.has_listchanges())
+        error = ListChanges(Req.listchanges(), *rsp.mutable_listchanges());
     else if (Req.has_create())
         error = CreateContainer(Req.create().name(), false);
     else if (Req.has_createweak())
@@ -1924,9 +2279,11 @@ void TRequest::Handle() {
     else if (Req.has_version())
         error = Version(rsp);
     else if (Req.has_wait())
-        error = WaitContainers(Req.wait(), false, rsp, Client);
+        error = WaitContainers(Req.wait(), false, rsp, Client, Req.tag());
     else if (Req.has_asyncwait())
-        error = WaitContainers(Req.asyncwait(), true, rsp, Client);
+        error = WaitContainers(Req.asyncwait(), true, rsp, Client, Req.tag());
+    else if (Req.has_followstream())
+        error = FollowStream(Req.followstream(), Client, Req.has_tag(), Req.tag());
     else if (Req.has_listvolumeproperties())
         error = ListVolumeProperties(rsp);
     else if (Req.has_createvolume())
@@ -1997,7 +2354,7 @@ void TRequest::Handle() {
         error = TError(EError::InvalidMethod, "invalid RPC method");
 
     FinishTime = GetCurrentTimeMs();
-    Client->FinishRequest();
+    Client->FinishRequest(!RoReq || !Client->Pipelined);
 
     Statistics->RequestsCompleted++;
     Statistics->RequestsQueued--;
@@ -2043,6 +2400,8 @@ void TRequest::Handle() {
     rsp.set_error(error.Error);
     rsp.set_errormsg(error.Message());
     rsp.set_timestamp(timestamp);
+    if (Req.has_tag())
+        rsp.set_tag(Req.tag());
 
     if (!RoReq || Verbose) {
         L_RSP("{} {} {} to {} time={}+{} ms", Cmd, Arg, ResponseAsString(rsp),
@@ -2057,10 +2416,10 @@ void TRequest::Handle() {
     L_DBG("Raw response: {}", rsp.ShortDebugString());
 
     auto lock = Client->Lock();
-    Client->Processing = false;
+    Client->CompleteRequest(!RoReq);
     error = Client->QueueResponse(rsp);
-    if (!error && !Client->Sending)
-        error = Client->SendResponse(true);
+    if (!error)
+        error = Client->Sending ? Client->UpdateEvents() : Client->SendResponse(true);
     if (error)
         L_WRN("Cannot send response for {} : {}", Client->Id, error);
 }
@@ -2118,9 +2477,254 @@ public:
     }
 };
 
+/*
+ * IO requests are queued per place and served round-robin between places
+ * and between clients of each place. Single place never gets more than
+ * io_place_threads. Requests which take place load slot (import, export,
+ * remove) stay in queue until slot is free rather than block IO thread
+ * in TStorage::IncPlaceLoad. Jobs started by client request (async volume
+ * build) are queued as its requests. Background tasks run when no request
+ * is ready.
+ */
+
+class TIoScheduler {
+    static constexpr int HIST_SIZE = 6;
+    const uint64_t DepthBuckets[HIST_SIZE] = { 0, 1, 4, 16, 64, UINT64_MAX };
+    const uint64_t WaitBuckets[HIST_SIZE] = { 1, 10, 100, 1000, 10000, UINT64_MAX };
+
+    struct TItem {
+        std::unique_ptr<TRequest> Request;
+        std::function<void()> Task;     /* background or client job */
+        uint64_t QueueTime;
+    };
+
+    struct TPlace {
+        std::deque<const TClient *> Order;     /* clients with queued requests */
+        std::map<const TClient *, std::deque<TItem>> Requests;
+        std::deque<TItem> Tasks;
+        uint64_t Queued = 0;
+        unsigned Running = 0;
+        uint64_t Completed = 0;
+        uint64_t DepthHist[HIST_SIZE] = {};
+        uint64_t WaitHist[HIST_SIZE] = {};
+    };
+
+    std::vector<std::unique_ptr<std::thread>> Threads;
+    std::map<TString, TPlace> Places;
+    std::set<TString> KeepPlaces;   /* default and with load limit, others are erased when idle */
+    TString LastPlace;
+    unsigned PlaceThreads = 1;
+    std::condition_variable Wakeup;
+    std::mutex Mutex;
+    bool ShouldStop = false;
+    const TString Name;
+
+    static void Account(uint64_t *hist, const uint64_t *buckets, uint64_t value) {
+        for (int i = 0; i < HIST_SIZE; i++)
+            if (value <= buckets[i])
+                hist[i]++;
+    }
+
+    TPlace &Push(const TString &place, TItem &item) {
+        auto &p = Places[place];
+        item.QueueTime = GetCurrentTimeMs();
+        p.Queued++;
+        Account(p.DepthHist, DepthBuckets, p.Queued - 1);
+        return p;
+    }
+
+    void PushRequest(const TString &place, const TClient *client, TItem &item) {
+        auto &p = Push(place, item);
+        auto &queue = p.Requests[client];
+        if (queue.empty())
+            p.Order.push_back(client);
+        queue.push_back(std::move(item));
+    }
+
+    /* first client in round-robin order with ready request */
+    bool PickRequest(const TString &name, TPlace &p, TItem &item, bool &claimed) {
+        for (auto it = p.Order.begin(); it != p.Order.end(); it++) {
+            auto client = *it;
+            auto &queue = p.Requests[client];
+            auto &front = queue.front();
+            bool load = front.Request && front.Request->PlaceLoadReq;
+
+            if (load && !TStorage::TryIncPlaceLoad(name))
+                continue;
+
+            claimed = load;
+            item = std::move(queue.front());
+            queue.pop_front();
+            p.Order.erase(it);
+            if (queue.empty())
+                p.Requests.erase(client);
+            else
+                p.Order.push_back(client);
+            return true;
+        }
+        return false;
+    }
+
+    bool Pick(TItem &item, TString &name, bool &claimed) {
+        auto start = Places.upper_bound(LastPlace);
+        bool tasks = false;
+
+        for (int pass = 0; pass < 2; pass++) {
+            auto it = start;
+            for (size_t n = 0; n < Places.size(); n++, it++) {
+                if (it == Places.end())
+                    it = Places.begin();
+                auto &p = it->second;
+                if (!p.Queued || p.Running >= PlaceThreads)
+                    continue;
+                if (!pass && PickRequest(it->first, p, item, claimed)) {
+                    name = LastPlace = it->first;
+                    return true;
+                }
+                if (pass && !p.Tasks.empty()) {
+                    item = std::move(p.Tasks.front());
+                    p.Tasks.pop_front();
+                    name = LastPlace = it->first;
+                    claimed = false;
+                    return true;
+                }
+                tasks |= !p.Tasks.empty();
+            }
+            if (!tasks)
+                break;
+        }
+
+        return false;
+    }
+
+public:
+    TIoScheduler(const TString &name) : Name(name) {}
+
+    void Start(int thread_count) {
+        PlaceThreads = config().daemon().io_place_threads();
+        if (!PlaceThreads)
+            PlaceThreads = std::max(thread_count - 1, 1);
+        TUintMap limits;
+        KeepPlaces = { PORTO_PLACE };
+        if (!StringToUintMap(config().volumes().place_load_limit(), limits))
+            for (auto &it: limits)
+                KeepPlaces.insert(it.first);
+        for (int index = 0; index < thread_count; index++)
+            Threads.emplace_back(new std::thread(&TIoScheduler::Run, this, index));
+    }
+
+    void Stop() {
+        Mutex.lock();
+        ShouldStop = true;
+        Mutex.unlock();
+        Wakeup.notify_all();
+        for (auto &thread: Threads)
+            thread->join();
+        Threads.clear();
+        ShouldStop = false;
+    }
+
+    void Enqueue(std::unique_ptr<TRequest> &request) {
+        std::unique_lock<std::mutex> lock(Mutex);
+        TItem item;
+        auto client = request->Client.get();
+        auto place = request->IoPlace;
+        item.Request = std::move(request);
+        PushRequest(place, client, item);
+        lock.unlock();
+        Wakeup.notify_one();
+    }
+
+    void Enqueue(const std::function<void()> &task, const TString &place, const TClient *client) {
+        std::unique_lock<std::mutex> lock(Mutex);
+        TItem item;
+        item.Task = task;
+        PushRequest(place, client, item);
+        lock.unlock();
+        Wakeup.notify_one();
+    }
+
+    void Enqueue(const std::function<void()> &task, const TString &place) {
+        std::unique_lock<std::mutex> lock(Mutex);
+        TItem item;
+        item.Task = task;
+        auto &p = Push(place, item);
+        p.Tasks.push_back(std::move(item));
+        lock.unlock();
+        Wakeup.notify_one();
+    }
+
+    void Notify() {
+        /* lock orders with waiter check in Run */
+        Mutex.lock();
+        Mutex.unlock();
+        Wakeup.notify_all();
+    }
+
+    void Run(int index) {
+        SetProcessName(fmt::format("{}{}", Name, index));
+        auto lock = std::unique_lock<std::mutex>(Mutex);
+        while (true) {
+            TString name;
+            TItem item;
+            bool claimed = false;
+
+            while (!ShouldStop && !Pick(item, name, claimed))
+                Wakeup.wait(lock);
+            if (ShouldStop)
+                break;
+
+            auto &p = Places[name];
+            p.Queued--;
+            p.Running++;
+            Account(p.WaitHist, WaitBuckets, GetCurrentTimeMs() - item.QueueTime);
+            lock.unlock();
+
+            if (claimed)
+                TStorage::ClaimPlaceLoad(name);
+            if (item.Request)
+                item.Request->Handle();
+            else
+                item.Task();
+            item.Request = nullptr;
+            item.Task = nullptr;
+            if (claimed)
+                TStorage::ReleasePlaceLoadClaim();
+
+            lock.lock();
+            p.Running--;
+            p.Completed++;
+            if (!p.Queued && !p.Running && !KeepPlaces.count(name))
+                Places.erase(name);
+            /* place thread limit released */
+            Wakeup.notify_all();
+        }
+        lock.unlock();
+    }
+
+    void Dump(TUintMap &stat) {
+        std::lock_guard<std::mutex> lock(Mutex);
+        for (auto &it: Places) {
+            auto &p = it.second;
+            auto prefix = "io_queue:" + it.first + ":";
+            stat[prefix + "queued"] = p.Queued;
+            stat[prefix + "running"] = p.Running;
+            stat[prefix + "completed"] = p.Completed;
+            for (int i = 0; i < HIST_SIZE; i++) {
+                auto le = DepthBuckets[i] == UINT64_MAX ? TString("inf") : std::to_string(DepthBuckets[i]);
+                stat[prefix + "depth_le_" + le] = p.DepthHist[i];
+            }
+            for (int i = 0; i < HIST_SIZE; i++) {
+                auto le = WaitBuckets[i] == UINT64_MAX ? TString("inf") : std::to_string(WaitBuckets[i]);
+                stat[prefix + "wait_ms_le_" + le] = p.WaitHist[i];
+            }
+        }
+    }
+};
+
 static TRequestQueue RwQueue("portod-RW");
 static TRequestQueue RoQueue("portod-RO");
-static TRequestQueue IoQueue("portod-IO");
+static TIoScheduler IoQueue("portod-IO");
 
 void StartRpcQueue() {
     RwQueue.Start(config().daemon().rw_threads());
@@ -2145,3 +2749,19 @@ void QueueRpcRequest(std::unique_ptr<TRequest> &request) {
     else
         RwQueue.Enqueue(request);
 }
+
+void QueueIoTask(const std::function<void()> &task, const TPath &place) {
+    IoQueue.Enqueue(task, place ? place.ToString() : TString(PORTO_PLACE));
+}
+
+void QueueIoRequest(const std::function<void()> &task, const TClient *client, const TPath &place) {
+    IoQueue.Enqueue(task, place ? place.ToString() : TString(PORTO_PLACE), client);
+}
+
+void WakeupIoQueue() {
+    IoQueue.Notify();
+}
+
+void DumpIoQueueStat(TUintMap &stat) {
+    IoQueue.Dump(stat);
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <functional>
 #include "common.hpp"
+#include "util/path.hpp"
+#include "util/string.hpp"
 
 class TClient;
 
@@ -15,6 +18,8 @@ public:
 
     bool RoReq;
     bool IoReq;
+    bool PlaceLoadReq;  /* takes place load slot */
+    TString IoPlace;    /* resolved by client container place policy */
 
     TString Cmd;
     TString Arg;
@@ -29,3 +34,11 @@ public:
 void StartRpcQueue();
 void StopRpcQueue();
 void QueueRpcRequest(std::unique_ptr<TRequest> &req);
+
+/* Background job for IO threads, requests go first */
+void QueueIoTask(const std::function<void()> &task, const TPath &place = TPath());
+/* Job on behalf of client, shares round-robin turn with its requests */
+void QueueIoRequest(const std::function<void()> &task, const TClient *client,
+                    const TPath &place = TPath());
+void WakeupIoQueue();
+void DumpIoQueueStat(TUintMap &stat);
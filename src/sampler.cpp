@@ -0,0 +1,246 @@
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
+
+#include "sampler.hpp"
+#include "container.hpp"
+#include "cgroup.hpp"
+#include "network.hpp"
+#include "config.hpp"
+#include "util/log.hpp"
+#include "util/string.hpp"
+#include "util/unix.hpp"
+
+struct TSample {
+    uint64_t Time = 0;
+    uint64_t CpuUsage = 0;
+    uint64_t CpuSystem = 0;
+    uint64_t MemUsage = 0;
+    uint64_t AnonUsage = 0;
+    uint64_t IoRead = 0;
+    uint64_t IoWrite = 0;
+    uint64_t IoOps = 0;
+    uint64_t NetRx = 0;
+    uint64_t NetTx = 0;
+
+    bool HasRates = false;
+    uint64_t CpuUsageRate = 0;
+    uint64_t CpuSystemRate = 0;
+    uint64_t IoReadRate = 0;
+    uint64_t IoWriteRate = 0;
+    uint64_t IoOpsRate = 0;
+    uint64_t NetRxRate = 0;
+    uint64_t NetTxRate = 0;
+};
+
+struct TSampleRing {
+    int Id = 0;
+    uint64_t Pass = 0;
+    std::vector<TSample> Samples;
+    size_t Head = 0;    /* next slot to write */
+    size_t Count = 0;
+
+    const TSample &Last() const {
+        return Samples[(Head + Samples.size() - 1) % Samples.size()];
+    }
+
+    void Add(const TSample &sample) {
+        Samples[Head] = sample;
+        Head = (Head + 1) % Samples.size();
+        if (Count < Samples.size())
+            Count++;
+    }
+};
+
+static std::thread SamplerThread;
+static std::mutex SamplerMutex;
+static std::condition_variable SamplerCv;
+static bool SamplerStop;
+
+/* protected with SamplerMutex, indexed by absolute container name */
+static std::unordered_map<TString, TSampleRing> SamplerRings;
+
+static uint64_t SampleRate(uint64_t cur, uint64_t prev, uint64_t ms) {
+    if (cur < prev || !ms)
+        return 0;   /* counter reset */
+    return (cur - prev) * 1000 / ms;
+}
+
+static void CollectSample(TContainer &ct, TSample &sample) {
+    TCgroupCollector collector(ct.GetKnobCache());
+    TUintMap map;
+
+    sample.Time = GetCurrentTimeMs();
+
+    if (ct.Controllers & CGROUP_CPUACCT) {
+        auto cg = ct.GetCgroup(CpuacctSubsystem);
+        (void)CpuacctSubsystem.Usage(cg, sample.CpuUsage);
+        (void)CpuacctSubsystem.SystemUsage(cg, sample.CpuSystem);
+    }
+
+    if (ct.Controllers & CGROUP_MEMORY) {
+        auto cg = ct.GetCgroup(MemorySubsystem);
+        (void)MemorySubsystem.Usage(cg, sample.MemUsage);
+        (void)MemorySubsystem.GetAnonUsage(cg, sample.AnonUsage);
+    }
+
+    if (ct.Controllers & CGROUP_BLKIO) {
+        auto cg = ct.GetCgroup(BlkioSubsystem);
+        if (!BlkioSubsystem.GetIoStat(cg, TBlkioSubsystem::IoStat::Read, map))
+            sample.IoRead = map["hw"];
+        map.clear();
+        if (!BlkioSubsystem.GetIoStat(cg, TBlkioSubsystem::IoStat::Write, map))
+            sample.IoWrite = map["hw"];
+        map.clear();
+        if (!BlkioSubsystem.GetIoStat(cg, TBlkioSubsystem::IoStat::Iops, map))
+            sample.IoOps = map["hw"];
+    }
+
+    if (!ct.NetInherit || ct.IsRoot()) {
+        auto lock = TNetwork::LockNetState();
+        if (ct.Net) {
+            auto uplink = ct.Net->DeviceStat.find("Uplink");
+            if (uplink != ct.Net->DeviceStat.end()) {
+                sample.NetRx = uplink->second.RxBytes;
+                sample.NetTx = uplink->second.TxBytes;
+            } else {
+                for (auto &it: ct.Net->DeviceStat) {
+                    if (StringStartsWith(it.first, "group "))
+                        continue;
+                    sample.NetRx += it.second.RxBytes;
+                    sample.NetTx += it.second.TxBytes;
+                }
+            }
+        }
+    }
+}
+
+static void SamplerPass(uint64_t pass) {
+    std::vector<std::shared_ptr<TContainer>> list;
+    size_t history = std::max(config().daemon().sampler_history(), 1u);
+    uint64_t start = GetCurrentTimeMs();
+
+    {
+        auto lock = LockContainers();
+        for (auto &it: Containers)
+            if (it.second->IsRoot() || it.second->HasResources())
+                list.push_back(it.second);
+    }
+
+    for (auto &ct: list) {
+        TSample sample;
+
+        /* cgroups and network are changed by stop and destroy */
+        ct->LockStateRead();
+        bool active = ct->IsRoot() || ct->HasResources();
+        if (active)
+            CollectSample(*ct, sample);
+        ct->UnlockState();
+        if (!active)
+            continue;
+
+        std::lock_guard<std::mutex> lock(SamplerMutex);
+        auto &ring = SamplerRings[ct->Name];
+        if (ring.Id != ct->Id || ring.Samples.size() != history) {
+            ring = TSampleRing();
+            ring.Id = ct->Id;
+            ring.Samples.resize(history);
+        }
+        if (ring.Count) {
+            auto &prev = ring.Last();
+            uint64_t ms = sample.Time - prev.Time;
+            sample.HasRates = true;
+            sample.CpuUsageRate = SampleRate(sample.CpuUsage, prev.CpuUsage, ms);
+            sample.CpuSystemRate = SampleRate(sample.CpuSystem, prev.CpuSystem, ms);
+            sample.IoReadRate = SampleRate(sample.IoRead, prev.IoRead, ms);
+            sample.IoWriteRate = SampleRate(sample.IoWrite, prev.IoWrite, ms);
+            sample.IoOpsRate = SampleRate(sample.IoOps, prev.IoOps, ms);
+            sample.NetRxRate = SampleRate(sample.NetRx, prev.NetRx, ms);
+            sample.NetTxRate = SampleRate(sample.NetTx, prev.NetTx, ms);
+        }
+        ring.Add(sample);
+        ring.Pass = pass;
+    }
+
+    /* drop history of destroyed and stopped containers */
+    std::lock_guard<std::mutex> lock(SamplerMutex);
+    for (auto it = SamplerRings.begin(); it != SamplerRings.end(); ) {
+        if (it->second.Pass != pass)
+            it = SamplerRings.erase(it);
+        else
+            ++it;
+    }
+
+    Statistics->SamplerPasses++;
+    Statistics->SamplerTimeMs = GetCurrentTimeMs() - start;
+}
+
+static void SamplerLoop() {
+    uint64_t interval = config().daemon().sampler_interval_ms();
+    uint64_t pass = 0;
+
+    SetProcessName("portod-SMP");
+
+    std::unique_lock<std::mutex> lock(SamplerMutex);
+    while (!SamplerStop) {
+        lock.unlock();
+        SamplerPass(++pass);
+        lock.lock();
+        SamplerCv.wait_for(lock, std::chrono::milliseconds(interval),
+                           []{ return SamplerStop; });
+    }
+}
+
+void StartSampler() {
+    if (!config().daemon().sampler_interval_ms())
+        return;
+    SamplerStop = false;
+    SamplerThread = std::thread(SamplerLoop);
+}
+
+void StopSampler() {
+    if (!SamplerThread.joinable())
+        return;
+    std::unique_lock<std::mutex> lock(SamplerMutex);
+    SamplerStop = true;
+    lock.unlock();
+    SamplerCv.notify_all();
+    SamplerThread.join();
+    SamplerRings.clear();
+}
+
+void DumpSamples(const TString &name, uint64_t count, rpc::TContainerSamples &dump) {
+    std::lock_guard<std::mutex> lock(SamplerMutex);
+    auto it = SamplerRings.find(name);
+    if (it == SamplerRings.end())
+        return;
+
+    auto &ring = it->second;
+    if (!count || count > ring.Count)
+        count = ring.Count;
+
+    for (size_t i = ring.Count - count; i < ring.Count; i++) {
+        size_t index = (ring.Head + ring.Samples.size() - ring.Count + i) % ring.Samples.size();
+        auto &s = ring.Samples[index];
+        auto d = dump.add_sample();
+        d->set_time(s.Time);
+        d->set_cpu_usage(s.CpuUsage);
+        d->set_cpu_usage_system(s.CpuSystem);
+        d->set_memory_usage(s.MemUsage);
+        d->set_anon_usage(s.AnonUsage);
+        d->set_io_read(s.IoRead);
+        d->set_io_write(s.IoWrite);
+        d->set_io_ops(s.IoOps);
+        d->set_net_rx_bytes(s.NetRx);
+        d->set_net_tx_bytes(s.NetTx);
+        if (s.HasRates) {
+            d->set_cpu_usage_rate(s.CpuUsageRate);
+            d->set_cpu_system_rate(s.CpuSystemRate);
+            d->set_io_read_rate(s.IoReadRate);
+            d->set_io_write_rate(s.IoWriteRate);
+            d->set_io_ops_rate(s.IoOpsRate);
+            d->set_net_rx_rate(s.NetRxRate);
+            d->set_net_tx_rate(s.NetTxRate);
+        }
+    }
+}
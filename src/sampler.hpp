@@ -0,0 +1,14 @@
+#pragma once
+
+#include "common.hpp"
+
+/*
+ * Background sampler: periodically snapshots resource counters of all
+ * containers into per-container ring buffers, so monitoring could read
+ * history and rates without scraping cgroups on each poll.
+ */
+
+void StartSampler();
+void StopSampler();
+
+void DumpSamples(const TString &name, uint64_t count, rpc::TContainerSamples &dump);
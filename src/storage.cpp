@@ -4,16 +4,23 @@
 #include "config.hpp"
 #include "filesystem.hpp"
 #include "client.hpp"
+#include "rpc.hpp"
 #include <algorithm>
 #include <condition_variable>
+#include <thread>
+#include <set>
+#include <map>
 #include "util/unix.hpp"
 #include "util/log.hpp"
 #include "util/string.hpp"
 #include "util/md5.hpp"
 #include "util/quota.hpp"
+#include "util/tar.hpp"
 
 extern "C" {
 #include <sys/stat.h>
+#include <sys/xattr.h>
+#include <sys/sendfile.h>
 #include <fcntl.h>
 #include <unistd.h>
 }
@@ -23,6 +30,7 @@ static const char WEAK_PREFIX[] = "_weak_";
 static const char IMPORT_PREFIX[] = "_import_";
 static const char REMOVE_PREFIX[] = "_remove_";
 static const char PRIVATE_PREFIX[] = "_private_";
+static const char IMAGE_PREFIX[] = "_image_";
 static const char META_PREFIX[] = "_meta_";
 static const char META_LAYER[] = "_layer_";
 
@@ -39,9 +47,41 @@ static bool PathIsActive(const TPath &path) {
 
 static std::condition_variable StorageCv;
 
+static std::mutex PlaceLoadMutex;
+static std::condition_variable PlaceLoadCv;
 static TUintMap PlaceLoad;
 static TUintMap PlaceLoadLimit;
 
+/* Place load slot taken by IO scheduler for request in this thread */
+static thread_local TString PlaceLoadClaim;
+
+/* Places with not empty trash, protected with TrashMutex */
+static std::set<TString> TrashPlaces;
+static uint64_t TrashCounter = 0;
+static std::mutex TrashMutex;
+static std::condition_variable TrashCv;
+static std::thread TrashThread;
+static std::atomic<bool> TrashStop;
+
+/* Imports in progress, protected with ImportMutex */
+struct TImport {
+    TString Place;
+    TString Name;
+    const TFile *Archive;
+    uint64_t ArchiveSize;
+    uint64_t StartMs;
+    const TTarExtract *Tar;
+};
+
+static std::mutex ImportMutex;
+static std::list<TImport *> Imports;
+
+static void ScheduleTrash(const TPath &place) {
+    std::lock_guard<std::mutex> lock(TrashMutex);
+    TrashPlaces.insert(place.ToString());
+    TrashCv.notify_all();
+}
+
 TError TStorage::Resolve(EStorageType type, const TPath &place, const TString &name) {
     TError error;
 
@@ -98,23 +138,51 @@ void TStorage::Init() {
         PlaceLoadLimit = {{"default", 1}};
 }
 
+static TString PlaceLoadId(const TString &place) {
+    return PlaceLoadLimit.count(place) ? place : "default";
+}
+
 void TStorage::IncPlaceLoad(const TPath &place) {
-    auto lock = LockVolumes();
-    auto id = place.ToString();
-    if (!PlaceLoadLimit.count(id))
-        id = "default";
-    StorageCv.wait(lock, [&]{return PlaceLoad[id] < PlaceLoadLimit[id];});
+    std::unique_lock<std::mutex> lock(PlaceLoadMutex);
+    auto id = PlaceLoadId(place.ToString());
+    if (!PlaceLoadClaim.empty() && PlaceLoadId(PlaceLoadClaim) == id) {
+        PlaceLoadClaim.clear();
+        return;
+    }
+    PlaceLoadCv.wait(lock, [&]{return PlaceLoad[id] < PlaceLoadLimit[id];});
     PlaceLoad[id]++;
 }
 
 void TStorage::DecPlaceLoad(const TPath &place) {
-    auto lock = LockVolumes();
-    auto id = place.ToString();
-    if (!PlaceLoadLimit.count(id))
-        id = "default";
+    std::unique_lock<std::mutex> lock(PlaceLoadMutex);
+    auto id = PlaceLoadId(place.ToString());
     if (PlaceLoad[id]-- <= 1)
         PlaceLoad.erase(id);
-    StorageCv.notify_all();
+    lock.unlock();
+    PlaceLoadCv.notify_all();
+    WakeupIoQueue();
+}
+
+bool TStorage::TryIncPlaceLoad(const TPath &place) {
+    std::lock_guard<std::mutex> lock(PlaceLoadMutex);
+    auto id = PlaceLoadId(place.ToString());
+    if (PlaceLoad[id] >= PlaceLoadLimit[id])
+        return false;
+    PlaceLoad[id]++;
+    return true;
+}
+
+/* Next IncPlaceLoad for the same place in this thread uses taken slot */
+void TStorage::ClaimPlaceLoad(const TPath &place) {
+    PlaceLoadClaim = place.ToString();
+}
+
+void TStorage::ReleasePlaceLoadClaim() {
+    if (PlaceLoadClaim.empty())
+        return;
+    TPath place = PlaceLoadClaim;
+    PlaceLoadClaim.clear();
+    DecPlaceLoad(place);
 }
 
 /* FIXME racy. rewrite with openat... etc */
@@ -198,8 +266,10 @@ TError TStorage::Cleanup(const TPath &place, EStorageType type, unsigned perms)
             path = dirent.RealPath();
 
         } else if (path.IsRegularStrict()) {
-            if (type != EStorageType::Volume && StringStartsWith(name, PRIVATE_PREFIX)) {
-                TString tail = name.substr(TString(PRIVATE_PREFIX).size());
+            TString prefix = StringStartsWith(name, PRIVATE_PREFIX) ? PRIVATE_PREFIX :
+                             StringStartsWith(name, IMAGE_PREFIX) ? IMAGE_PREFIX : "";
+            if (type != EStorageType::Volume && !prefix.empty()) {
+                TString tail = name.substr(prefix.size());
                 if ((base / tail).IsDirectoryStrict() ||
                         (base / (TString(IMPORT_PREFIX) + tail)).IsDirectoryStrict())
                     continue;
@@ -248,6 +318,9 @@ TError TStorage::CheckPlace(const TPath &place) {
     if (error)
         return error;
 
+    if ((place / PORTO_TRASH).Exists())
+        ScheduleTrash(place);
+
     return OK;
 }
 
@@ -268,6 +341,7 @@ TError TStorage::CheckName(const TString &name, bool meta) {
             StringStartsWith(name, IMPORT_PREFIX) ||
             StringStartsWith(name, REMOVE_PREFIX) ||
             StringStartsWith(name, PRIVATE_PREFIX) ||
+            StringStartsWith(name, IMAGE_PREFIX) ||
             StringStartsWith(name, META_PREFIX) ||
             StringStartsWith(name, META_LAYER))
         return TError(EError::InvalidValue, "invalid layer name '" + name + "'");
@@ -363,6 +437,8 @@ TError TStorage::CheckUsage() {
                 if (Place == it.second->Place && Name == layer)
                     return TError(EError::Busy, "Layer " + Name + " in use by volume " + it.second->Path.ToString());
         }
+        if (TVolume::LayerImageBusy(Path))
+            return TError(EError::Busy, "Layer {} image is mounted", Name);
     }
 
     if (Type == EStorageType::Storage) {
@@ -390,6 +466,11 @@ TPath TStorage::TempPath(const TString &kind) {
     return Path.DirNameNormal() / kind + Path.BaseNameNormal();
 }
 
+/* Squashfs image of lazy layer, mounted at layer path while in use */
+TPath TStorage::ImagePath() {
+    return TempPath(IMAGE_PREFIX);
+}
+
 TError TStorage::Load() {
     struct stat st;
     TError error;
@@ -599,8 +680,384 @@ TError TStorage::SaveChecksums() {
     return OK;
 }
 
+/*
+ * Content store: place/porto_content/<xx>/<md5>_<uid>_<gid>_<mode>_<mtime>
+ *
+ * Identical regular files of layers are hardlinks to one inode in store.
+ * Owner, mode and mtime are part of key because they are shared by links.
+ * Link count of store entry is reference count: one for store plus one
+ * per layer. Entries with single link are garbage. Protected by ContentMutex.
+ */
+
+static const char CONTENT_XATTR[] = "user.porto.md5sum";
+static const char CONTENT_TMP[] = ".porto_content";
+
+struct TContentUsage {
+    bool Loaded = false;
+    uint64_t Files = 0;     /* layer links to existing entries */
+    uint64_t Bytes = 0;     /* disk space saved by these links */
+};
+
+static std::mutex ContentMutex;
+static std::map<TString, TContentUsage> ContentUsage;
+
+static TString ContentKey(const TString &sum, const struct stat &st) {
+    return fmt::format("{}_{}_{}_{:o}_{}", sum, st.st_uid, st.st_gid,
+                       st.st_mode & 07777, st.st_mtim.tv_sec);
+}
+
+static TPath ContentPath(const TPath &place, const TString &key) {
+    return place / PORTO_CONTENT / key.substr(0, 2) / key;
+}
+
+/* Only content checksum could be shared, other xattrs forbid dedup */
+static bool ContentXAttrsOnly(const TPath &path) {
+    char list[sizeof(CONTENT_XATTR) + 1];
+    ssize_t len = llistxattr(path.c_str(), list, sizeof(list));
+    return len == 0 || (len == sizeof(CONTENT_XATTR) && !strcmp(list, CONTENT_XATTR));
+}
+
+static TContentUsage &LoadContentUsage(const TPath &place) {
+    PORTO_LOCKED(ContentMutex);
+
+    auto &usage = ContentUsage[place.ToString()];
+    if (usage.Loaded)
+        return usage;
+
+    usage.Loaded = true;
+
+    TPath store = place / PORTO_CONTENT;
+    if (!store.Exists())
+        return usage;
+
+    TPathWalk walk;
+    TError error = walk.OpenScan(store);
+
+    while (!error) {
+        error = walk.Next();
+        if (error || !walk.Path)
+            break;
+        if (!S_ISREG(walk.Stat->st_mode))
+            continue;
+        if (walk.Stat->st_nlink > 1) {
+            usage.Files += walk.Stat->st_nlink - 2;
+            usage.Bytes += (walk.Stat->st_nlink - 2) * walk.Stat->st_blocks * 512ull;
+        } else {
+            /* garbage left by crash or by removing broken import */
+            error = walk.Path.Unlink();
+        }
+    }
+
+    if (error)
+        L_WRN("Cannot scan content store {}: {}", store, error);
+
+    return usage;
+}
+
+void TStorage::GetContentUsage(const TPath &place, uint64_t &files, uint64_t &bytes) {
+    std::lock_guard<std::mutex> lock(ContentMutex);
+    auto &usage = LoadContentUsage(place);
+    files = usage.Files;
+    bytes = usage.Bytes;
+}
+
+TError TStorage::DedupLayer(const TPath &place, const TPath &layer, bool checksums) {
+    TPath store = place / PORTO_CONTENT;
+    uint64_t files = 0, bytes = 0;
+    std::set<TString> keys;
+    TPathWalk walk;
+    TError error;
+
+    error = store.Mkdir(0700);
+    if (error && error.Errno != EEXIST)
+        return error;
+
+    error = walk.OpenScan(layer);
+    if (error)
+        return error;
+
+    while (1) {
+        error = walk.Next();
+        if (error || !walk.Path)
+            break;
+
+        struct stat st = *walk.Stat;
+
+        /* keep hardlinks, empty and files with own xattrs as is */
+        if (!S_ISREG(st.st_mode) || st.st_nlink != 1 || !st.st_size ||
+                !ContentXAttrsOnly(walk.Path))
+            continue;
+
+        TFile file;
+        TString sum;
+
+        error = file.OpenRead(walk.Path);
+        if (error)
+            break;
+
+        /* checksums computed while extracting, never from archive */
+        if (!checksums || file.GetXAttr(CONTENT_XATTR, sum) || sum.size() != 32) {
+            error = Md5Sum(file, sum);
+            if (!error)
+                error = file.SetXAttr(CONTENT_XATTR, sum);
+            if (error)
+                break;
+        }
+
+        /* links inside one layer would be changed by overlayfs copy-up */
+        TString key = ContentKey(sum, st);
+        if (!keys.insert(key).second)
+            continue;
+
+        TPath entry = ContentPath(place, key);
+        struct stat entry_st;
+
+        std::lock_guard<std::mutex> lock(ContentMutex);
+        auto &usage = LoadContentUsage(place);
+
+        if (lstat(entry.c_str(), &entry_st)) {
+            error = entry.DirName().Mkdir(0700);
+            if (error && error.Errno != EEXIST)
+                break;
+            error = entry.Hardlink(walk.Path);
+            if (error)
+                break;
+            continue;
+        }
+
+        if (!S_ISREG(entry_st.st_mode) || entry_st.st_size != st.st_size)
+            continue;
+
+        TPath temp = walk.Path.DirName() / CONTENT_TMP;
+        error = temp.Hardlink(entry);
+        if (error) {
+            /* link count overflow */
+            if (error.Errno == EMLINK)
+                continue;
+            break;
+        }
+        error = temp.Rename(walk.Path);
+        if (error) {
+            (void)temp.Unlink();
+            break;
+        }
+
+        files++;
+        bytes += st.st_blocks * 512ull;
+        usage.Files++;
+        usage.Bytes += st.st_blocks * 512ull;
+    }
+
+    Statistics->LayerDedupFiles += files;
+    Statistics->LayerDedupBytes += bytes;
+
+    if (files)
+        L_ACT("Dedup {}: {} files, {} saved", layer, files, StringFormatSize(bytes));
+
+    return error;
+}
+
+/* Replace link to store with private copy which could be changed in place */
+static TError UnshareFile(const TPath &path, const struct stat &st) {
+    TPath temp = path.DirName() / CONTENT_TMP;
+    TFile src, dst;
+    TString buf;
+    TError error;
+
+    error = src.OpenRead(path);
+    if (error)
+        return error;
+
+    error = dst.Create(temp, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC | O_NOFOLLOW, 0600);
+    if (error)
+        return error;
+
+    buf.resize(1 << 20);
+    while (1) {
+        ssize_t len = read(src.Fd, &buf[0], buf.size());
+        if (len < 0) {
+            error = TError::System("read {}", path);
+            break;
+        }
+        if (!len)
+            break;
+        if (write(dst.Fd, &buf[0], len) != len) {
+            error = TError::System("write {}", temp);
+            break;
+        }
+    }
+
+    if (!error)
+        error = dst.Chown(st.st_uid, st.st_gid);
+    if (!error)
+        error = dst.Chmod(st.st_mode & 07777);
+
+    struct timespec ts[2] = { st.st_atim, st.st_mtim };
+    if (!error && futimens(dst.Fd, ts))
+        error = TError::System("futimens {}", temp);
+
+    if (!error)
+        error = temp.Rename(path);
+    if (error)
+        (void)temp.Unlink();
+
+    return error;
+}
+
+TError TStorage::ReleaseContent(const TPath &place, const TPath &layer, bool unshare) {
+    TPath store = place / PORTO_CONTENT;
+    TPathWalk walk;
+    TError error;
+
+    if (!store.Exists())
+        return OK;
+
+    error = walk.OpenScan(layer);
+    if (error)
+        return error;
+
+    while (1) {
+        error = walk.Next();
+        if (error || !walk.Path)
+            break;
+
+        struct stat st = *walk.Stat;
+        if (!S_ISREG(st.st_mode) || st.st_nlink < 2)
+            continue;
+
+        TString sum;
+        if (walk.Path.GetXAttr(CONTENT_XATTR, sum))
+            continue;
+
+        TPath entry = ContentPath(place, ContentKey(sum, st));
+        struct stat entry_st;
+
+        std::lock_guard<std::mutex> lock(ContentMutex);
+        auto &usage = LoadContentUsage(place);
+
+        if (lstat(entry.c_str(), &entry_st) ||
+                entry_st.st_dev != st.st_dev || entry_st.st_ino != st.st_ino)
+            continue;
+
+        if (unshare)
+            error = UnshareFile(walk.Path, st);
+        else
+            error = walk.Path.Unlink();
+        if (error)
+            break;
+
+        if (entry_st.st_nlink > 2) {
+            usage.Files--;
+            usage.Bytes -= st.st_blocks * 512ull;
+        } else {
+            error = entry.Unlink();
+            if (error)
+                break;
+        }
+    }
+
+    return error;
+}
+
+/* Decompressor runs as helper and writes into pipe, tar is parsed here */
+static TError ExtractTar(const TFile &arc, const TString &option,
+                         const TFile &dir, TTarExtract &tar) {
+    TTuple decompress;
+    TError error, error2;
+    int fds[2];
+
+    if (option == "--gzip")
+        decompress = { "gzip", "-d" };
+    else if (option == "--xz")
+        decompress = { "xz", "-d" };
+    else if (StringStartsWith(option, "--use-compress-program="))
+        decompress = { option.substr(strlen("--use-compress-program=")), "-d" };
+
+    if (decompress.empty())
+        return tar.Extract(arc, dir);
+
+    if (pipe2(fds, O_CLOEXEC))
+        return TError::System("pipe2");
+
+    TFile in, out;
+    in.SetFd = fds[0];
+    out.SetFd = fds[1];
+
+    std::thread thread([&] {
+        error2 = RunCommand(decompress, TFile(), arc, out);
+        out.Close();
+    });
+
+    error = tar.Extract(in, dir);
+
+    /* stop decompressor if extraction failed */
+    in.Close();
+    thread.join();
+
+    return error ? error : error2;
+}
+
+/* Lazy squashfs layer keeps archive as is, sendfile advances shared offset */
+static TError CopyLayerImage(const TFile &arc, const TPath &image) {
+    struct stat st;
+    TFile file;
+    TError error;
+
+    error = arc.Stat(st);
+    if (error)
+        return error;
+
+    error = file.CreateTrunc(image, 0644);
+    if (error)
+        return error;
+
+    if (lseek(arc.Fd, 0, SEEK_SET))
+        return TError::System("lseek {}", arc.RealPath());
+
+    for (off_t done = 0; done < st.st_size; ) {
+        ssize_t ret = sendfile(file.Fd, arc.Fd, nullptr, st.st_size - done);
+        if (ret < 0)
+            return TError::System("sendfile {}", image);
+        if (!ret)
+            return TError(EError::InvalidData, "Archive {} truncated", arc.RealPath());
+        done += ret;
+    }
+
+    if (fsync(file.Fd))
+        return TError::System("fsync {}", image);
+
+    return OK;
+}
+
+void TStorage::ListImports(const TPath &place, std::list<TImportProgress> &list) {
+    std::lock_guard<std::mutex> lock(ImportMutex);
+    uint64_t now = GetCurrentTimeMs();
+
+    for (auto import: Imports) {
+        if (import->Place != place.ToString())
+            continue;
+
+        /* decompressor shares file offset with us */
+        off_t offset = lseek(import->Archive->Fd, 0, SEEK_CUR);
+
+        list.push_back({
+            import->Name,
+            import->ArchiveSize,
+            offset > 0 ? (uint64_t)offset : 0,
+            import->Tar ? (uint64_t)import->Tar->Entries : 0,
+            import->Tar ? (uint64_t)import->Tar->Bytes : 0,
+            now - import->StartMs,
+        });
+    }
+}
+
 TError TStorage::ImportArchive(const TPath &archive, const TString &compress, bool merge) {
     TPath temp = TempPath(IMPORT_PREFIX);
+    bool dedup = config().volumes().layer_dedup() && Type == EStorageType::Layer;
+    bool native = false, lazy = false;
+    TTarExtract tar;
+    TImport import;
+    struct stat st;
     TError error;
     TFile arc;
 
@@ -653,6 +1110,8 @@ TError TStorage::ImportArchive(const TPath &archive, const TString &compress, bo
         error = CL->CanControl(layer.Owner);
         if (error)
             return TError(error, "Cannot merge {}", Path);
+        if (ImagePath().Exists())
+            return TError(EError::NotSupported, "Cannot merge into squashfs image layer {}", Name);
     }
 
     if (Path.Exists()) {
@@ -681,7 +1140,52 @@ TError TStorage::ImportArchive(const TPath &archive, const TString &compress, bo
     IncPlaceLoad(Place);
     Statistics->LayerImport++;
 
-    if (compress_format == "tar") {
+    native = compress_format == "tar" && config().volumes().native_import();
+    lazy = compress_format == "squashfs" && config().volumes().lazy_squashfs() &&
+           Type == EStorageType::Layer && !merge;
+
+    import.Place = Place.ToString();
+    import.Name = Name;
+    import.Archive = &arc;
+    import.ArchiveSize = arc.Stat(st) ? 0 : st.st_size;
+    import.StartMs = GetCurrentTimeMs();
+    import.Tar = native ? &tar : nullptr;
+
+    ImportMutex.lock();
+    Imports.push_back(&import);
+    ImportMutex.unlock();
+
+    if (merge && Type == EStorageType::Layer) {
+        /* unsquashfs -force rewrites existing files in place */
+        error = ReleaseContent(Place, temp, true);
+        if (error)
+            goto err;
+    }
+
+    if (native) {
+        if (dedup)
+            tar.ChecksumXAttr = CONTENT_XATTR;
+
+        error = ExtractTar(arc, compress_option, import_dir, tar);
+        if (error && error.Error == EError::NotSupported) {
+            L_WRN("Cannot extract {} in-process, fallback to tar: {}", archive, error);
+            native = false;
+            error = merge ? OK : ClearRecursive(temp);
+            if (!error && lseek(arc.Fd, 0, SEEK_SET))
+                error = TError::System("lseek {}", archive);
+            if (error)
+                goto err;
+        } else
+            L_ACT("Extracted {} entries {} in {} ms", (uint64_t)tar.Entries,
+                  StringFormatSize(tar.Bytes), GetCurrentTimeMs() - import.StartMs);
+    }
+
+    if (native) {
+        /* already extracted */
+    } else if (lazy) {
+        /* empty import directory becomes mountpoint */
+        error = CopyLayerImage(arc, ImagePath());
+    } else if (compress_format == "tar") {
         TTuple args = { "tar",
                         "--numeric-owner",
                         "--preserve-permissions",
@@ -716,10 +1220,17 @@ TError TStorage::ImportArchive(const TPath &archive, const TString &compress, bo
     if (error)
         goto err;
 
-    if (Type == EStorageType::Layer) {
+    if (Type == EStorageType::Layer && !lazy) {
         error = SanitizeLayer(temp, merge);
         if (error)
             goto err;
+
+        if (dedup) {
+            /* merged layer keeps files from previous imports */
+            error = DedupLayer(Place, temp, native && !merge);
+            if (error)
+                L_WRN("Cannot dedup layer {}: {}", temp, error);
+        }
     }
 
     if (!Owner.IsUnknown()) {
@@ -744,17 +1255,31 @@ TError TStorage::ImportArchive(const TPath &archive, const TString &compress, bo
 
     DecPlaceLoad(Place);
 
+    ImportMutex.lock();
+    Imports.remove(&import);
+    ImportMutex.unlock();
+
     StorageCv.notify_all();
 
     return OK;
 
 err:
+    if (Type == EStorageType::Layer)
+        (void)ReleaseContent(Place, temp, false);
+
+    if (lazy)
+        (void)ImagePath().Unlink();
+
     TError error2 = temp.RemoveAll();
     if (error2)
         L_WRN("Cannot cleanup layer: {}", error2);
 
     DecPlaceLoad(Place);
 
+    ImportMutex.lock();
+    Imports.remove(&import);
+    ImportMutex.unlock();
+
     lock.lock();
     ActivePaths.remove(temp);
     lock.unlock();
@@ -806,6 +1331,16 @@ TError TStorage::ExportArchive(const TPath &archive, const TString &compress) {
     if (error)
         return error;
 
+    /* lazy layer directory is empty until image is mounted */
+    bool image = Type == EStorageType::Layer && ImagePath().IsRegularStrict();
+    if (image) {
+        error = TVolume::AcquireLayerImage(ImagePath(), Path);
+        if (error) {
+            (void)dir.UnlinkAt(archive.BaseName());
+            return TError(error, "Cannot mount layer {}", Name);
+        }
+    }
+
     IncPlaceLoad(Place);
     Statistics->LayerExport++;
 
@@ -852,6 +1387,9 @@ TError TStorage::ExportArchive(const TPath &archive, const TString &compress) {
 
     DecPlaceLoad(Place);
 
+    if (image)
+        TVolume::ReleaseLayerImage(Path);
+
     return error;
 }
 
@@ -888,6 +1426,17 @@ TError TStorage::Remove(bool weak) {
             L_WRN("Cannot remove private: {}", error);
     }
 
+    temp = ImagePath();
+    if (temp.Exists()) {
+        /* image could stay mounted after restart */
+        error = Path.UmountAll();
+        if (error)
+            return error;
+        error = temp.Unlink();
+        if (error)
+            L_WRN("Cannot remove image: {}", error);
+    }
+
     TFile temp_dir;
     temp = TempPath(REMOVE_PREFIX + std::to_string(RemoveCounter++));
 
@@ -915,7 +1464,15 @@ TError TStorage::Remove(bool weak) {
             L_WRN("Cannot destroy quota {}: {}", temp, error);
     }
 
-    error = RemoveRecursive(temp);
+    if (Type == EStorageType::Layer) {
+        error = ReleaseContent(Place, temp, false);
+        if (error)
+            L_WRN("Cannot release content of {}: {}", temp, error);
+    }
+
+    error = MoveToTrash(Place, temp);
+    if (error)
+        error = RemoveRecursive(temp);
     if (error) {
         L_VERBOSE("Cannot remove storage {}: {}", temp, error);
         error = temp.RemoveAll();
@@ -932,6 +1489,93 @@ TError TStorage::Remove(bool weak) {
     return error;
 }
 
+TError TStorage::MoveToTrash(const TPath &place, const TPath &path) {
+    TPath trash = place / PORTO_TRASH;
+    TError error;
+
+    if (!config().volumes().async_remove() || !TrashThread.joinable())
+        return TError(EError::NotSupported, "Async remove is disabled");
+
+    error = trash.Mkdir(0700);
+    if (error && error.Errno != EEXIST)
+        return error;
+
+    std::unique_lock<std::mutex> lock(TrashMutex);
+    TPath dest = trash / fmt::format("{}_{}", GetCurrentTimeMs(), TrashCounter++);
+    lock.unlock();
+
+    error = path.Rename(dest);
+    if (error) {
+        L_VERBOSE("Cannot move {} into trash: {}", path, error);
+        return error;
+    }
+
+    L_ACT("Move {} into trash {}", path, dest);
+    Statistics->TrashQueued++;
+    ScheduleTrash(place);
+
+    return OK;
+}
+
+static void TrashReaper() {
+    SetProcessName("portod-RM");
+
+    std::unique_lock<std::mutex> lock(TrashMutex);
+    while (!TrashStop) {
+        if (TrashPlaces.empty()) {
+            TrashCv.wait(lock);
+            continue;
+        }
+
+        TPath place = *TrashPlaces.begin();
+        TrashPlaces.erase(TrashPlaces.begin());
+        lock.unlock();
+
+        TPath trash = place / PORTO_TRASH;
+        std::vector<TString> list;
+        TError error;
+
+        error = trash.ReadDirectory(list);
+        if (error && error.Errno != ENOENT)
+            L_WRN("Cannot list trash {}: {}", trash, error);
+
+        for (auto &name: list) {
+            if (TrashStop)
+                break;
+
+            TStorage::IncPlaceLoad(place);
+            error = RemoveRecursive(trash / name);
+            TStorage::DecPlaceLoad(place);
+
+            if (error)
+                L_WRN("Cannot remove trash {}: {}", trash / name, error);
+            else
+                Statistics->TrashRemoved++;
+        }
+
+        /* new entries will recreate it, rename fails into sync remove if raced */
+        if (!TrashStop)
+            (void)trash.Rmdir();
+
+        lock.lock();
+    }
+}
+
+void TStorage::StartTrashReaper() {
+    TrashStop = false;
+    TrashThread = std::thread(TrashReaper);
+}
+
+void TStorage::StopTrashReaper() {
+    if (!TrashThread.joinable())
+        return;
+    std::unique_lock<std::mutex> lock(TrashMutex);
+    TrashStop = true;
+    TrashCv.notify_all();
+    lock.unlock();
+    TrashThread.join();
+}
+
 TError TStorage::SanitizeLayer(const TPath &layer, bool merge) {
     TPathWalk walk;
     TError error;
@@ -3,6 +3,15 @@
 #include <list>
 #include "util/path.hpp"
 
+struct TImportProgress {
+    TString Name;
+    uint64_t ArchiveSize;
+    uint64_t ArchiveRead;
+    uint64_t Entries;
+    uint64_t Bytes;
+    uint64_t TimeMs;
+};
+
 enum EStorageType {
     Place,
     Layer,
@@ -45,6 +54,7 @@ public:
     TError SetPrivate(const TString &text);
     TError SavePrivate(const TString &text);
     TError SaveChecksums();
+    TPath ImagePath();
 
     TError CreateMeta(uint64_t space_limit, uint64_t inode_limit);
     TError ResizeMeta(uint64_t space_limit, uint64_t inode_limit);
@@ -53,6 +63,18 @@ public:
     static void Init();
     static void IncPlaceLoad(const TPath &place);
     static void DecPlaceLoad(const TPath &place);
+    static bool TryIncPlaceLoad(const TPath &place);
+    static void ClaimPlaceLoad(const TPath &place);
+    static void ReleasePlaceLoadClaim();
+
+    static TError MoveToTrash(const TPath &place, const TPath &path);
+    static void StartTrashReaper();
+    static void StopTrashReaper();
+
+    static TError DedupLayer(const TPath &place, const TPath &layer, bool checksums = false);
+    static TError ReleaseContent(const TPath &place, const TPath &layer, bool unshare);
+    static void GetContentUsage(const TPath &place, uint64_t &files, uint64_t &bytes);
+    static void ListImports(const TPath &place, std::list<TImportProgress> &list);
 
 private:
     static TError Cleanup(const TPath &place, EStorageType type, unsigned perms);
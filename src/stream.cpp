@@ -1,8 +1,16 @@
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
 #include "stream.hpp"
 #include "config.hpp"
 #include "util/log.hpp"
 #include "client.hpp"
 #include "container.hpp"
+#include "rpc.pb.h"
 
 extern "C" {
 #include <sys/ioctl.h>
@@ -147,11 +155,32 @@ TError TStdStream::Remove(const TContainer &container) {
     return error;
 }
 
+/* Followers of stdout/stderr, also serializes rotation with them */
+struct TFollower {
+    std::weak_ptr<TClient> Client;
+    std::weak_ptr<TContainer> Container;
+    TString Name;
+    int Stream;
+    TFile File;
+    uint64_t Pos;       /* in file */
+    uint64_t Base;      /* stream offset of file start */
+    uint64_t Chunk;
+    uint64_t Tag;
+    bool Done = false;  /* under FollowMutex */
+};
+
+static std::mutex FollowMutex;
+static std::condition_variable FollowCv;
+static std::list<std::shared_ptr<TFollower>> Followers;
+static std::thread FollowThread;
+static std::atomic<bool> FollowStop;
+
 TError TStdStream::Rotate(const TContainer &container) {
     TPath path = ResolveOutside(container);
     if (path.IsEmpty() || !path.IsRegularStrict())
         return OK;
     off_t loss;
+    std::lock_guard<std::mutex> lock(FollowMutex);
     TError error = path.RotateLog(Limit, loss);
     if (error) {
         Statistics->LogRotateErrors++;
@@ -162,6 +191,140 @@ TError TStdStream::Rotate(const TContainer &container) {
     return OK;
 }
 
+/* Rotation checks ordered by due time, stale entries are skipped by generation */
+struct TRotateCheck {
+    std::weak_ptr<TContainer> Container;
+    int Stream;
+    uint64_t Gen;
+};
+
+static constexpr uint64_t ROTATE_IDLE_INTERVALS = 4;
+
+static std::mutex RotateMutex;
+static std::multimap<uint64_t, TRotateCheck> RotateIndex;
+static uint64_t RotateSeq = 0;
+
+void TStdStream::WatchRotation(std::shared_ptr<TContainer> container) {
+    uint64_t interval = std::max(config().daemon().log_rotate_ms(), (uint64_t)1);
+    auto now = GetCurrentTimeMs();
+
+    std::lock_guard<std::mutex> lock(RotateMutex);
+    for (auto stream: {&container->Stdout, &container->Stderr}) {
+        stream->RotateGen = ++RotateSeq;
+        stream->LogReopen = true;
+        /* spread first checks over interval */
+        RotateIndex.emplace(now + interval + RotateSeq % interval,
+                            TRotateCheck{container, stream == &container->Stdout ? 1 : 2,
+                                         stream->RotateGen});
+    }
+}
+
+void TStdStream::UnwatchRotation(TContainer &container) {
+    std::lock_guard<std::mutex> lock(RotateMutex);
+    for (auto stream: {&container.Stdout, &container.Stderr}) {
+        stream->RotateGen = ++RotateSeq;
+        stream->LogFile.Close();
+    }
+}
+
+TError TStdStream::CheckRotation(const TContainer &container, bool reopen, bool &rotated) {
+    struct stat st;
+    TError error;
+
+    rotated = false;
+
+    if (reopen || !LogFile || LogFile.Stat(st) || !st.st_nlink) {
+        LogFile.Close();
+        TPath path = ResolveOutside(container);
+        if (path.IsEmpty() || !path.IsRegularStrict())
+            return OK;
+        error = LogFile.Open(path, O_RDWR | O_CLOEXEC | O_NOCTTY | O_NOFOLLOW);
+        if (!error)
+            error = LogFile.Stat(st);
+        if (error) {
+            LogFile.Close();
+            return error;
+        }
+    }
+
+    LogUsage = st.st_blocks * 512;
+    if (LogUsage <= Limit)
+        return OK;
+
+    off_t loss;
+    std::lock_guard<std::mutex> lock(FollowMutex);
+    error = LogFile.RotateLog(Limit, loss);
+    if (error) {
+        Statistics->LogRotateErrors++;
+        return error;
+    }
+    Statistics->LogRotateBytes += loss;
+    Offset += loss;
+    LogUsage = 0;
+    rotated = true;
+    return OK;
+}
+
+void TStdStream::RotateLogs() {
+    uint64_t interval = std::max(config().daemon().log_rotate_ms(), (uint64_t)1);
+    auto now = GetCurrentTimeMs();
+    std::vector<TRotateCheck> due;
+
+    {
+        std::lock_guard<std::mutex> lock(RotateMutex);
+        while (!RotateIndex.empty() && RotateIndex.begin()->first <= now) {
+            due.push_back(RotateIndex.begin()->second);
+            RotateIndex.erase(RotateIndex.begin());
+        }
+        Statistics->LogRotateWatched = RotateIndex.size() + due.size();
+    }
+
+    for (auto &check: due) {
+        auto ct = check.Container.lock();
+        if (!ct)
+            continue;
+
+        auto &stream = check.Stream == 1 ? ct->Stdout : ct->Stderr;
+
+        /* serialize with UnwatchRotation which closes log file */
+        std::lock_guard<std::mutex> lock(RotateMutex);
+        if (stream.RotateGen != check.Gen)
+            continue;
+
+        bool reopen = stream.LogReopen;
+        stream.LogReopen = false;
+
+        if (ct->State != EContainerState::Running &&
+                ct->State != EContainerState::Paused) {
+            stream.LogFile.Close();
+            continue;
+        }
+
+        uint64_t prevUsage = stream.LogUsage;
+        uint64_t prevMs = stream.LogCheckMs;
+        bool rotated;
+
+        Statistics->LogRotateChecks++;
+
+        TError error = stream.CheckRotation(*ct, reopen, rotated);
+        if (error)
+            L_WRN("Cannot rotate {} of CT{}:{}: {}", check.Stream == 1 ? "stdout" : "stderr",
+                  ct->Id, ct->Name, error);
+
+        /* next check when stream could cross half of limit */
+        uint64_t delay = interval * ROTATE_IDLE_INTERVALS + check.Gen % interval;
+        if (rotated || reopen || stream.LogUsage >= stream.Limit / 2) {
+            delay = interval;
+        } else if (prevMs && now > prevMs && stream.LogUsage > prevUsage) {
+            uint64_t rate = (stream.LogUsage - prevUsage) / (now - prevMs) + 1;
+            delay = std::min(std::max((stream.Limit / 2 - stream.LogUsage) / rate, interval), delay);
+        }
+        stream.LogCheckMs = now;
+
+        RotateIndex.emplace(now + delay, check);
+    }
+}
+
 TError TStdStream::Read(const TContainer &container, TString &text,
                         const TString &range) const {
     TString off = "", lim = "";
@@ -234,3 +397,242 @@ TError TStdStream::Read(const TContainer &container, TString &text,
 
     return OK;
 }
+
+TError TStdStream::Follow(std::shared_ptr<TContainer> container,
+                          std::shared_ptr<TClient> client, const TString &name,
+                          bool has_offset, uint64_t offset, uint64_t chunk, uint64_t tag) {
+    TPath path = ResolveOutside(*container);
+    TError error;
+
+    if (path.IsEmpty())
+        return TError(EError::InvalidData, "Data not available");
+    if (!path.Exists())
+        return TError(EError::InvalidData, "File not found");
+    if (!path.IsRegularStrict())
+        return TError(EError::InvalidData, "File is non-regular");
+
+    auto follower = std::make_shared<TFollower>();
+
+    error = follower->File.Open(path, O_RDONLY | O_NOCTTY | O_NOFOLLOW | O_CLOEXEC);
+    if (error)
+        return error;
+
+    if (follower->File.RealPath() != path)
+        return TError(EError::Permission, "Real path doesn't match: " + path.ToString());
+
+    follower->Client = client;
+    follower->Container = container;
+    follower->Name = name;
+    follower->Stream = Stream;
+    follower->Chunk = chunk;
+    follower->Tag = tag;
+
+    std::unique_lock<std::mutex> lock(FollowMutex);
+
+    follower->Base = Offset;
+
+    if (has_offset) {
+        if (offset < Offset)
+            return TError(EError::InvalidData, "Requested offset lower than current {}", Offset);
+        follower->Pos = offset - Offset;
+    } else {
+        struct stat st;
+        error = follower->File.Stat(st);
+        if (error)
+            return error;
+        follower->Pos = st.st_size;
+    }
+
+    auto prev = Followers.end();
+    uint64_t count = 0;
+
+    for (auto it = Followers.begin(); it != Followers.end(); ++it) {
+        auto &f = *it;
+        if (f->Client.lock() != client)
+            continue;
+        if (f->Name == name && f->Stream == Stream)
+            prev = it;
+        else
+            count++;
+    }
+
+    /* each follower keeps file open */
+    if (count >= config().daemon().max_follow_per_client())
+        return TError(EError::ResourceNotAvailable, "Too many followed streams: {}", count);
+
+    if (prev != Followers.end()) {
+        (*prev)->Done = true;
+        Followers.erase(prev);
+        Statistics->StreamFollowers--;
+    }
+
+    Followers.emplace_back(std::move(follower));
+    Statistics->StreamFollowers++;
+
+    lock.unlock();
+    FollowCv.notify_all();
+
+    return OK;
+}
+
+void TStdStream::Unfollow(const TClient &client, const TString &name, int stream) {
+    std::lock_guard<std::mutex> lock(FollowMutex);
+    for (auto it = Followers.begin(); it != Followers.end(); ++it) {
+        auto &f = *it;
+        if (f->Client.lock().get() == &client && f->Name == name && f->Stream == stream) {
+            f->Done = true;
+            Followers.erase(it);
+            Statistics->StreamFollowers--;
+            break;
+        }
+    }
+}
+
+/*
+ * Called without FollowMutex, only follower thread changes position.
+ * Lock is taken only to sync with rotation, reading and sending are
+ * done outside. Returns false when follower is done.
+ */
+static bool FollowStream(TFollower &f, bool &more) {
+    auto client = f.Client.lock();
+    if (!client || client->Fd < 0)
+        return false;
+
+    rpc::TPortoResponse rsp;
+    rsp.set_error(EError::Success);
+    if (f.Tag)
+        rsp.set_tag(f.Tag);
+    auto data = rsp.mutable_followstream();
+    data->set_name(f.Name);
+    data->set_stream(f.Stream == 1 ? "stdout" : "stderr");
+
+    auto ct = f.Container.lock();
+    auto stream = ct ? (f.Stream == 1 ? &ct->Stdout : &ct->Stderr) : nullptr;
+    uint64_t base;
+    struct stat st;
+
+    std::unique_lock<std::mutex> lock(FollowMutex);
+
+    if (f.Done)
+        return false;
+
+    if (!ct || f.File.Stat(st)) {
+        lock.unlock();
+        data->set_end(true);
+        (void)client->PushResponse(rsp);
+        return false;
+    }
+
+    /* head of file was cut by rotation */
+    if (stream->Offset != f.Base) {
+        uint64_t loss = stream->Offset - f.Base;
+        f.Pos = f.Pos > loss ? f.Pos - loss : 0;
+        f.Base = stream->Offset;
+    }
+    base = f.Base;
+
+    lock.unlock();
+
+    if ((uint64_t)st.st_size < f.Pos)
+        f.Pos = st.st_size;
+
+    if ((uint64_t)st.st_size == f.Pos) {
+        /* file removed at stop and fully read */
+        if (!st.st_nlink) {
+            data->set_end(true);
+            (void)client->PushResponse(rsp);
+            return false;
+        }
+        return true;
+    }
+
+    /* client does not read */
+    if (client->SendPending() >= f.Chunk)
+        return true;
+
+    uint64_t len = std::min((uint64_t)st.st_size - f.Pos, f.Chunk);
+    TString buf(len, '\0');
+    ssize_t ret = pread(f.File.Fd, &buf[0], len, f.Pos);
+    if (ret < 0) {
+        L_WRN("Cannot read {}: {}", f.Name, TError::System("pread"));
+        data->set_end(true);
+        (void)client->PushResponse(rsp);
+        return false;
+    }
+    buf.resize(ret);
+
+    /* data was shifted by rotation while reading, retry at next pass */
+    lock.lock();
+    if (f.Done)
+        return false;
+    if (stream->Offset != base) {
+        more = true;
+        return true;
+    }
+    lock.unlock();
+
+    data->set_offset(f.Base + f.Pos);
+    data->set_data(buf);
+    f.Pos += ret;
+
+    Statistics->StreamFollowBytes += ret;
+
+    if (f.Pos < (uint64_t)st.st_size)
+        more = true;
+
+    (void)client->PushResponse(rsp);
+    return true;
+}
+
+static void Follower() {
+    uint64_t interval = config().daemon().follow_interval_ms();
+    std::vector<std::shared_ptr<TFollower>> pass, done;
+
+    SetProcessName("portod-SF");
+
+    std::unique_lock<std::mutex> lock(FollowMutex);
+    while (!FollowStop) {
+        bool more = false;
+
+        pass.assign(Followers.begin(), Followers.end());
+        lock.unlock();
+
+        for (auto &f: pass) {
+            if (!FollowStream(*f, more))
+                done.push_back(f);
+        }
+        pass.clear();
+
+        lock.lock();
+
+        for (auto &f: done) {
+            if (f->Done)
+                continue;
+            f->Done = true;
+            Followers.remove(f);
+            Statistics->StreamFollowers--;
+        }
+        done.clear();
+
+        if (!more)
+            FollowCv.wait_for(lock, std::chrono::milliseconds(interval),
+                              []{ return FollowStop.load(); });
+    }
+    Statistics->StreamFollowers -= Followers.size();
+    Followers.clear();
+}
+
+void TStdStream::StartFollower() {
+    FollowStop = false;
+    FollowThread = std::thread(Follower);
+}
+
+void TStdStream::StopFollower() {
+    if (!FollowThread.joinable())
+        return;
+    std::unique_lock<std::mutex> lock(FollowMutex);
+    FollowStop = true;
+    lock.unlock();
+    FollowCv.notify_all();
+    FollowThread.join();
+}
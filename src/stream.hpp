@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <util/path.hpp>
 
@@ -14,6 +15,13 @@ public:
     uint64_t Limit = 0;
     uint64_t Offset = 0;
 
+    /* rotation of running container, file is kept open between checks */
+    TFile LogFile;
+    uint64_t LogUsage = 0;
+    uint64_t LogCheckMs = 0;
+    uint64_t RotateGen = 0;
+    bool LogReopen = false;
+
     TStdStream(int stream): Stream(stream) { }
 
     void SetOutside(const TString &path) {
@@ -37,6 +45,29 @@ public:
     TError Remove(const TContainer &container);
 
     TError Rotate(const TContainer &container);
+
+    /*
+     * Rotation checks of running containers are indexed by time when
+     * stream could reach limit: growing streams are checked each
+     * log_rotate_ms, idle - few times less often.
+     */
+    static void WatchRotation(std::shared_ptr<TContainer> container);
+    /* closes kept log files, they must not hold volumes busy after stop */
+    static void UnwatchRotation(TContainer &container);
+    static void RotateLogs();
+    TError CheckRotation(const TContainer &container, bool reopen, bool &rotated);
     TError Read(const TContainer &container, TString &text,
                 const TString &range = "") const;
+
+    /*
+     * Keep file open and push new data to client, offset is absolute
+     * as for Read, by default follow from current end.
+     */
+    TError Follow(std::shared_ptr<TContainer> container,
+                  std::shared_ptr<TClient> client, const TString &name,
+                  bool has_offset, uint64_t offset, uint64_t chunk, uint64_t tag);
+    static void Unfollow(const TClient &client, const TString &name, int stream);
+
+    static void StartFollower();
+    static void StopFollower();
 };
@@ -701,6 +701,8 @@ TError TTaskEnv::Start() {
     if (error)
         goto kill_all;
 
+    CT->IndexTaskPids();
+
     /* Ack WPid */
     error = MasterSock.SendZero();
     if (error)
@@ -0,0 +1,397 @@
+#include <thread>
+
+#include "copy.hpp"
+#include "util/log.hpp"
+
+extern "C" {
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/xattr.h>
+#include <linux/fs.h>
+}
+
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+
+static ssize_t CopyFileRange(int fd_in, loff_t *off_in, int fd_out, loff_t *off_out, size_t len) {
+#ifdef __NR_copy_file_range
+    return syscall(__NR_copy_file_range, fd_in, off_in, fd_out, off_out, len, 0);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+TError TTreeCopy::Copy(const TPath &src, const TPath &dst) {
+    struct stat st;
+    TError error;
+
+    error = SrcRoot.OpenDirStrict(src);
+    if (error)
+        return error;
+
+    error = DstRoot.OpenDirStrict(dst);
+    if (error)
+        return error;
+
+    error = SrcRoot.Stat(st);
+    if (error)
+        return error;
+
+    RootDev = st.st_dev;
+
+    /* like "cp --no-target-directory" root attributes are copied too */
+    error = CopyAttrs(SrcRoot, DstRoot, st);
+    if (error)
+        return error;
+
+    DirTimes.emplace_back(TPath(), st);
+    Queue.push_back(TPath());
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < std::max(Threads, 1u); i++)
+        threads.emplace_back(&TTreeCopy::Worker, this);
+
+    for (auto &thread: threads)
+        thread.join();
+
+    if (Error)
+        return Error;
+
+    for (auto &it: DirTimes) {
+        struct timespec ts[2] = { it.second.st_atim, it.second.st_mtim };
+        int ret;
+
+        if (it.first)
+            ret = utimensat(DstRoot.Fd, it.first.c_str(), ts, AT_SYMLINK_NOFOLLOW);
+        else
+            ret = futimens(DstRoot.Fd, ts);
+        if (ret)
+            return TError::System("Cannot set times {}", it.first);
+    }
+
+    return OK;
+}
+
+void TTreeCopy::Worker() {
+    std::unique_lock<std::mutex> lock(Mutex);
+
+    while (true) {
+        Cond.wait(lock, [&]{ return !Queue.empty() || !Running || Error; });
+        if (Error || Queue.empty())
+            break;
+
+        TPath rel = Queue.front();
+        Queue.pop_front();
+        Running++;
+        lock.unlock();
+
+        TError error = CopyDirectory(rel);
+
+        lock.lock();
+        Running--;
+        if (error && !Error)
+            Error = error;
+        Cond.notify_all();
+    }
+}
+
+TError TTreeCopy::CopyDirectory(const TPath &rel) {
+    struct dirent *de;
+    TFile src, dst;
+    TError error;
+
+    error = src.OpenDirAllAt(SrcRoot, rel);
+    if (error)
+        return error;
+
+    error = dst.OpenDirAllAt(DstRoot, rel);
+    if (error)
+        return error;
+
+    int fd = fcntl(src.Fd, F_DUPFD_CLOEXEC, 3);
+    if (fd < 0)
+        return TError::System("Cannot dup fd {}", src.Fd);
+
+    DIR *dir = fdopendir(fd);
+    if (!dir) {
+        close(fd);
+        return TError::System("Cannot open directory {}", rel);
+    }
+
+    while ((de = readdir(dir))) {
+        struct stat st;
+
+        if (!strcmp(de->d_name, ".") || !strcmp(de->d_name, ".."))
+            continue;
+
+        if (fstatat(src.Fd, de->d_name, &st, AT_SYMLINK_NOFOLLOW)) {
+            error = TError::System("Cannot stat {} {}", rel, de->d_name);
+            break;
+        }
+
+        error = CopyEntry(src, dst, rel, de->d_name, st);
+        if (error)
+            break;
+    }
+
+    closedir(dir);
+
+    return error;
+}
+
+TError TTreeCopy::CopyEntry(const TFile &src, const TFile &dst, const TPath &rel,
+                            const TString &name, const struct stat &st) {
+    TPath path = rel ? rel / name : TPath(name);
+    TError error;
+
+    if (S_ISDIR(st.st_mode)) {
+        struct stat dst_st;
+        TFile sub_src, sub_dst;
+
+        if (!dst.StatAt(name, false, dst_st) && !S_ISDIR(dst_st.st_mode)) {
+            error = dst.UnlinkAt(name);
+            if (error)
+                return error;
+        }
+
+        if (mkdirat(dst.Fd, name.c_str(), 0700) && errno != EEXIST)
+            return TError::System("Cannot mkdirat {}", path);
+
+        error = sub_src.OpenDirStrictAt(src, name);
+        if (!error)
+            error = sub_dst.OpenDirStrictAt(dst, name);
+        if (!error)
+            error = CopyAttrs(sub_src, sub_dst, st);
+        if (error)
+            return error;
+
+        Directories++;
+
+        std::lock_guard<std::mutex> lock(Mutex);
+        DirTimes.emplace_back(path, st);
+        if (!OneFileSystem || st.st_dev == RootDev) {
+            Queue.push_back(path);
+            Cond.notify_one();
+        }
+        return OK;
+    }
+
+    if (unlinkat(dst.Fd, name.c_str(), 0) && errno != ENOENT)
+        return TError::System("Cannot replace {}", path);
+
+    if (S_ISREG(st.st_mode))
+        return CopyFile(src, dst, rel, name, st);
+
+    if (S_ISLNK(st.st_mode)) {
+        TPath target;
+
+        error = src.ReadlinkAt(name, target);
+        if (!error)
+            error = dst.SymlinkAt(name, target);
+        if (error)
+            return error;
+    } else if (mknodat(dst.Fd, name.c_str(), st.st_mode, st.st_rdev))
+        return TError::System("Cannot mknod {}", path);
+
+    if (fchownat(dst.Fd, name.c_str(), st.st_uid, st.st_gid, AT_SYMLINK_NOFOLLOW))
+        return TError::System("Cannot chown {}", path);
+
+    if (!S_ISLNK(st.st_mode) && fchmodat(dst.Fd, name.c_str(), st.st_mode & 07777, 0))
+        return TError::System("Cannot chmod {}", path);
+
+    struct timespec ts[2] = { st.st_atim, st.st_mtim };
+    if (utimensat(dst.Fd, name.c_str(), ts, AT_SYMLINK_NOFOLLOW))
+        return TError::System("Cannot set times {}", path);
+
+    Files++;
+
+    return OK;
+}
+
+TError TTreeCopy::CopyFile(const TFile &src, const TFile &dst, const TPath &rel,
+                           const TString &name, const struct stat &st) {
+    TPath path = rel ? rel / name : TPath(name);
+    TFile in, out;
+    TError error;
+
+    error = in.OpenAt(src, name, O_RDONLY | O_CLOEXEC | O_NOFOLLOW | O_NOCTTY);
+    if (error)
+        return error;
+
+    if (st.st_nlink > 1) {
+        std::unique_lock<std::mutex> lock(Mutex);
+        auto key = std::make_pair(st.st_dev, st.st_ino);
+        auto it = Links.find(key);
+        if (it != Links.end())
+            return dst.HardlinkAt(name, DstRoot, it->second);
+
+        /* create inode under lock, other links could be made at once */
+        error = out.OpenAt(dst, name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC | O_NOFOLLOW, 0600);
+        if (error)
+            return error;
+        Links[key] = path;
+    } else {
+        error = out.OpenAt(dst, name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC | O_NOFOLLOW, 0600);
+        if (error)
+            return error;
+    }
+
+    error = CopyData(in, out, st);
+    if (error)
+        return TError(error, "Cannot copy {}", path);
+
+    error = CopyAttrs(in, out, st);
+    if (error)
+        return error;
+
+    struct timespec ts[2] = { st.st_atim, st.st_mtim };
+    if (futimens(out.Fd, ts))
+        return TError::System("Cannot set times {}", path);
+
+    Files++;
+
+    return OK;
+}
+
+TError TTreeCopy::CopyData(const TFile &src, const TFile &dst, const struct stat &st) {
+    off_t size = st.st_size;
+
+    if (!size)
+        return OK;
+
+    if (!NoClone) {
+        if (!ioctl(dst.Fd, FICLONE, src.Fd)) {
+            Bytes += size;
+            ClonedBytes += size;
+            return OK;
+        }
+        if (errno != EOPNOTSUPP && errno != ENOTTY && errno != EXDEV &&
+                errno != EINVAL && errno != ENOSYS)
+            return TError::System("FICLONE");
+        NoClone = true;
+    }
+
+    TString buf;
+    off_t data = 0;
+    bool copyRange = !NoCopyRange;
+
+    while (data < size) {
+        off_t hole;
+
+        data = lseek(src.Fd, data, SEEK_DATA);
+        if (data < 0) {
+            if (errno == ENXIO)
+                break;  /* hole till the end */
+            if (errno != EINVAL)
+                return TError::System("lseek SEEK_DATA");
+            data = 0;   /* holes are not supported */
+            hole = size;
+        } else {
+            hole = lseek(src.Fd, data, SEEK_HOLE);
+            if (hole < 0 || hole > size)
+                hole = size;
+        }
+
+        loff_t in_off = data, out_off = data;
+        while (in_off < hole) {
+            ssize_t len = -1;
+
+            if (copyRange) {
+                len = CopyFileRange(src.Fd, &in_off, dst.Fd, &out_off, hole - in_off);
+                if (len < 0) {
+                    if (errno != ENOSYS && errno != EXDEV && errno != EINVAL &&
+                            errno != EOPNOTSUPP)
+                        return TError::System("copy_file_range");
+                    NoCopyRange = true;
+                    copyRange = false;
+                } else if (!len) {
+                    /* some filesystems return 0 for unsupported range, read rest of file */
+                    copyRange = false;
+                    len = -1;
+                }
+            }
+
+            if (len < 0) {
+                if (buf.empty())
+                    buf.resize(1 << 20);
+                len = pread(src.Fd, &buf[0], std::min((off_t)buf.size(), hole - in_off), in_off);
+                if (len < 0)
+                    return TError::System("read");
+                if (len && pwrite(dst.Fd, &buf[0], len, out_off) != len)
+                    return TError::System("write");
+                in_off += len;
+                out_off += len;
+            }
+
+            if (!len)
+                break;  /* file has been truncated, only read tells this */
+
+            Bytes += len;
+        }
+
+        data = hole;
+    }
+
+    /* trailing hole */
+    if (ftruncate(dst.Fd, size))
+        return TError::System("ftruncate");
+
+    return OK;
+}
+
+TError TTreeCopy::CopyXAttrs(const TFile &src, const TFile &dst) {
+    TString list, value;
+
+    ssize_t size = flistxattr(src.Fd, nullptr, 0);
+    if (size < 0) {
+        if (errno == ENOTSUP)
+            return OK;
+        return TError::System("listxattr");
+    }
+    if (!size)
+        return OK;
+
+    list.resize(size);
+    size = flistxattr(src.Fd, &list[0], size);
+    if (size < 0)
+        return TError::System("listxattr");
+    list.resize(size);
+
+    for (size_t pos = 0; pos < list.size(); pos += strlen(&list[pos]) + 1) {
+        TString name(&list[pos]);
+        TError error;
+
+        error = src.GetXAttr(name, value);
+        if (error) {
+            if (error.Errno == ENODATA)
+                continue;
+            return error;
+        }
+
+        /* like "cp --archive" ignore unsupported and forbidden xattrs */
+        (void)dst.SetXAttr(name, value);
+    }
+
+    return OK;
+}
+
+TError TTreeCopy::CopyAttrs(const TFile &src, const TFile &dst, const struct stat &st) {
+    TError error;
+
+    /* chown resets suid bits and capabilities, so it goes first */
+    error = dst.Chown(st.st_uid, st.st_gid);
+    if (error)
+        return error;
+
+    error = dst.Chmod(st.st_mode & 07777);
+    if (error)
+        return error;
+
+    return CopyXAttrs(src, dst);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "util/path.hpp"
+
+/*
+ * Parallel copy of directory tree, replacement for "cp --archive".
+ *
+ * Directories are distributed between workers, regular files are cloned
+ * with FICLONE if possible, otherwise copied with copy_file_range keeping
+ * holes. Owner, mode, timestamps, xattrs and hardlinks are preserved.
+ * Existing non-directory entries in destination are replaced.
+ */
+class TTreeCopy {
+public:
+    unsigned Threads = 1;
+    bool OneFileSystem = true;
+
+    std::atomic<uint64_t> Directories{0};
+    std::atomic<uint64_t> Files{0};
+    std::atomic<uint64_t> Bytes{0};
+    std::atomic<uint64_t> ClonedBytes{0};
+
+    TError Copy(const TPath &src, const TPath &dst);
+
+private:
+    TFile SrcRoot, DstRoot;
+    dev_t RootDev = 0;
+
+    std::mutex Mutex;
+    std::condition_variable Cond;
+    std::deque<TPath> Queue;
+    unsigned Running = 0;
+    TError Error;
+
+    /* directory timestamps are applied after all content is copied */
+    std::vector<std::pair<TPath, struct stat>> DirTimes;
+
+    /* first copy of multiply linked inodes */
+    std::map<std::pair<dev_t, ino_t>, TPath> Links;
+
+    std::atomic<bool> NoClone{false};
+    std::atomic<bool> NoCopyRange{false};
+
+    void Worker();
+    TError CopyDirectory(const TPath &rel);
+    TError CopyEntry(const TFile &src, const TFile &dst, const TPath &rel,
+                     const TString &name, const struct stat &st);
+    TError CopyFile(const TFile &src, const TFile &dst, const TPath &rel,
+                    const TString &name, const struct stat &st);
+    TError CopyData(const TFile &src, const TFile &dst, const struct stat &st);
+    TError CopyXAttrs(const TFile &src, const TFile &dst);
+    TError CopyAttrs(const TFile &src, const TFile &dst, const struct stat &st);
+};
@@ -66,6 +66,32 @@ struct TStatistics {
     std::atomic<uint64_t> NetworksCreated;
     std::atomic<uint64_t> NetworkProblems;
     std::atomic<uint64_t> NetworkRepairs;
+    std::atomic<uint64_t> ClientRecvCalls;
+    std::atomic<uint64_t> ClientSendCalls;
+    std::atomic<uint64_t> SamplerPasses;
+    std::atomic<uint64_t> SamplerTimeMs;
+    std::atomic<uint64_t> ChangeLogSize;
+    std::atomic<uint64_t> KeyValueAppends;
+    std::atomic<uint64_t> KeyValueRewrites;
+    std::atomic<uint64_t> RestoreContainersMs;
+    std::atomic<uint64_t> RestoreKeyValueMs;
+    std::atomic<uint64_t> RestoreNetworkUs;
+    std::atomic<uint64_t> RestoreCgroupsUs;
+    std::atomic<uint64_t> RestoreVolumesMs;
+    std::atomic<uint64_t> TrashQueued;
+    std::atomic<uint64_t> TrashRemoved;
+    std::atomic<uint64_t> LoopPoolHit;
+    std::atomic<uint64_t> LoopPoolMiss;
+    std::atomic<uint64_t> LoopPoolImages;
+    std::atomic<uint64_t> LayerDedupFiles;
+    std::atomic<uint64_t> LayerDedupBytes;
+    std::atomic<uint64_t> LayerImagesMounted;
+    std::atomic<uint64_t> VolumeUsageRefreshes;
+    std::atomic<uint64_t> VolumeUsageRefreshMs;
+    std::atomic<uint64_t> StreamFollowers;
+    std::atomic<uint64_t> StreamFollowBytes;
+    std::atomic<uint64_t> LogRotateWatched;
+    std::atomic<uint64_t> LogRotateChecks;
 
     /* --- add new fields at the end --- */
 };
@@ -84,6 +110,10 @@ static inline void ResetStatistics() {
     Statistics->RequestsQueued = 0;
     Statistics->NetworksCount = 0;
     Statistics->LongestRoRequest = 0;
+    Statistics->LoopPoolImages = 0;
+    Statistics->LayerImagesMounted = 0;
+    Statistics->StreamFollowers = 0;
+    Statistics->LogRotateWatched = 0;
 }
 
 template <typename... Args> inline void L_DBG(const char* fmt, const Args&... args) {
@@ -37,15 +37,6 @@
 
 #include "md5.hpp"
 
-/* Any 32-bit or wider unsigned integer data type will do */
-typedef unsigned int MD5_u32plus;
-
-typedef struct {
-    MD5_u32plus lo, hi;
-    MD5_u32plus a, b, c, d;
-    unsigned char buffer[64];
-    MD5_u32plus block[16];
-} MD5_CTX;
 
 /*
  * The basic MD5 functions.
@@ -294,24 +285,37 @@ static void MD5_Final(unsigned char *result, MD5_CTX *ctx)
     memset(ctx, 0, sizeof(*ctx));
 }
 
-TError Md5Sum(TFile &file, TString &sum) {
-    MD5_CTX ctx;
+TMd5::TMd5() {
+    MD5_Init(&Ctx);
+}
+
+void TMd5::Update(const void *data, size_t size) {
+    MD5_Update(&Ctx, data, size);
+}
+
+TString TMd5::Digest() {
     unsigned char bin[16];
+    TString sum;
+
+    MD5_Final(bin, &Ctx);
+    for (int i = 0; i < 16; ++i)
+        sum += fmt::format("{:02x}", bin[i]);
+    return sum;
+}
+
+TError Md5Sum(TFile &file, TString &sum) {
     TString buf;
     TError error;
+    TMd5 md5;
 
-    MD5_Init(&ctx);
     while (1) {
         error = file.Read(buf);
         if (error)
             return error;
         if (!buf.size())
             break;
-        MD5_Update(&ctx, buf.c_str(), buf.size());
+        md5.Update(buf.c_str(), buf.size());
     }
-    MD5_Final(bin, &ctx);
-    sum = "";
-    for (int i = 0; i < 16; ++i)
-        sum += fmt::format("{:02x}", bin[i]);
+    sum = md5.Digest();
     return OK;
 }
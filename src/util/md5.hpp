@@ -2,4 +2,25 @@
 
 #include "util/path.hpp"
 
+/* Any 32-bit or wider unsigned integer data type will do */
+typedef unsigned int MD5_u32plus;
+
+typedef struct {
+    MD5_u32plus lo, hi;
+    MD5_u32plus a, b, c, d;
+    unsigned char buffer[64];
+    MD5_u32plus block[16];
+} MD5_CTX;
+
+/* Incremental checksum, Digest() finalizes it */
+class TMd5 {
+public:
+    TMd5();
+    void Update(const void *data, size_t size);
+    TString Digest();
+
+private:
+    MD5_CTX Ctx;
+};
+
 TError Md5Sum(TFile &file, TString &sum);
@@ -644,38 +644,18 @@ TError TPath::Truncate(off_t size) const {
 }
 
 TError TPath::RotateLog(off_t max_disk_usage, off_t &loss) const {
-    struct stat st;
-    off_t hole_len;
+    TFile file;
     TError error;
 
-    int fd = open(c_str(), O_RDWR | O_CLOEXEC | O_NOCTTY);
-    if (fd < 0)
-        return TError::System("open(" + Path + ")");
-
-    if (fstat(fd, &st)) {
-        close(fd);
-        return TError::System("fstat(" + Path + ")");
-    }
-
-    if (!S_ISREG(st.st_mode) || (off_t)st.st_blocks * 512 <= max_disk_usage) {
-        loss = 0;
-        close(fd);
-        return OK;
-    }
-
-    /* Keep half of allowed size or trucate to zero */
-    hole_len = st.st_size - max_disk_usage / 2;
-    hole_len -= hole_len % st.st_blksize;
-    loss = hole_len;
+    error = file.Open(*this, O_RDWR | O_CLOEXEC | O_NOCTTY);
+    if (error)
+        return error;
 
-    if (fallocate(fd, FALLOC_FL_COLLAPSE_RANGE, 0, hole_len)) {
-        loss = st.st_size;
-        if (ftruncate(fd, 0))
-            error = TError::System("truncate(" + Path + ")");
-    }
+    error = file.RotateLog(max_disk_usage, loss);
+    if (error)
+        return TError(error, "Cannot rotate {}", Path);
 
-    close(fd);
-    return error;
+    return OK;
 }
 
 TError TPath::Chattr(unsigned add_flags, unsigned del_flags) const {
@@ -1307,6 +1287,30 @@ TError TFile::ReadAll(TString &text, size_t max) const {
     return OK;
 }
 
+/* Read from the beginning regardless of file position, file stays open */
+TError TFile::PreadAll(TString &text, size_t max) const {
+    size_t size = 4096, off = 0;
+    ssize_t ret;
+
+    text.resize(size);
+    do {
+        if (size - off < 1024) {
+            size += 16384;
+            if (size > max)
+                return TError("File too large: {}", size);
+            text.resize(size);
+        }
+        ret = pread(Fd, &text[off], size - off, off);
+        if (ret < 0)
+            return TError::System("pread");
+        off += ret;
+    } while (ret > 0);
+
+    text.resize(off);
+
+    return OK;
+}
+
 TError TFile::ReadEnds(TString &text, size_t max) const {
     ssize_t head = 0, tail, size;
     struct stat st;
@@ -1339,6 +1343,32 @@ TError TFile::Truncate(off_t size) const {
     return OK;
 }
 
+TError TFile::RotateLog(off_t max_disk_usage, off_t &loss) const {
+    struct stat st;
+    off_t hole_len;
+
+    loss = 0;
+
+    if (fstat(Fd, &st))
+        return TError::System("fstat");
+
+    if (!S_ISREG(st.st_mode) || (off_t)st.st_blocks * 512 <= max_disk_usage)
+        return OK;
+
+    /* Keep half of allowed size or trucate to zero */
+    hole_len = st.st_size - max_disk_usage / 2;
+    hole_len -= hole_len % st.st_blksize;
+    loss = hole_len;
+
+    if (fallocate(Fd, FALLOC_FL_COLLAPSE_RANGE, 0, hole_len)) {
+        loss = st.st_size;
+        if (ftruncate(Fd, 0))
+            return TError::System("ftruncate");
+    }
+
+    return OK;
+}
+
 TError TFile::WriteAll(const TString &text) const {
     size_t len = text.length(), off = 0;
     do {
@@ -262,8 +262,10 @@ public:
     TPath ProcPath(void) const;
     TError Read(TString &text) const;
     TError ReadAll(TString &text, size_t max) const;
+    TError PreadAll(TString &text, size_t max) const;
     TError ReadEnds(TString &text, size_t max) const;
     TError Truncate(off_t size) const;
+    TError RotateLog(off_t max_disk_usage, off_t &loss) const;
     TError WriteAll(const TString &text) const;
     static TError Chattr(int fd, unsigned add_flags, unsigned del_flags);
     int GetMountId(const TPath &relative = "") const;
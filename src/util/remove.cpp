@@ -0,0 +1,192 @@
+#include <thread>
+#include <vector>
+
+#include "remove.hpp"
+
+extern "C" {
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/stat.h>
+}
+
+TError TTreeRemove::Clear(const TPath &path) {
+    struct stat st;
+    TError error;
+
+    error = Root.OpenDirStrict(path);
+    if (error)
+        return error;
+
+    error = Root.Stat(st);
+    if (error)
+        return error;
+
+    RootDev = st.st_dev;
+
+    return ClearRoot();
+}
+
+TError TTreeRemove::Remove(const TPath &path) {
+    TPath normal = path.NormalPath();
+    TString name = normal.BaseName();
+    struct stat st;
+    TFile parent;
+    TError error;
+
+    error = parent.OpenDir(normal.DirName());
+    if (error)
+        return error.Errno == ENOENT ? OK : error;
+
+    error = parent.StatAt(name, false, st);
+    if (error)
+        return error.Errno == ENOENT ? OK : error;
+
+    if (!S_ISDIR(st.st_mode)) {
+        error = parent.UnlinkAt(name);
+        if (!error)
+            Files++;
+        return error;
+    }
+
+    error = Root.OpenDirStrictAt(parent, name);
+    if (error)
+        return error;
+
+    RootDev = st.st_dev;
+
+    error = ClearRoot();
+    if (error)
+        return error;
+
+    error = parent.RmdirAt(name);
+    if (!error)
+        Directories++;
+    return error;
+}
+
+TError TTreeRemove::ClearRoot() {
+    Queue.push_back(std::make_shared<TNode>());
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < std::max(Threads, 1u); i++)
+        threads.emplace_back(&TTreeRemove::Worker, this);
+
+    for (auto &thread: threads)
+        thread.join();
+
+    return Error;
+}
+
+void TTreeRemove::Worker() {
+    std::unique_lock<std::mutex> lock(Mutex);
+
+    while (true) {
+        Cond.wait(lock, [&]{ return !Queue.empty() || !Running; });
+        if (Queue.empty())
+            break;
+
+        auto node = Queue.front();
+        Queue.pop_front();
+        Running++;
+        lock.unlock();
+
+        /* like "rm -rf" continue after errors and report the first one */
+        TError error = ClearDirectory(node);
+        TError error2 = FinishDirectory(node);
+
+        lock.lock();
+        Running--;
+        if (!Error)
+            Error = error ? error : error2;
+        Cond.notify_all();
+    }
+}
+
+TError TTreeRemove::ClearDirectory(std::shared_ptr<TNode> &node) {
+    struct dirent *de;
+    TError error;
+    TFile dir;
+
+    error = dir.OpenDirAllAt(Root, node->Path);
+    if (error)
+        return error;
+
+    int fd = fcntl(dir.Fd, F_DUPFD_CLOEXEC, 3);
+    if (fd < 0)
+        return TError::System("Cannot dup fd {}", dir.Fd);
+
+    DIR *list = fdopendir(fd);
+    if (!list) {
+        close(fd);
+        return TError::System("Cannot open directory {}", node->Path);
+    }
+
+    while ((de = readdir(list))) {
+        bool is_dir = de->d_type == DT_DIR;
+        struct stat st;
+
+        if (!strcmp(de->d_name, ".") || !strcmp(de->d_name, ".."))
+            continue;
+
+        if (is_dir || de->d_type == DT_UNKNOWN) {
+            if (fstatat(dir.Fd, de->d_name, &st, AT_SYMLINK_NOFOLLOW)) {
+                if (errno != ENOENT && !error)
+                    error = TError::System("Cannot stat {} {}", node->Path, de->d_name);
+                continue;
+            }
+            is_dir = S_ISDIR(st.st_mode);
+            if (is_dir && OneFileSystem && st.st_dev != RootDev)
+                continue;
+        }
+
+        if (is_dir) {
+            auto child = std::make_shared<TNode>();
+
+            child->Parent = node;
+            child->Name = de->d_name;
+            child->Path = node->Path ? node->Path / child->Name : TPath(child->Name);
+
+            std::lock_guard<std::mutex> lock(Mutex);
+            node->Pending++;
+            Queue.push_back(child);
+            Cond.notify_one();
+        } else if (unlinkat(dir.Fd, de->d_name, 0)) {
+            if (errno != ENOENT && !error)
+                error = TError::System("Cannot unlinkat {} {}", node->Path, de->d_name);
+        } else
+            Files++;
+    }
+
+    closedir(list);
+
+    return error;
+}
+
+TError TTreeRemove::FinishDirectory(std::shared_ptr<TNode> node) {
+    TError result;
+
+    while (node->Parent) {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            if (--node->Pending)
+                return result;
+        }
+
+        TFile parent;
+        TError error = parent.OpenDirAllAt(Root, node->Parent->Path);
+        if (!error)
+            error = parent.RmdirAt(node->Name);
+        if (!error)
+            Directories++;
+        else if (!result)
+            result = error;
+
+        node = node->Parent;
+    }
+
+    std::lock_guard<std::mutex> lock(Mutex);
+    --node->Pending;
+
+    return result;
+}
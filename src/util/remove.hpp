@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+
+#include "util/path.hpp"
+
+/*
+ * Parallel recursive remove, replacement for "rm -rf" and "find -delete".
+ *
+ * Directories are distributed between workers, directory is removed by
+ * worker which drops last reference to it. All operations are relative
+ * to opened directories and never follow symlinks. Other filesystems
+ * are not crossed, their mountpoints are left in place.
+ */
+class TTreeRemove {
+public:
+    unsigned Threads = 1;
+    bool OneFileSystem = true;
+
+    std::atomic<uint64_t> Directories{0};
+    std::atomic<uint64_t> Files{0};
+
+    TError Clear(const TPath &path);
+    TError Remove(const TPath &path);
+
+private:
+    struct TNode {
+        std::shared_ptr<TNode> Parent;
+        TPath Path;
+        TString Name;
+        unsigned Pending = 1;
+    };
+
+    TFile Root;
+    dev_t RootDev = 0;
+
+    std::mutex Mutex;
+    std::condition_variable Cond;
+    std::deque<std::shared_ptr<TNode>> Queue;
+    unsigned Running = 0;
+    TError Error;
+
+    TError ClearRoot();
+    void Worker();
+    TError ClearDirectory(std::shared_ptr<TNode> &node);
+    TError FinishDirectory(std::shared_ptr<TNode> node);
+};
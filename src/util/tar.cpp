@@ -0,0 +1,790 @@
+#include <algorithm>
+#include <thread>
+
+#include "tar.hpp"
+#include "util/md5.hpp"
+#include "util/string.hpp"
+
+extern "C" {
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+}
+
+static constexpr size_t BLOCK = 512;
+static constexpr size_t CHUNK = 1 << 20;
+static constexpr uint64_t QUEUE_LIMIT = 64 << 20;
+static constexpr uint64_t META_LIMIT = 16 << 20;
+
+static uint64_t Padding(uint64_t size) {
+    return (BLOCK - size % BLOCK) % BLOCK;
+}
+
+static TString ParseString(const char *p, size_t len) {
+    return TString(p, strnlen(p, len));
+}
+
+static uint64_t ParseNumber(const char *p, size_t len) {
+    uint64_t val = 0;
+    size_t i = 0;
+
+    /* gnu base-256 encoding, negative values are not supported */
+    if ((unsigned char)p[0] & 0x80) {
+        val = (unsigned char)p[0] & 0x3f;
+        for (i = 1; i < len; i++)
+            val = (val << 8) | (unsigned char)p[i];
+        return val;
+    }
+
+    while (i < len && p[i] == ' ')
+        i++;
+    while (i < len && p[i] >= '0' && p[i] <= '7')
+        val = (val << 3) | (p[i++] - '0');
+
+    return val;
+}
+
+static bool CheckHeader(const char *header) {
+    uint64_t sum = ParseNumber(header + 148, 8);
+    uint64_t usum = 0;
+    int64_t ssum = 0;
+
+    /* old archivers used signed chars */
+    for (size_t i = 0; i < BLOCK; i++) {
+        char c = (i >= 148 && i < 156) ? ' ' : header[i];
+        usum += (unsigned char)c;
+        ssum += (signed char)c;
+    }
+
+    return sum == usum || (int64_t)sum == ssum;
+}
+
+static void ParseTime(const TString &text, struct timespec &ts) {
+    auto dot = text.find('.');
+
+    ts.tv_sec = strtoll(text.c_str(), nullptr, 10);
+    ts.tv_nsec = 0;
+    if (dot != TString::npos) {
+        TString frac = text.substr(dot + 1, 9);
+        frac.resize(9, '0');
+        ts.tv_nsec = strtol(frac.c_str(), nullptr, 10);
+    }
+}
+
+static void ParsePax(const TString &data, std::vector<std::pair<TString, TString>> &pax) {
+    size_t pos = 0;
+
+    /* "<length> <key>=<value>\n", length includes whole record */
+    while (pos < data.size()) {
+        auto sp = data.find(' ', pos);
+        if (sp == TString::npos)
+            break;
+        size_t len = strtoull(data.c_str() + pos, nullptr, 10);
+        if (len <= sp - pos || pos + len > data.size())
+            break;
+        auto eq = data.find('=', sp);
+        if (eq == TString::npos || eq >= pos + len)
+            break;
+        pax.emplace_back(data.substr(sp + 1, eq - sp - 1),
+                         data.substr(eq + 1, pos + len - eq - 2));
+        pos += len;
+    }
+}
+
+static TError NormalizeName(const TString &path, TString &result) {
+    size_t pos = 0;
+
+    result.clear();
+    while (pos <= path.size()) {
+        auto end = path.find('/', pos);
+        if (end == TString::npos)
+            end = path.size();
+        TString name = path.substr(pos, end - pos);
+        pos = end + 1;
+        if (name.empty() || name == ".")
+            continue;
+        if (name == "..")
+            return TError(EError::InvalidPath, "Unsafe path in archive: {}", path);
+        if (result.size())
+            result += "/";
+        result += name;
+    }
+
+    return OK;
+}
+
+/* like tar --xattrs-include */
+static bool XAttrAllowed(const TString &name) {
+    return name == "security.capability" ||
+           StringStartsWith(name, "trusted.overlay.") ||
+           StringStartsWith(name, "user.");
+}
+
+TError TTarExtract::Extract(const TFile &in, const TFile &dst) {
+    std::thread hasher;
+    TError error;
+
+    InFd = in.Fd;
+    Dst = &dst;
+    Buf.resize(CHUNK);
+
+    if (!ChecksumXAttr.empty())
+        hasher = std::thread(&TTarExtract::Hasher, this);
+
+    while (!error) {
+        TEntry entry;
+        bool end;
+
+        error = ReadHeader(entry, end);
+        if (error || end)
+            break;
+
+        error = ExtractEntry(entry);
+    }
+
+    /* consume trailing blocks, otherwise decompressor fails with EPIPE */
+    while (!error && !Eof) {
+        BufPos = BufLen;
+        error = Fill();
+    }
+
+    if (hasher.joinable()) {
+        std::unique_lock<std::mutex> lock(Mutex);
+        Finish = true;
+        Cond.notify_all();
+        lock.unlock();
+        hasher.join();
+        if (!error)
+            error = HashError;
+    }
+
+    if (error)
+        return error;
+
+    for (auto &it: DirTimes) {
+        struct timespec ts[2] = { it.second, it.second };
+        TFile dir;
+
+        error = dir.OpenDirAllAt(dst, it.first);
+        if (error) {
+            /* replaced by following entries */
+            if (error.Errno == ENOENT || error.Errno == ENOTDIR || error.Errno == ELOOP)
+                continue;
+            return error;
+        }
+        if (futimens(dir.Fd, ts))
+            return TError::System("Cannot set times {}", it.first);
+    }
+
+    return OK;
+}
+
+TError TTarExtract::Fill() {
+    while (BufPos == BufLen && !Eof) {
+        ssize_t len = read(InFd, &Buf[0], Buf.size());
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            return TError::System("Cannot read archive");
+        }
+        BufPos = 0;
+        BufLen = len;
+        Eof = !len;
+    }
+    return OK;
+}
+
+TError TTarExtract::Read(void *data, size_t size) {
+    char *ptr = (char *)data;
+    TError error;
+
+    while (size) {
+        error = Fill();
+        if (error)
+            return error;
+        if (BufPos == BufLen)
+            return TError(EError::InvalidData, "Unexpected end of archive");
+        size_t len = std::min(size, BufLen - BufPos);
+        if (ptr) {
+            memcpy(ptr, &Buf[BufPos], len);
+            ptr += len;
+        }
+        BufPos += len;
+        size -= len;
+    }
+
+    return OK;
+}
+
+TError TTarExtract::Skip(uint64_t size) {
+    TError error;
+
+    while (size && !error) {
+        size_t len = std::min(size, (uint64_t)CHUNK);
+        error = Read(nullptr, len);
+        size -= len;
+    }
+
+    return error;
+}
+
+TError TTarExtract::ReadData(uint64_t size, TString &data) {
+    TError error;
+
+    if (size > META_LIMIT)
+        return TError(EError::InvalidData, "Too big tar metadata entry: {}", size);
+
+    data.resize(size);
+    error = Read(&data[0], size);
+    if (!error)
+        error = Skip(Padding(size));
+    return error;
+}
+
+TError TTarExtract::ReadHeader(TEntry &entry, bool &end) {
+    std::vector<std::pair<TString, TString>> pax;
+    TString long_name, long_link, data;
+    char header[BLOCK];
+    char type;
+    TError error;
+
+    end = false;
+
+    while (1) {
+        error = Fill();
+        if (error)
+            return error;
+
+        /* like tar accept archive without end-of-archive blocks */
+        if (BufPos == BufLen) {
+            end = true;
+            return OK;
+        }
+
+        error = Read(header, BLOCK);
+        if (error)
+            return error;
+
+        if (std::all_of(header, header + BLOCK, [](char c) { return !c; })) {
+            end = true;
+            return OK;
+        }
+
+        /* compressed stream or unknown format, leave it to tar */
+        if (!CheckHeader(header))
+            return TError(EError::NotSupported, "Invalid tar header checksum");
+        if (header[257] && memcmp(header + 257, "ustar", 5))
+            return TError(EError::NotSupported, "Unknown tar header magic");
+
+        type = header[156];
+        uint64_t size = ParseNumber(header + 124, 12);
+
+        switch (type) {
+        case 'L':
+            error = ReadData(size, long_name);
+            long_name = ParseString(long_name.c_str(), long_name.size());
+            break;
+        case 'K':
+            error = ReadData(size, long_link);
+            long_link = ParseString(long_link.c_str(), long_link.size());
+            break;
+        case 'x':
+            error = ReadData(size, data);
+            ParsePax(data, pax);
+            break;
+        case 'g':
+            error = ReadData(size, data);
+            ParsePax(data, GlobalPax);
+            break;
+        case 'V':
+            error = Skip(size + Padding(size));
+            break;
+        case 'M':
+        case 'N':
+            return TError(EError::NotSupported, "Unsupported tar entry type {}", type);
+        default:
+            goto entry;
+        }
+
+        if (error)
+            return error;
+    }
+
+entry:
+    entry.Type = type;
+    if (!type || type == '7')
+        entry.Type = '0';
+
+    entry.Path = ParseString(header, 100);
+    if (!memcmp(header + 257, "ustar\0", 6) && header[345])
+        entry.Path = ParseString(header + 345, 155) + "/" + entry.Path;
+    entry.Link = ParseString(header + 157, 100);
+    entry.Mode = ParseNumber(header + 100, 8) & 07777;
+    entry.Uid = ParseNumber(header + 108, 8);
+    entry.Gid = ParseNumber(header + 116, 8);
+    entry.Size = ParseNumber(header + 124, 12);
+    entry.Mtime.tv_sec = ParseNumber(header + 136, 12);
+    entry.Dev = makedev(ParseNumber(header + 329, 8), ParseNumber(header + 337, 8));
+
+    if (type == 'S') {
+        error = ParseSparse(entry, header);
+        if (error)
+            return error;
+        entry.Type = '0';
+    }
+
+    if (long_name.size())
+        entry.Path = long_name;
+    if (long_link.size())
+        entry.Link = long_link;
+
+    TString sparse_name;
+    uint64_t sparse_offset = 0;
+    bool atime = false;
+
+    pax.insert(pax.begin(), GlobalPax.begin(), GlobalPax.end());
+
+    for (auto &it: pax) {
+        auto &key = it.first;
+        auto &val = it.second;
+
+        if (key == "path")
+            entry.Path = val;
+        else if (key == "linkpath")
+            entry.Link = val;
+        else if (key == "size")
+            entry.Size = strtoull(val.c_str(), nullptr, 10);
+        else if (key == "uid")
+            entry.Uid = strtoull(val.c_str(), nullptr, 10);
+        else if (key == "gid")
+            entry.Gid = strtoull(val.c_str(), nullptr, 10);
+        else if (key == "mtime")
+            ParseTime(val, entry.Mtime);
+        else if (key == "atime") {
+            ParseTime(val, entry.Atime);
+            atime = true;
+        } else if (StringStartsWith(key, "SCHILY.xattr."))
+            entry.XAttrs.emplace_back(key.substr(13), val);
+        else if (key == "GNU.sparse.name")
+            sparse_name = val;
+        else if (key == "GNU.sparse.size" || key == "GNU.sparse.realsize") {
+            entry.RealSize = strtoull(val.c_str(), nullptr, 10);
+            entry.Sparse = true;
+        } else if (key == "GNU.sparse.major")
+            entry.SparseInData = val == "1";
+        else if (key == "GNU.sparse.offset")
+            sparse_offset = strtoull(val.c_str(), nullptr, 10);
+        else if (key == "GNU.sparse.numbytes")
+            entry.SparseMap.emplace_back(sparse_offset, strtoull(val.c_str(), nullptr, 10));
+        else if (key == "GNU.sparse.map") {
+            auto list = SplitString(val, ',');
+            for (size_t i = 0; i + 1 < list.size(); i += 2)
+                entry.SparseMap.emplace_back(strtoull(list[i].c_str(), nullptr, 10),
+                                             strtoull(list[i + 1].c_str(), nullptr, 10));
+        }
+    }
+
+    if (sparse_name.size())
+        entry.Path = sparse_name;
+
+    if (entry.SparseInData)
+        entry.Sparse = true;
+
+    if (!atime)
+        entry.Atime = entry.Mtime;
+
+    return OK;
+}
+
+TError TTarExtract::ParseSparse(TEntry &entry, const char *header) {
+    char block[BLOCK];
+    TError error;
+
+    /* old gnu format: map in header and extension blocks */
+    for (int i = 0; i < 4; i++) {
+        const char *p = header + 386 + i * 24;
+        if (!p[0])
+            break;
+        entry.SparseMap.emplace_back(ParseNumber(p, 12), ParseNumber(p + 12, 12));
+    }
+
+    bool extended = header[482];
+    entry.RealSize = ParseNumber(header + 483, 12);
+    entry.Sparse = true;
+
+    while (extended) {
+        error = Read(block, BLOCK);
+        if (error)
+            return error;
+        for (int i = 0; i < 21; i++) {
+            const char *p = block + i * 24;
+            if (!p[0])
+                break;
+            entry.SparseMap.emplace_back(ParseNumber(p, 12), ParseNumber(p + 12, 12));
+        }
+        extended = block[504];
+    }
+
+    return OK;
+}
+
+TError TTarExtract::ReadSparseMap(TEntry &entry) {
+    char block[BLOCK];
+    uint64_t used = 0, count, offset, length;
+    TString text;
+    TError error;
+
+    /* format 1.0: decimal numbers at start of data padded to block */
+    auto next = [&](uint64_t &val) -> TError {
+        size_t pos;
+        while ((pos = text.find('\n')) == TString::npos) {
+            if (used + BLOCK > entry.Size)
+                return TError(EError::InvalidData, "Invalid sparse map");
+            TError error = Read(block, BLOCK);
+            if (error)
+                return error;
+            used += BLOCK;
+            text.append(block, BLOCK);
+        }
+        val = strtoull(text.c_str(), nullptr, 10);
+        text.erase(0, pos + 1);
+        return OK;
+    };
+
+    error = next(count);
+    for (uint64_t i = 0; !error && i < count; i++) {
+        error = next(offset);
+        if (!error)
+            error = next(length);
+        if (!error)
+            entry.SparseMap.emplace_back(offset, length);
+    }
+
+    entry.Size -= used;
+
+    return error;
+}
+
+TError TTarExtract::OpenParent(const TString &path, TString &name) {
+    auto sep = path.rfind('/');
+    TPath dir;
+    TError error;
+
+    if (sep == TString::npos) {
+        name = path;
+    } else {
+        dir = path.substr(0, sep);
+        name = path.substr(sep + 1);
+    }
+
+    if (Parent && ParentPath == dir)
+        return OK;
+
+    /* like tar create missing directories, symlinks are not followed */
+    error = Parent.CreateDirAllAt(*Dst, dir, 0755, TCred(0, 0));
+    if (error)
+        return error;
+
+    ParentPath = dir;
+    return OK;
+}
+
+TError TTarExtract::PrepareEntry(const TString &name, bool directory) {
+    struct stat st;
+
+    if (Parent.StatAt(name, false, st))
+        return OK;
+
+    if (S_ISDIR(st.st_mode))
+        return directory ? OK : Parent.RmdirAt(name);
+
+    return Parent.UnlinkAt(name);
+}
+
+TError TTarExtract::SetAttrs(const TFile &file, const TEntry &entry) {
+    TError error;
+
+    /* chown resets suid bits and capabilities, so it goes first */
+    error = file.Chown(entry.Uid, entry.Gid);
+    if (error)
+        return error;
+
+    error = file.Chmod(entry.Mode);
+    if (error)
+        return error;
+
+    /* like tar only warn about unsupported and forbidden xattrs */
+    for (auto &it: entry.XAttrs)
+        if (XAttrAllowed(it.first))
+            (void)file.SetXAttr(it.first, it.second);
+
+    return OK;
+}
+
+TError TTarExtract::ExtractEntry(TEntry &entry) {
+    TString path, name;
+    TError error;
+
+    error = NormalizeName(entry.Path, path);
+    if (error)
+        return error;
+
+    if (path.empty()) {
+        /* archive root */
+        if (entry.Type == '5') {
+            error = SetAttrs(*Dst, entry);
+            if (error)
+                return error;
+            DirTimes.emplace_back(TPath(), entry.Mtime);
+        }
+        return Skip(entry.Size + Padding(entry.Size));
+    }
+
+    error = OpenParent(path, name);
+    if (error)
+        return error;
+
+    switch (entry.Type) {
+    case '5':
+    case 'D':
+    {
+        TFile dir;
+
+        error = PrepareEntry(name, true);
+        if (error)
+            return error;
+
+        if (mkdirat(Parent.Fd, name.c_str(), 0700) && errno != EEXIST)
+            return TError::System("Cannot mkdirat {}", path);
+
+        error = dir.OpenDirStrictAt(Parent, name);
+        if (!error)
+            error = SetAttrs(dir, entry);
+        if (error)
+            return error;
+
+        DirTimes.emplace_back(path, entry.Mtime);
+        break;
+    }
+    case '1':
+    {
+        TString target, target_name;
+        TFile target_dir;
+
+        error = NormalizeName(entry.Link, target);
+        if (error)
+            return error;
+
+        if (target == path)
+            break;
+
+        auto sep = target.rfind('/');
+        if (sep == TString::npos) {
+            error = target_dir.Dup(*Dst);
+            target_name = target;
+        } else {
+            error = target_dir.OpenDirAllAt(*Dst, target.substr(0, sep));
+            target_name = target.substr(sep + 1);
+        }
+        if (!error)
+            error = PrepareEntry(name, false);
+        if (!error)
+            error = Parent.HardlinkAt(name, target_dir, target_name);
+        if (error)
+            return error;
+        break;
+    }
+    case '2':
+    {
+        struct timespec ts[2] = { entry.Atime, entry.Mtime };
+
+        error = PrepareEntry(name, false);
+        if (!error)
+            error = Parent.SymlinkAt(name, entry.Link);
+        if (!error)
+            error = Parent.ChownAt(name, entry.Uid, entry.Gid);
+        if (error)
+            return error;
+
+        if (utimensat(Parent.Fd, name.c_str(), ts, AT_SYMLINK_NOFOLLOW))
+            return TError::System("Cannot set times {}", path);
+        break;
+    }
+    case '3':
+    case '4':
+    case '6':
+    {
+        mode_t type = entry.Type == '3' ? S_IFCHR : entry.Type == '4' ? S_IFBLK : S_IFIFO;
+        struct timespec ts[2] = { entry.Atime, entry.Mtime };
+
+        error = PrepareEntry(name, false);
+        if (error)
+            return error;
+
+        /* overlayfs whiteouts are character devices 0:0 */
+        if (mknodat(Parent.Fd, name.c_str(), type | 0600, entry.Dev))
+            return TError::System("Cannot mknod {}", path);
+
+        error = Parent.ChownAt(name, entry.Uid, entry.Gid);
+        if (!error)
+            error = Parent.ChmodAt(name, entry.Mode);
+        if (error)
+            return error;
+
+        if (utimensat(Parent.Fd, name.c_str(), ts, AT_SYMLINK_NOFOLLOW))
+            return TError::System("Cannot set times {}", path);
+        break;
+    }
+    case '0':
+    default:
+        /* like tar extract unknown types as regular files */
+        Entries++;
+        return ExtractFile(entry, name);
+    }
+
+    Entries++;
+
+    return Skip(entry.Size + Padding(entry.Size));
+}
+
+TError TTarExtract::ExtractFile(TEntry &entry, const TString &name) {
+    auto file = std::make_shared<TFile>();
+    uint64_t stored = entry.Size;
+    uint64_t pos = 0;
+    TError error;
+
+    error = PrepareEntry(name, false);
+    if (error)
+        return error;
+
+    error = file->OpenAt(Parent, name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC | O_NOFOLLOW, 0600);
+    if (error)
+        return error;
+
+    if (entry.SparseInData) {
+        error = ReadSparseMap(entry);
+        if (error)
+            return error;
+    }
+
+    if (!entry.Sparse) {
+        entry.RealSize = entry.Size;
+        entry.SparseMap = {{0, entry.Size}};
+    }
+
+    uint64_t left = entry.Size;
+
+    for (auto &it: entry.SparseMap) {
+        uint64_t offset = it.first, length = it.second;
+
+        if (offset < pos || length > left)
+            return TError(EError::InvalidData, "Invalid sparse map of {}", entry.Path);
+
+        if (offset > pos) {
+            Hash(TChunk(file, nullptr, offset - pos));
+            pos = offset;
+        }
+
+        while (length) {
+            size_t len = std::min(length, (uint64_t)CHUNK);
+            auto data = std::make_shared<TString>(len, '\0');
+
+            error = Read(&(*data)[0], len);
+            if (error)
+                return error;
+
+            if (pwrite(file->Fd, data->c_str(), len, pos) != (ssize_t)len)
+                return TError::System("Cannot write {}", entry.Path);
+
+            Hash(TChunk(file, data));
+
+            pos += len;
+            length -= len;
+            left -= len;
+            Bytes += len;
+        }
+    }
+
+    if (left)
+        return TError(EError::InvalidData, "Invalid sparse map of {}", entry.Path);
+
+    error = Skip(Padding(stored));
+    if (error)
+        return error;
+
+    if (pos < entry.RealSize)
+        Hash(TChunk(file, nullptr, entry.RealSize - pos));
+
+    /* trailing hole */
+    if (ftruncate(file->Fd, entry.RealSize))
+        return TError::System("Cannot truncate {}", entry.Path);
+
+    error = SetAttrs(*file, entry);
+    if (error)
+        return error;
+
+    struct timespec ts[2] = { entry.Atime, entry.Mtime };
+    if (futimens(file->Fd, ts))
+        return TError::System("Cannot set times {}", entry.Path);
+
+    Hash(TChunk(file, nullptr, 0, true));
+
+    return OK;
+}
+
+void TTarExtract::Hash(const TChunk &chunk) {
+    if (ChecksumXAttr.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(Mutex);
+    Cond.wait(lock, [&]{ return QueueBytes < QUEUE_LIMIT; });
+    if (chunk.Data)
+        QueueBytes += chunk.Data->size();
+    Queue.push_back(chunk);
+    Cond.notify_all();
+}
+
+void TTarExtract::Hasher() {
+    std::unique_lock<std::mutex> lock(Mutex);
+    std::unique_ptr<TMd5> md5;
+    TString zeros;
+
+    while (1) {
+        Cond.wait(lock, [&]{ return !Queue.empty() || Finish; });
+        if (Queue.empty())
+            break;
+
+        TChunk chunk = Queue.front();
+        Queue.pop_front();
+        lock.unlock();
+
+        TError error;
+
+        if (!md5)
+            md5.reset(new TMd5());
+
+        if (chunk.Data)
+            md5->Update(chunk.Data->c_str(), chunk.Data->size());
+
+        for (uint64_t left = chunk.Zeros; left; ) {
+            if (zeros.empty())
+                zeros.resize(CHUNK, '\0');
+            size_t len = std::min(left, (uint64_t)zeros.size());
+            md5->Update(zeros.c_str(), len);
+            left -= len;
+        }
+
+        if (chunk.Last) {
+            error = chunk.File->SetXAttr(ChecksumXAttr, md5->Digest());
+            md5.reset();
+        }
+
+        lock.lock();
+        if (chunk.Data)
+            QueueBytes -= chunk.Data->size();
+        if (error && !HashError)
+            HashError = error;
+        Cond.notify_all();
+    }
+}
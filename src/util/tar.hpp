@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "util/path.hpp"
+
+/*
+ * In-process extraction of tar stream, replacement for "tar --extract
+ * --numeric-owner --preserve-permissions --xattrs".
+ *
+ * Supports ustar, gnu and pax formats: long names, hardlinks, devices,
+ * xattrs and all flavours of gnu sparse files. Entries are created by
+ * calling thread relative to destination and never follow symlinks.
+ * Checksums of regular files are computed by separate thread from the
+ * same buffers and saved into xattr ChecksumXAttr when it is set.
+ */
+class TTarExtract {
+public:
+    TString ChecksumXAttr;
+
+    std::atomic<uint64_t> Entries{0};
+    std::atomic<uint64_t> Bytes{0};
+
+    TError Extract(const TFile &in, const TFile &dst);
+
+private:
+    struct TEntry {
+        TString Path;
+        TString Link;
+        char Type = 0;
+        mode_t Mode = 0;
+        uid_t Uid = 0;
+        gid_t Gid = 0;
+        uint64_t Size = 0;          /* data in archive */
+        uint64_t RealSize = 0;      /* size of sparse file */
+        dev_t Dev = 0;
+        struct timespec Mtime = {0, 0};
+        struct timespec Atime = {0, 0};
+        bool Sparse = false;
+        bool SparseInData = false;  /* map is stored in data, format 1.0 */
+        std::vector<std::pair<uint64_t, uint64_t>> SparseMap;
+        std::vector<std::pair<TString, TString>> XAttrs;
+    };
+
+    struct TChunk {
+        std::shared_ptr<TFile> File;
+        std::shared_ptr<TString> Data;
+        uint64_t Zeros;
+        bool Last;
+
+        TChunk(std::shared_ptr<TFile> file, std::shared_ptr<TString> data,
+               uint64_t zeros = 0, bool last = false) :
+            File(file), Data(data), Zeros(zeros), Last(last) {}
+    };
+
+    const TFile *Dst = nullptr;
+
+    /* input stream */
+    int InFd = -1;
+    TString Buf;
+    size_t BufPos = 0, BufLen = 0;
+    bool Eof = false;
+
+    /* pax records applied to all following entries */
+    std::vector<std::pair<TString, TString>> GlobalPax;
+
+    /* parent directory of last entry */
+    TPath ParentPath;
+    TFile Parent;
+
+    /* directory timestamps are applied after all content is extracted */
+    std::vector<std::pair<TPath, struct timespec>> DirTimes;
+
+    /* checksum thread */
+    std::mutex Mutex;
+    std::condition_variable Cond;
+    std::deque<TChunk> Queue;
+    uint64_t QueueBytes = 0;
+    bool Finish = false;
+    TError HashError;
+
+    TError Fill();
+    TError Read(void *data, size_t size);
+    TError Skip(uint64_t size);
+    TError ReadData(uint64_t size, TString &data);
+
+    TError ReadHeader(TEntry &entry, bool &end);
+    TError ParseSparse(TEntry &entry, const char *header);
+    TError ReadSparseMap(TEntry &entry);
+
+    TError OpenParent(const TString &path, TString &name);
+    TError PrepareEntry(const TString &name, bool directory);
+    TError ExtractEntry(TEntry &entry);
+    TError ExtractFile(TEntry &entry, const TString &name);
+    TError SetAttrs(const TFile &file, const TEntry &entry);
+
+    void Hash(const TChunk &chunk);
+    void Hasher();
+};
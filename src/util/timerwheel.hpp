@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "common.hpp"
+
+/*
+ * Hierarchical timer wheel: insert and expire cost O(1) amortized instead
+ * of O(log n) for heap. Level L holds entries which differ from current
+ * tick only in bits of level L, they are moved one level down when wheel
+ * enters their slot. Entries beyond top level wait in overflow list.
+ * Expired entries are returned in order of due time, entries with equal
+ * due time - in order of insertion. Not thread safe.
+ */
+template <typename T>
+class TTimerWheel : public TPortoNonCopyable {
+    static constexpr int BITS = 6;
+    static constexpr uint64_t SLOTS = 1ull << BITS;
+    static constexpr int LEVELS = 5;
+
+    struct TEntry {
+        uint64_t DueMs;
+        T Value;
+    };
+
+    const uint64_t Resolution;      /* ms per tick */
+    uint64_t Now = 0;               /* current tick */
+    size_t Count = 0;
+    size_t LevelCount[LEVELS] = {};
+    std::vector<TEntry> Slots[LEVELS][SLOTS];
+    std::vector<TEntry> Overflow;
+    std::vector<TEntry> Expired;
+
+    void Place(TEntry &&entry) {
+        uint64_t tick = (entry.DueMs + Resolution - 1) / Resolution;
+
+        if (tick <= Now) {
+            Expired.push_back(std::move(entry));
+            return;
+        }
+
+        for (int level = 0; level < LEVELS; level++) {
+            int shift = BITS * (level + 1);
+            if ((tick >> shift) == (Now >> shift)) {
+                Slots[level][(tick >> (BITS * level)) & (SLOTS - 1)].push_back(std::move(entry));
+                LevelCount[level]++;
+                return;
+            }
+        }
+
+        Overflow.push_back(std::move(entry));
+    }
+
+    void Cascade(std::vector<TEntry> &list) {
+        std::vector<TEntry> moved;
+        moved.swap(list);
+        for (auto &entry: moved)
+            Place(std::move(entry));
+    }
+
+    template <typename F> void Fire(std::vector<TEntry> &list, const F &fn) {
+        if (list.empty())
+            return;
+        std::vector<TEntry> fired;
+        fired.swap(list);
+        std::stable_sort(fired.begin(), fired.end(), [](const TEntry &a, const TEntry &b) {
+            return a.DueMs < b.DueMs;
+        });
+        Count -= fired.size();
+        for (auto &entry: fired)
+            fn(std::move(entry.Value));
+    }
+
+    /* lowest level with entries, LEVELS if only overflow */
+    int LowestLevel() const {
+        int level = 0;
+        while (level < LEVELS && !LevelCount[level])
+            level++;
+        return level;
+    }
+
+public:
+    TTimerWheel(uint64_t resolutionMs = 1) : Resolution(resolutionMs ?: 1) {}
+
+    size_t Size() const {
+        return Count;
+    }
+
+    /* wheel must be advanced to current time before insert */
+    void Insert(uint64_t dueMs, const T &value) {
+        Place(TEntry{dueMs, value});
+        Count++;
+    }
+
+    /* time when next entry could expire, UINT64_MAX if empty */
+    uint64_t NextDueMs() const {
+        if (!Count)
+            return UINT64_MAX;
+        if (!Expired.empty())
+            return Now * Resolution;
+        if (LevelCount[0]) {
+            for (uint64_t slot = (Now & (SLOTS - 1)) + 1; slot < SLOTS; slot++)
+                if (!Slots[0][slot].empty())
+                    return ((Now & ~(SLOTS - 1)) + slot) * Resolution;
+        }
+        int shift = BITS * LowestLevel();
+        return (((Now >> shift) + 1) << shift) * Resolution;
+    }
+
+    /* expire entries with due time up to nowMs */
+    template <typename F> void Advance(uint64_t nowMs, const F &fn) {
+        uint64_t target = nowMs / Resolution;
+
+        Fire(Expired, fn);
+
+        while (Now < target) {
+            if (!Count) {
+                Now = target;
+                break;
+            }
+
+            /* skip ticks where nothing could expire */
+            int lowest = LowestLevel();
+            if (lowest) {
+                int shift = BITS * lowest;
+                uint64_t next = ((Now >> shift) + 1) << shift;
+                if (next > target) {
+                    Now = target;
+                    break;
+                }
+                Now = next - 1;
+            }
+
+            Now++;
+
+            if (!(Now & ((1ull << (BITS * LEVELS)) - 1)))
+                Cascade(Overflow);
+
+            for (int level = LEVELS - 1; level > 0; level--) {
+                if (Now & ((1ull << (BITS * level)) - 1))
+                    continue;
+                auto &slot = Slots[level][(Now >> (BITS * level)) & (SLOTS - 1)];
+                LevelCount[level] -= slot.size();
+                Cascade(slot);
+            }
+
+            auto &slot = Slots[0][Now & (SLOTS - 1)];
+            LevelCount[0] -= slot.size();
+            for (auto &entry: slot)
+                Expired.push_back(std::move(entry));
+            slot.clear();
+
+            Fire(Expired, fn);
+        }
+    }
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "common.hpp"
+#include "util/path.hpp"
+
+/*
+ * Index of values by path components: lookup of values attached to
+ * path itself, to its ancestors and to paths below it costs O(depth)
+ * instead of scan. Same value could be attached to several paths and
+ * to the same path several times. Paths expected to be normalized.
+ */
+template <typename T>
+class TPathTrie : public TPortoNonCopyable {
+    struct TNode {
+        std::map<TString, std::unique_ptr<TNode>> Children;
+        std::map<T, unsigned> Values;    /* value -> references */
+    };
+
+    TNode Root;
+    size_t Count = 0;
+
+    const TNode *Find(const TPath &path) const {
+        const TNode *node = &Root;
+        for (auto &name: path.Components()) {
+            auto it = node->Children.find(name);
+            if (it == node->Children.end())
+                return nullptr;
+            node = it->second.get();
+        }
+        return node;
+    }
+
+    template <typename F> static void Walk(const TNode *node, const F &fn) {
+        for (auto &it: node->Values)
+            fn(it.first);
+        for (auto &it: node->Children)
+            Walk(it.second.get(), fn);
+    }
+
+public:
+    TPathTrie() {}
+
+    size_t Size() const {
+        return Count;
+    }
+
+    void Insert(const TPath &path, const T &value) {
+        TNode *node = &Root;
+        for (auto &name: path.Components()) {
+            auto &child = node->Children[name];
+            if (!child)
+                child.reset(new TNode);
+            node = child.get();
+        }
+        auto it = node->Values.find(value);
+        if (it != node->Values.end())
+            it->second++;
+        else
+            node->Values.emplace(value, 1);
+        Count++;
+    }
+
+    bool Erase(const TPath &path, const T &value) {
+        std::vector<std::pair<TNode *, TString>> trace;
+        TNode *node = &Root;
+
+        for (auto &name: path.Components()) {
+            auto it = node->Children.find(name);
+            if (it == node->Children.end())
+                return false;
+            trace.emplace_back(node, name);
+            node = it->second.get();
+        }
+
+        auto it = node->Values.find(value);
+        if (it == node->Values.end())
+            return false;
+        if (!--it->second)
+            node->Values.erase(it);
+        Count--;
+
+        /* drop empty branch */
+        while (!trace.empty() && node->Values.empty() && node->Children.empty()) {
+            node = trace.back().first;
+            node->Children.erase(trace.back().second);
+            trace.pop_back();
+        }
+
+        return true;
+    }
+
+    /* values attached exactly to path */
+    template <typename F> void Exact(const TPath &path, const F &fn) const {
+        auto node = Find(path);
+        if (node)
+            for (auto &it: node->Values)
+                fn(it.first);
+    }
+
+    /* values attached to path and to paths above it, from root */
+    template <typename F> void Ancestors(const TPath &path, const F &fn) const {
+        const TNode *node = &Root;
+        for (auto &name: path.Components()) {
+            auto it = node->Children.find(name);
+            if (it == node->Children.end())
+                return;
+            node = it->second.get();
+            for (auto &val: node->Values)
+                fn(val.first);
+        }
+    }
+
+    /* values attached to path and to paths below it */
+    template <typename F> void Descendants(const TPath &path, const F &fn) const {
+        auto node = Find(path);
+        if (node)
+            Walk(node, fn);
+    }
+};
@@ -1,6 +1,7 @@
 #include <sstream>
 #include <algorithm>
 #include <condition_variable>
+#include <thread>
 
 #include "volume.hpp"
 #include "storage.hpp"
@@ -14,6 +15,9 @@
 #include "helpers.hpp"
 #include "client.hpp"
 #include "filesystem.hpp"
+#include "changelog.hpp"
+#include "rpc.hpp"
+#include "util/trie.hpp"
 
 extern "C" {
 #include <unistd.h>
@@ -33,6 +37,69 @@ std::map<TPath, std::shared_ptr<TVolume>> Volumes;
 std::map<TPath, std::shared_ptr<TVolumeLink>> VolumeLinks;
 static uint64_t NextId = 1;
 
+/* Indexes protected with VolumesMutex */
+static TPathTrie<const TVolumeLink *> VolumeLinkIndex;     /* VolumeLinks by host target */
+static TPathTrie<const TVolume *> VolumePathIndex;         /* path, storage, layers */
+static TPathTrie<const TVolume *> VolumePlaceIndex;
+static std::multimap<std::pair<dev_t, ino_t>, const TVolume *> LoopImageIndex;
+
+static void InsertVolumeLink(const std::shared_ptr<TVolumeLink> &link) {
+    auto &slot = VolumeLinks[link->HostTarget];
+    if (slot)
+        VolumeLinkIndex.Erase(link->HostTarget, slot.get());
+    slot = link;
+    VolumeLinkIndex.Insert(link->HostTarget, link.get());
+}
+
+static std::map<TPath, std::shared_ptr<TVolumeLink>>::iterator
+EraseVolumeLink(std::map<TPath, std::shared_ptr<TVolumeLink>>::iterator it) {
+    VolumeLinkIndex.Erase(it->first, it->second.get());
+    return VolumeLinks.erase(it);
+}
+
+static bool EraseVolumeLink(const TPath &path) {
+    auto it = VolumeLinks.find(path);
+    if (it == VolumeLinks.end())
+        return false;
+    EraseVolumeLink(it);
+    return true;
+}
+
+/* Link not mounted yet keeps host target in index to block conflicts */
+static bool IsVolumeLinkMounted(const TVolumeLink *link) {
+    auto it = VolumeLinks.find(link->HostTarget);
+    return it != VolumeLinks.end() && it->second.get() == link;
+}
+
+static void ReserveVolumeLink(const TVolumeLink *link) {
+    VolumeLinkIndex.Insert(link->HostTarget, link);
+}
+
+static void ReleaseVolumeLink(TVolumeLink *link) {
+    if (link->HostTarget && !IsVolumeLinkMounted(link)) {
+        VolumeLinkIndex.Erase(link->HostTarget, link);
+        link->HostTarget = "";
+    }
+}
+
+/* Container links keep order in list, index finds links of volume */
+
+static void AddContainerLink(TContainer &ct, const std::shared_ptr<TVolumeLink> &link) {
+    auto pos = ct.VolumeLinks.insert(ct.VolumeLinks.end(), link);
+    ct.VolumeLinkIndex.emplace(link->Volume.get(), pos);
+}
+
+static void DelContainerLink(TContainer &ct, const std::shared_ptr<TVolumeLink> &link) {
+    auto range = ct.VolumeLinkIndex.equal_range(link->Volume.get());
+    for (auto it = range.first; it != range.second; it++) {
+        if (*it->second == link) {
+            ct.VolumeLinks.erase(it->second);
+            ct.VolumeLinkIndex.erase(it);
+            return;
+        }
+    }
+}
+
 static std::condition_variable VolumesCv;
 
 /* TVolumeBackend - abstract */
@@ -499,8 +566,133 @@ TError PutLoopDev(const int loopNr) {
     return error;
 }
 
+/*
+ * Lazy layers: squashfs image place/porto_layers/_image_<name> is mounted
+ * at layer directory while any volume uses it. Loop device is autocleared
+ * at umount. Users are counted per layer path and recounted at restore.
+ */
+
+static std::mutex LayerImagesMutex;
+static std::map<TString, unsigned> LayerImageUsers;
+
+static TError MountLayerImage(const TPath &image, const TPath &path) {
+    struct loop_info64 info;
+    TFile file, loop;
+    TError error;
+    int nr;
+
+    error = file.OpenRead(image);
+    if (error)
+        return error;
+
+    error = SetupLoopDev(file, image, nr);
+    if (error)
+        return error;
+
+    error = path.Mount("/dev/loop" + std::to_string(nr), "squashfs",
+                       MS_RDONLY | MS_NODEV | MS_NOSUID, {});
+    if (!error)
+        error = path.Remount(MS_PRIVATE);
+    if (!error)
+        error = loop.OpenReadWrite("/dev/loop" + std::to_string(nr));
+    if (!error && ioctl(loop.Fd, LOOP_GET_STATUS64, &info) < 0)
+        error = TError::System("ioctl(LOOP_GET_STATUS64)");
+    if (!error) {
+        info.lo_flags |= LO_FLAGS_AUTOCLEAR;
+        if (ioctl(loop.Fd, LOOP_SET_STATUS64, &info) < 0)
+            error = TError::System("ioctl(LOOP_SET_STATUS64)");
+    }
+
+    if (error) {
+        (void)path.UmountAll();
+        (void)PutLoopDev(nr);
+        return error;
+    }
+
+    L_ACT("Mount layer image {} at {} loop {}", image, path, nr);
+
+    return OK;
+}
+
+TError TVolume::AcquireLayerImage(const TPath &image, const TPath &path) {
+    std::lock_guard<std::mutex> lock(LayerImagesMutex);
+    auto &users = LayerImageUsers[path.ToString()];
+
+    if (!users) {
+        /* after restart image could be already mounted */
+        if (path.GetDev() == path.DirName().GetDev()) {
+            TError error = MountLayerImage(image, path);
+            if (error) {
+                LayerImageUsers.erase(path.ToString());
+                return error;
+            }
+        }
+        Statistics->LayerImagesMounted++;
+    }
+
+    users++;
+
+    return OK;
+}
+
+void TVolume::ReleaseLayerImage(const TPath &path) {
+    std::lock_guard<std::mutex> lock(LayerImagesMutex);
+
+    auto it = LayerImageUsers.find(path.ToString());
+    if (it == LayerImageUsers.end() || --it->second)
+        return;
+
+    LayerImageUsers.erase(it);
+
+    L_ACT("Umount layer image at {}", path);
+    TError error = path.UmountAll();
+    if (error)
+        L_WRN("Cannot umount layer image {}: {}", path, error);
+    else
+        Statistics->LayerImagesMounted--;
+}
+
+bool TVolume::LayerImageBusy(const TPath &path) {
+    std::lock_guard<std::mutex> lock(LayerImagesMutex);
+    return LayerImageUsers.count(path.ToString());
+}
+
+TError TVolume::AcquireLayerImages() {
+    TError error;
+
+    for (auto &name: Layers) {
+        if (name[0] == '/')
+            continue;
+
+        TStorage layer;
+        layer.Open(EStorageType::Layer, Place, name);
+
+        TPath image = layer.ImagePath();
+        if (!image.IsRegularStrict())
+            continue;
+
+        error = AcquireLayerImage(image, layer.Path);
+        if (error)
+            return TError(error, "Cannot mount layer {}", name);
+
+        LayerImages.push_back(layer.Path);
+    }
+
+    return OK;
+}
+
+void TVolume::ReleaseLayerImages() {
+    for (auto &path: LayerImages)
+        ReleaseLayerImage(path);
+
+    LayerImages.clear();
+}
+
 /* TVolumeLoopBackend - ext4 image + loop device */
 
+static TError ClaimLoopImage(const TPath &place, uint64_t size,
+                             const TFile &dir, const TString &name);
+
 class TVolumeLoopBackend : public TVolumeBackend {
     static constexpr const char *AutoImage = "loop.img";
 
@@ -512,6 +704,20 @@ public:
         return storage / AutoImage;
     }
 
+    /* Images in use are indexed by inode for check in Configure */
+    void IndexImage(const struct stat &st) {
+        auto volumes_lock = LockVolumes();
+        Volume->ImageInode = {st.st_dev, st.st_ino};
+        LoopImageIndex.emplace(Volume->ImageInode, Volume);
+    }
+
+    TError Restore() override {
+        struct stat st;
+        if (!ImagePath(Volume->StoragePath).StatFollow(st))
+            IndexImage(st);
+        return OK;
+    }
+
     TError Configure() override {
         TPath image = ImagePath(Volume->StoragePath);
 
@@ -520,12 +726,12 @@ public:
                           "loop backend requires space_limit");
 
         /* Do not allow read-write loop share storage */
-        if (Volume->HaveStorage()) {
-            for (auto &it: Volumes) {
-                auto other = it.second;
-                if (other->BackendType != "loop" ||
-                        (other->IsReadOnly && Volume->IsReadOnly) ||
-                        !image.IsSameInode(ImagePath(other->StoragePath)))
+        struct stat st;
+        if (Volume->HaveStorage() && !image.StatFollow(st)) {
+            auto range = LoopImageIndex.equal_range({st.st_dev, st.st_ino});
+            for (auto it = range.first; it != range.second; it++) {
+                auto other = it->second;
+                if (other->IsReadOnly && Volume->IsReadOnly)
                     continue;
                 return TError(EError::Busy, "Storage already used by volume " + other->Path.ToString());
             }
@@ -610,6 +816,17 @@ public:
             error = file.OpenAt(Volume->StorageFd, AutoImage,
                                 (Volume->IsReadOnly ? O_RDONLY : O_RDWR) |
                                 O_CLOEXEC | O_NOCTTY | O_NOFOLLOW, 0);
+        } else if (!ClaimLoopImage(Volume->Place, Volume->SpaceLimit,
+                                   Volume->StorageFd, AutoImage)) {
+            Volume->KeepStorage = false; /* New storage */
+            error = file.OpenAt(Volume->StorageFd, AutoImage,
+                                O_RDWR | O_CLOEXEC | O_NOCTTY | O_NOFOLLOW, 0);
+            if (!error && Volume->SpaceGuarantee &&
+                    fallocate(file.Fd, FALLOC_FL_KEEP_SIZE, 0, Volume->SpaceGuarantee))
+                error = TError(EError::ResourceNotAvailable, errno,
+                               "cannot fallocate guarantee " + std::to_string(Volume->SpaceGuarantee));
+            if (error)
+                Volume->StorageFd.UnlinkAt(AutoImage);
         } else {
             error = file.OpenAt(Volume->StorageFd, AutoImage,
                                 O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
@@ -627,6 +844,8 @@ public:
         if (!S_ISREG(st.st_mode))
             return TError(EError::InvalidData, "loop image should be a regular file");
 
+        IndexImage(st);
+
         /* Protect image from concurrent changes */
         if (st.st_uid != RootUser || st.st_gid != RootGroup || (st.st_mode & 2)) {
             error = file.Chown(RootUser, RootGroup);
@@ -696,6 +915,183 @@ public:
     }
 };
 
+/*
+ * Pool of formatted sparse loop images: place/porto_loop_pool/<size>_<n>.img
+ * New loop volume claims image of matching size class by rename,
+ * pool is refilled in background by IO threads. Pool of default place
+ * is filled at start, others - since first claim.
+ */
+
+struct TLoopPool {
+    bool Loaded = false;
+    bool Refill = false;
+    std::map<uint64_t, std::vector<TString>> Images;
+};
+
+static std::mutex LoopPoolMutex;
+static std::map<TString, TLoopPool> LoopPools;
+static uint64_t LoopPoolCounter = 0;
+
+static std::vector<uint64_t> LoopPoolClasses() {
+    std::vector<uint64_t> classes;
+    for (auto &str: SplitEscapedString(config().volumes().loop_pool_classes(), ';')) {
+        uint64_t size;
+        if (!StringToSize(StringTrim(str), size) && size)
+            classes.push_back(size);
+    }
+    return classes;
+}
+
+static void LoadLoopPool(const TPath &place, TLoopPool &pool) {
+    TPath dir = place / PORTO_LOOP_POOL;
+    auto classes = LoopPoolClasses();
+    std::vector<TString> list;
+
+    pool.Loaded = true;
+
+    if (dir.ReadDirectory(list))
+        return;
+
+    for (auto &name: list) {
+        auto sep = name.find('_');
+        uint64_t size, index;
+
+        if (StringEndsWith(name, ".img") && sep != TString::npos &&
+                !StringToUint64(name.substr(0, sep), size) &&
+                !StringToUint64(name.substr(sep + 1, name.size() - sep - 5), index) &&
+                std::find(classes.begin(), classes.end(), size) != classes.end()) {
+            pool.Images[size].push_back(name);
+            Statistics->LoopPoolImages++;
+            /* refill must not reuse names of loaded images */
+            LoopPoolCounter = std::max(LoopPoolCounter, index + 1);
+        } else {
+            L_ACT("Remove stale loop image {}", dir / name);
+            (void)(dir / name).Unlink();
+        }
+    }
+}
+
+static void RefillLoopPool(const TPath &place) {
+    TPath dir = place / PORTO_LOOP_POOL;
+    unsigned target = config().volumes().loop_pool_size();
+    TFile dirFd;
+    TError error;
+
+    error = dir.Mkdir(0700);
+    if (!error || error.Errno == EEXIST)
+        error = dirFd.OpenDir(dir);
+
+    for (auto size: LoopPoolClasses()) {
+        while (!error) {
+            std::unique_lock<std::mutex> lock(LoopPoolMutex);
+            auto &pool = LoopPools[place.ToString()];
+            if (pool.Images[size].size() >= target)
+                break;
+            uint64_t index = LoopPoolCounter++;
+            lock.unlock();
+
+            TString name = fmt::format("{}_{}.img", size, index);
+            TString temp = fmt::format("tmp_{}", index);
+            TPath path = dir / temp;
+            TFile file;
+
+            error = file.OpenAt(dirFd, temp, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+            if (!error) {
+                error = TVolumeLoopBackend::MakeImage(file, dirFd, path, size, 0);
+                if (!error)
+                    error = dirFd.RenameAt(temp, name);
+                if (error)
+                    (void)dirFd.UnlinkAt(temp);
+            }
+
+            if (!error) {
+                lock.lock();
+                pool.Images[size].push_back(name);
+                Statistics->LoopPoolImages++;
+            }
+        }
+    }
+
+    if (error)
+        L_WRN("Cannot refill loop image pool at {}: {}", place, error);
+
+    std::lock_guard<std::mutex> lock(LoopPoolMutex);
+    LoopPools[place.ToString()].Refill = false;
+}
+
+/* Called under LoopPoolMutex */
+static TLoopPool &PrepareLoopPool(const TPath &place) {
+    auto &pool = LoopPools[place.ToString()];
+
+    if (!pool.Loaded)
+        LoadLoopPool(place, pool);
+
+    return pool;
+}
+
+/* Called under LoopPoolMutex */
+static void QueueRefillLoopPool(const TPath &place, TLoopPool &pool) {
+    if (!pool.Refill) {
+        pool.Refill = true;
+        QueueIoTask([place]{ RefillLoopPool(place); }, place);
+    }
+}
+
+void TVolume::StartLoopPool() {
+    if (!config().volumes().loop_pool_size())
+        return;
+    std::lock_guard<std::mutex> lock(LoopPoolMutex);
+    QueueRefillLoopPool(PORTO_PLACE, PrepareLoopPool(PORTO_PLACE));
+}
+
+static TError ClaimLoopImage(const TPath &place, uint64_t size,
+                             const TFile &dir, const TString &name) {
+    unsigned target = config().volumes().loop_pool_size();
+    TString image;
+
+    if (!target)
+        return TError(EError::NotSupported, "Loop image pool is disabled");
+
+    auto classes = LoopPoolClasses();
+    if (std::find(classes.begin(), classes.end(), size) == classes.end())
+        return TError(EError::NotSupported, "No loop image pool for size {}", size);
+
+    std::unique_lock<std::mutex> lock(LoopPoolMutex);
+    auto &pool = PrepareLoopPool(place);
+
+    auto &images = pool.Images[size];
+    if (!images.empty()) {
+        image = images.back();
+        images.pop_back();
+        Statistics->LoopPoolImages--;
+    }
+
+    if (images.size() < target)
+        QueueRefillLoopPool(place, pool);
+
+    lock.unlock();
+
+    if (image.empty()) {
+        Statistics->LoopPoolMiss++;
+        return TError(EError::ResourceNotAvailable, "No pooled loop image of size {}", size);
+    }
+
+    TFile pool_dir;
+    TError error = pool_dir.OpenDir(place / PORTO_LOOP_POOL);
+    if (!error && renameat(pool_dir.Fd, image.c_str(), dir.Fd, name.c_str()))
+        error = TError::System("Cannot claim loop image {}", image);
+    if (error) {
+        L_WRN("Cannot claim loop image: {}", error);
+        Statistics->LoopPoolMiss++;
+        return error;
+    }
+
+    L_ACT("Claim pooled loop image {} size {}", image, size);
+    Statistics->LoopPoolHit++;
+
+    return OK;
+}
+
 /* TVolumeOverlayBackend - project quota + overlayfs */
 
 class TVolumeOverlayBackend : public TVolumeBackend {
@@ -1401,13 +1797,16 @@ std::shared_ptr<TVolumeLink> TVolume::ResolveLink(const TPath &path) {
 }
 
 std::shared_ptr<TVolumeLink> TVolume::ResolveOriginLocked(const TPath &path) {
-    if (path.IsAbsolute()) {
-        for (auto p = path.NormalPath(); !p.IsRoot(); p = p.DirNameNormal()) {
-            auto link = ResolveLinkLocked(p);
-            if (link)
-                return link;
-        }
-    }
+    const TVolumeLink *link = nullptr;
+    if (!path.IsAbsolute())
+        return nullptr;
+    /* deepest mounted link, skip reserved */
+    VolumeLinkIndex.Ancestors(path.NormalPath(), [&](const TVolumeLink *l) {
+        if (IsVolumeLinkMounted(l))
+            link = l;
+    });
+    if (link && !link->HostTarget.IsRoot())
+        return ResolveLinkLocked(link->HostTarget);
     return nullptr;
 }
 
@@ -1416,12 +1815,25 @@ std::shared_ptr<TVolumeLink> TVolume::ResolveOrigin(const TPath &path) {
     return ResolveOriginLocked(path);
 }
 
+std::shared_ptr<TVolume> TVolume::FindBuilding(const TPath &path) {
+    auto volumes_lock = LockVolumes();
+    auto it = Volumes.find(path);
+    if (it != Volumes.end() && it->second->AsyncBuild)
+        return it->second;
+    return nullptr;
+}
+
 TPath TVolume::ComposePath(const TContainer &ct) const {
     auto volumes_lock = LockVolumes();
+    return ComposePathLocked(ct);
+}
 
+TPath TVolume::ComposePathLocked(const TContainer &ct) const {
     /* prefer own link */
-    for (auto &link: ct.VolumeLinks) {
-        if (link->Volume.get() == this && link->Target)
+    auto range = ct.VolumeLinkIndex.equal_range(this);
+    for (auto it = range.first; it != range.second; it++) {
+        auto &link = *it->second;
+        if (link->Target)
             return link->Target;
     }
 
@@ -1466,6 +1878,10 @@ void TVolume::SetState(EVolumeState state) {
     State = state;
     if (state == EVolumeState::Ready || state == EVolumeState::Destroyed)
         VolumesCv.notify_all();
+    if (state == EVolumeState::Destroyed && BuildError)
+        TContainerWaiter::ReportVolume(*this, "error", BuildError.ToString());
+    else
+        TContainerWaiter::ReportVolume(*this);
 }
 
 TError TVolume::OpenBackend() {
@@ -1673,6 +2089,7 @@ TError TVolume::DependsOn(const TPath &path) {
             return TError(EError::VolumeNotReady, "Volume {} depends on non-ready volume {}", Path, link->Volume->Path);
         L("Volume {} depends on volume {}", Path, link->Volume->Path);
         link->Volume->Nested.insert(shared_from_this());
+        Bases.insert(link->Volume);
     }
 
     return OK;
@@ -1703,61 +2120,110 @@ TError TVolume::CheckDependencies() {
 
     if (error) {
         /* undo dependencies */
-        for (auto &it : Volumes)
-            it.second->Nested.erase(shared_from_this());
+        for (auto &base: Bases)
+            base->Nested.erase(shared_from_this());
+        Bases.clear();
     }
 
     return error;
 }
 
-TError TVolume::CheckConflicts(const TPath &path) {
-    if (IsSystemPath(path))
-        return TError(EError::InvalidPath, "Volume path {} in system directory", path);
+TError TVolume::CheckConflict(const TPath &path) const {
+    if (Path == path)
+        return TError(EError::Busy, "Volume path {} is used by volume {}", path, Path);
 
-    for (auto &it : Volumes) {
-        auto &vol = it.second;
+    if (Path.IsInside(path))
+        return TError(EError::InvalidPath, "Volume path {} overlaps with volume {}", path, Path);
 
-        if (vol->Path == path)
-            return TError(EError::Busy, "Volume path {} is used by volume {}", path, vol->Path);
+    if (path.IsInside(Path) &&
+            State != EVolumeState::Ready &&
+            State != EVolumeState::Tuning)
+        return TError(EError::VolumeNotReady, "Volume path {} inside volume {} and it is not ready", path, Path);
 
-        if (vol->Path.IsInside(path))
-            return TError(EError::InvalidPath, "Volume path {} overlaps with volume {}", path, vol->Path);
+    if (Place.IsInside(path))
+        return TError(EError::InvalidPath, "Volume path {} overlaps with place {}", path, Place);
 
-        if (path.IsInside(vol->Path) &&
-                vol->State != EVolumeState::Ready &&
-                vol->State != EVolumeState::Tuning)
-            return TError(EError::VolumeNotReady, "Volume path {} inside volume {} and it is not ready", path, vol->Path);
+    if (RemoteStorage()) {
 
-        if (vol->Place.IsInside(path))
-            return TError(EError::InvalidPath, "Volume path {} overlaps with place {}", path, vol->Place);
+    } else if (BackendType == "bind" || BackendType == "rbind") {
+        if (StoragePath.IsInside(path))
+            return TError(EError::InvalidPath, "Volume path {} overlaps with volume {} storage {}", path, Path, StoragePath);
+    } else {
+        if (StoragePath.IsInside(path) || path.IsInside(StoragePath))
+            return TError(EError::InvalidPath, "Volume path {} overlaps with volume {} storage {}", path, Path, StoragePath);
+    }
 
-        if (vol->RemoteStorage()) {
+    for (auto &l: Layers) {
+        TPath layer(l);
+        if (layer.IsAbsolute() && (layer.IsInside(path) || path.IsInside(layer)))
+            return TError(EError::InvalidPath, "Volume path {} overlaps with layer {}", path, layer);
+    }
 
-        } else if (vol->BackendType == "bind" || vol->BackendType == "rbind") {
-            if (vol->StoragePath.IsInside(path))
-                return TError(EError::InvalidPath, "Volume path {} overlaps with volume {} storage {}", path, vol->Path, vol->StoragePath);
-        } else {
-            if (vol->StoragePath.IsInside(path) || path.IsInside(vol->StoragePath))
-                return TError(EError::InvalidPath, "Volume path {} overlaps with volume {} storage {}", path, vol->Path, vol->StoragePath);
-        }
+    for (auto &link: Links) {
+        if (link->HostTarget == path)
+            return TError(EError::Busy, "Volume path {} is used by volume {} for {}", path, Path, link->Container->Name);
+        if (link->HostTarget.IsInside(path))
+            return TError(EError::InvalidPath, "Volume path {} overlaps with volume {} link {} for {}", path, Path, link->HostTarget, link->Container->Name);
+    }
 
-        for (auto &l: vol->Layers) {
-            TPath layer(l);
-            if (layer.IsAbsolute() && (layer.IsInside(path) || path.IsInside(layer)))
-                return TError(EError::InvalidPath, "Volume path {} overlaps with layer {}", path, layer);
-        }
+    return OK;
+}
 
-        for (auto &link: vol->Links) {
-            if (link->HostTarget == path)
-                return TError(EError::Busy, "Volume path {} is used by volume {} for {}", path, vol->Path, link->Container->Name);
-            if (link->HostTarget.IsInside(path))
-                return TError(EError::InvalidPath, "Volume path {} overlaps with volume {} link {} for {}", path, vol->Path, link->HostTarget, link->Container->Name);
-        }
+TError TVolume::CheckConflicts(const TPath &path) {
+    if (IsSystemPath(path))
+        return TError(EError::InvalidPath, "Volume path {} in system directory", path);
+
+    /* only volumes with paths above or below could conflict, check in order of paths */
+    std::map<TPath, const TVolume *> related;
+    auto add_volume = [&](const TVolume *vol) { related[vol->Path] = vol; };
+    auto add_link = [&](const TVolumeLink *link) { related[link->Volume->Path] = link->Volume.get(); };
+
+    VolumePathIndex.Ancestors(path, add_volume);
+    VolumePathIndex.Descendants(path, add_volume);
+    VolumePlaceIndex.Descendants(path, add_volume);
+    VolumeLinkIndex.Ancestors(path, add_link);
+    VolumeLinkIndex.Descendants(path, add_link);
+
+    for (auto &it: related) {
+        TError error = it.second->CheckConflict(path);
+        if (error)
+            return error;
     }
 
     return OK;
 }
 
+void TVolume::AddToIndex() {
+    IndexPaths = { Path };
+    if (!RemoteStorage() && StoragePath)
+        IndexPaths.push_back(StoragePath);
+    for (auto &l: Layers) {
+        if (l[0] == '/')
+            IndexPaths.push_back(l);
+    }
+
+    for (auto &path: IndexPaths)
+        VolumePathIndex.Insert(path, this);
+    VolumePlaceIndex.Insert(Place, this);
+}
+
+void TVolume::RemoveFromIndex() {
+    for (auto &path: IndexPaths)
+        VolumePathIndex.Erase(path, this);
+    if (!IndexPaths.empty())
+        VolumePlaceIndex.Erase(Place, this);
+    IndexPaths.clear();
+
+    auto range = LoopImageIndex.equal_range(ImageInode);
+    for (auto it = range.first; it != range.second; it++) {
+        if (it->second == this) {
+            LoopImageIndex.erase(it);
+            break;
+        }
+    }
+    ImageInode = {0, 0};
+}
+
 TError TVolume::Configure(const TPath &target_root) {
     TError error;
 
@@ -1923,6 +2389,10 @@ TError TVolume::MergeLayers() {
         return OK;
 
     for (auto &name : Layers) {
+        error = BuildStage("layer " + name);
+        if (error)
+            return error;
+
         L_ACT("Merge layer {} into volume: {}", name, Path);
 
         if (name[0] == '/') {
@@ -2237,6 +2707,14 @@ TError TVolume::Build() {
     if (error)
         return error;
 
+    error = BuildStage("backend");
+    if (error)
+        return error;
+
+    error = AcquireLayerImages();
+    if (error)
+        return error;
+
     error = Backend->Build();
     if (error)
         return error;
@@ -2246,6 +2724,10 @@ TError TVolume::Build() {
         if (error)
             return error;
 
+        error = BuildStage("directories");
+        if (error)
+            return error;
+
         TFile base;
         if (RemoteStorage() || FileStorage())
             error = base.OpenDirStrict(InternalPath);
@@ -2317,7 +2799,7 @@ TError TVolume::MountLink(std::shared_ptr<TVolumeLink> link) {
         return TError(EError::InvalidValue, "Wrong volume link");
 
     TPath host_target = link->Container->RootPath / link->Target;
-    link->HostTarget = "";
+    ReleaseVolumeLink(link.get());
 
     if (host_target != link->Volume->Path) {
         error = TVolume::CheckConflicts(host_target);
@@ -2330,7 +2812,7 @@ TError TVolume::MountLink(std::shared_ptr<TVolumeLink> link) {
     if (VolumeLinks.find(link->HostTarget) != VolumeLinks.end())
         L_WRN("Duplicate volume link: {}", link->HostTarget);
 
-    VolumeLinks[link->HostTarget] = link;
+    InsertVolumeLink(link);
 
     /* Block changes root path */
     for (auto ct = link->Container; ct; ct = ct->Parent)
@@ -2444,7 +2926,7 @@ undo:
     volumes_lock.lock();
 
     if (link->HostTarget) {
-        VolumeLinks.erase(link->HostTarget);
+        EraseVolumeLink(link->HostTarget);
         for (auto ct = link->Container; ct; ct = ct->Parent)
             ct->VolumeMounts--;
         link->HostTarget = "";
@@ -2511,7 +2993,7 @@ TError TVolume::UmountLink(std::shared_ptr<TVolumeLink> link,
         }
 
         link->HostTarget = "";
-        it = VolumeLinks.erase(it);
+        it = EraseVolumeLink(it);
     }
 
     volumes_lock.unlock();
@@ -2547,6 +3029,16 @@ TError TVolume::Destroy() {
 
     auto volumes_lock = LockVolumes();
 
+    /*
+     * Cancel asynchronous build and wait until builder gives up.
+     * Builder takes container locks, so locks are released above.
+     */
+    if (AsyncBuild) {
+        BuildCancel = true;
+        while (BuildRunning)
+            VolumesCv.wait(volumes_lock);
+    }
+
     auto cycle = shared_from_this();
 
     bool stop_containers = HasDependentContainer;
@@ -2646,13 +3138,16 @@ TError TVolume::Destroy() {
 
         volumes_lock.lock();
 
-        for (auto &it : Volumes)
-            it.second->Nested.erase(volume);
+        for (auto &base: volume->Bases)
+            base->Nested.erase(volume);
+        volume->Bases.clear();
 
+        volume->RemoveFromIndex();
         Volumes.erase(volume->Path);
+        ChangeLog.Remove(EChangeKind::Volume, volume->Path.ToString());
 
         /* Remove common link */
-        if (VolumeLinks.erase(volume->Path))
+        if (EraseVolumeLink(volume->Path))
             RootContainer->VolumeMounts--;
 
         if (volume->VolumeOwnerContainer) {
@@ -2705,6 +3200,8 @@ TError TVolume::DestroyOne() {
         }
     }
 
+    ReleaseLayerImages();
+
     error = internal.UmountNested();
     if (error) {
         L_ERR("Cannot umount internal: {}", error);
@@ -2734,7 +3231,9 @@ TError TVolume::DestroyOne() {
 
     if (!KeepStorage && !RemoteStorage() && StoragePath.Exists()) {
         if (!UserStorage()) {
-            error = RemoveRecursive(StoragePath);
+            error = TStorage::MoveToTrash(Place, StoragePath);
+            if (error)
+                error = RemoveRecursive(StoragePath);
             if (error) {
                 L_VERBOSE("Cannot remove storage {}: {}", StoragePath, error);
                 error = StoragePath.RemoveAll();
@@ -2786,14 +3285,102 @@ TError TVolume::DestroyOne() {
     return ret;
 }
 
-TError TVolume::StatFS(TStatFS &result) {
+TError TVolume::StatFS(TStatFS &result, bool sync) {
     if (State != EVolumeState::Ready &&
             State != EVolumeState::Tuning &&
             State != EVolumeState::Unlinked) {
         result.Reset();
         return TError(EError::VolumeNotReady, "Volume {} is not ready", Path);
     }
-    return Backend->StatFS(result);
+
+    if (!sync && config().volumes().usage_refresh_ms()) {
+        std::lock_guard<std::mutex> lock(UsageMutex);
+        if (UsageTime) {
+            result = Usage;
+            return OK;
+        }
+    }
+
+    TError error = Backend->StatFS(result);
+    Statistics->VolumeUsageRefreshes++;
+
+    std::lock_guard<std::mutex> lock(UsageMutex);
+    if (error) {
+        UsageTime = 0;
+    } else {
+        Usage = result;
+        UsageTime = GetCurrentTimeMs();
+    }
+
+    return error;
+}
+
+static std::mutex UsageRefreshMutex;
+static std::condition_variable UsageRefreshCv;
+static std::thread UsageRefreshThread;
+static std::atomic<bool> UsageRefreshStop;
+
+/* Refresh usage of volumes which was asked at least once */
+static void RefreshUsage() {
+    std::list<std::shared_ptr<TVolume>> list;
+    uint64_t start = GetCurrentTimeMs();
+
+    auto volumes_lock = LockVolumes();
+    for (auto &it: Volumes) {
+        auto &volume = it.second;
+        if (volume->State == EVolumeState::Ready ||
+                volume->State == EVolumeState::Tuning ||
+                volume->State == EVolumeState::Unlinked)
+            list.push_back(volume);
+    }
+    volumes_lock.unlock();
+
+    for (auto &volume: list) {
+        if (UsageRefreshStop)
+            break;
+
+        std::unique_lock<std::mutex> lock(volume->UsageMutex);
+        bool cached = volume->UsageTime;
+        lock.unlock();
+
+        TStatFS stat;
+        if (cached)
+            (void)volume->StatFS(stat, true);
+    }
+
+    Statistics->VolumeUsageRefreshMs = GetCurrentTimeMs() - start;
+}
+
+static void UsageRefresher() {
+    uint64_t interval = config().volumes().usage_refresh_ms();
+
+    SetProcessName("portod-VU");
+
+    std::unique_lock<std::mutex> lock(UsageRefreshMutex);
+    while (!UsageRefreshStop) {
+        lock.unlock();
+        RefreshUsage();
+        lock.lock();
+        UsageRefreshCv.wait_for(lock, std::chrono::milliseconds(interval),
+                                []{ return UsageRefreshStop.load(); });
+    }
+}
+
+void TVolume::StartUsageRefresher() {
+    if (!config().volumes().usage_refresh_ms())
+        return;
+    UsageRefreshStop = false;
+    UsageRefreshThread = std::thread(UsageRefresher);
+}
+
+void TVolume::StopUsageRefresher() {
+    if (!UsageRefreshThread.joinable())
+        return;
+    std::unique_lock<std::mutex> lock(UsageRefreshMutex);
+    UsageRefreshStop = true;
+    lock.unlock();
+    UsageRefreshCv.notify_all();
+    UsageRefreshThread.join();
 }
 
 TError TVolume::Tune(const std::map<TString, TString> &properties) {
@@ -2854,6 +3441,10 @@ TError TVolume::Tune(const std::map<TString, TString> &properties) {
         SpaceLimit = spaceLimit;
         InodeLimit = inodeLimit;
         volumes_lock.unlock();
+
+        /* Available space has changed */
+        TStatFS stat;
+        (void)StatFS(stat, true);
     }
 
     if (properties.count(V_SPACE_GUARANTEE) || properties.count(V_INODE_GUARANTEE)) {
@@ -2942,9 +3533,11 @@ TError TVolume::LinkVolume(std::shared_ptr<TContainer> container,
     link->ReadOnly = read_only;
     link->Required = required;
     link->HostTarget = host_target;   /* protect path from conflicts */
+    if (host_target)
+        ReserveVolumeLink(link.get());
 
     Links.emplace_back(link);
-    container->VolumeLinks.emplace_back(link);
+    AddContainerLink(*container, link);
 
     bool was_required = std::find(container->RequiredVolumes.begin(),
             container->RequiredVolumes.end(), target.ToString()) != container->RequiredVolumes.end();
@@ -2979,8 +3572,9 @@ TError TVolume::LinkVolume(std::shared_ptr<TContainer> container,
 
 undo:
     volumes_lock.lock();
+    ReleaseVolumeLink(link.get());
     Links.remove(link);
-    container->VolumeLinks.remove(link);
+    DelContainerLink(*container, link);
     if (required && !was_required) {
         auto it = std::find(container->RequiredVolumes.begin(),
                             container->RequiredVolumes.end(), target.ToString());
@@ -3043,7 +3637,7 @@ next:
         SetState(EVolumeState::Unlinked);
         unlinked.emplace_back(shared_from_this());
     }
-    container->VolumeLinks.remove(link);
+    DelContainerLink(*container, link);
     /* Required path at container is sticky */
     volumes_lock.unlock();
     link.reset();
@@ -3070,7 +3664,7 @@ void TVolume::UnlinkAllVolumes(std::shared_ptr<TContainer> container,
         volumes_lock.lock();
         if (error && link == container->VolumeLinks.back()) {
             L_WRN("Cannot unlink volume {}: {}", link->Volume->Path, error);
-            container->VolumeLinks.remove(link);
+            DelContainerLink(*container, link);
         }
     }
 
@@ -3106,7 +3700,8 @@ TError TVolume::CheckRequired(TContainer &ct) {
     return OK;
 }
 
-void TVolume::DumpDescription(TVolumeLink *link, const TPath &path, rpc::TVolumeDescription *dump) {
+void TVolume::DumpDescription(TVolumeLink *link, const TPath &path, rpc::TVolumeDescription *dump,
+                              bool sync) {
     TStringMap ret;
 
     auto volumes_lock = LockVolumes();
@@ -3196,7 +3791,7 @@ void TVolume::DumpDescription(TVolumeLink *link, const TPath &path, rpc::TVolume
     volumes_lock.unlock();
 
     TStatFS stat;
-    if (!StatFS(stat)) {
+    if (!StatFS(stat, sync)) {
         ret[V_SPACE_USED] = std::to_string(stat.SpaceUsage);
         ret[V_INODE_USED] = std::to_string(stat.InodeUsage);
         ret[V_SPACE_AVAILABLE] = std::to_string(stat.SpaceAvail);
@@ -3226,6 +3821,7 @@ TError TVolume::Save() {
         return OK;
 
     ChangeTime = time(nullptr);
+    ChangeLog.Touch(EChangeKind::Volume, Path.ToString());
 
     /*
      * Storing all state values on save,
@@ -3282,7 +3878,7 @@ TError TVolume::Save() {
 
     node.Set(V_PLACE, Place.ToString());
 
-    error = node.Save();
+    error = node.Save(KvJournal);
     if (error)
         L_WRN("Cannot save volume {} {}", Path, error);
 
@@ -3340,6 +3936,10 @@ TError TVolume::Restore(const TKeyValue &node) {
     if (error)
         return error;
 
+    error = AcquireLayerImages();
+    if (error)
+        return error;
+
     error = ClaimPlace(SpaceLimit);
     if (error)
         return error;
@@ -3354,13 +3954,15 @@ TError TVolume::Restore(const TKeyValue &node) {
         L_WRN("Duplicate volume link: {}", Path);
 
     Volumes[Path] = shared_from_this();
+    AddToIndex();
+    ChangeLog.Touch(EChangeKind::Volume, Path.ToString());
 
     /* Restore common link */
     auto common_link = std::make_shared<TVolumeLink>(shared_from_this(), RootContainer);
     common_link->Target = Path;
     common_link->HostTarget = Path;
     common_link->ReadOnly = IsReadOnly;
-    VolumeLinks[Path] = common_link;
+    InsertVolumeLink(common_link);
     RootContainer->VolumeMounts++;
 
     /* Restore other links */
@@ -3394,8 +3996,9 @@ TError TVolume::Restore(const TKeyValue &node) {
         }
 
         bool duplicate = false;
-        for (auto &l: ct->VolumeLinks) {
-            if (link->Volume == l->Volume && link->Target == l->Target)
+        auto range = ct->VolumeLinkIndex.equal_range(this);
+        for (auto it = range.first; it != range.second; it++) {
+            if (link->Target == (*it->second)->Target)
                 duplicate = true;
         }
         if (duplicate) {
@@ -3415,13 +4018,13 @@ TError TVolume::Restore(const TKeyValue &node) {
                 continue;
             }
 
-            VolumeLinks[link->HostTarget] = link;
+            InsertVolumeLink(link);
             for (auto c = ct; c; c = c->Parent)
                 c->VolumeMounts++;
         }
 
         Links.emplace_back(link);
-        ct->VolumeLinks.emplace_back(link);
+        AddContainerLink(*ct, link);
     }
 
     return OK;
@@ -3458,7 +4061,9 @@ std::vector<TVolumeProperty> VolumeProperties = {
 };
 
 TError TVolume::Create(const rpc::TVolumeSpec &spec,
-                       std::shared_ptr<TVolume> &volume) {
+                       std::shared_ptr<TVolume> &volume,
+                       bool async) {
+    std::shared_ptr<rpc::TVolumeSpec> async_spec;
     TError error;
 
     if (!CL)
@@ -3539,7 +4144,13 @@ TError TVolume::Create(const rpc::TVolumeSpec &spec,
 
     volume = std::make_shared<TVolume>();
     volume->Id = std::to_string(NextId++);
-    volume->Spec = &spec;
+
+    /* Builder outlives request */
+    if (async) {
+        async_spec = std::make_shared<rpc::TVolumeSpec>(spec);
+        volume->Spec = async_spec.get();
+    } else
+        volume->Spec = &spec;
 
     error = volume->Configure(target_root);
     if (error)
@@ -3552,23 +4163,25 @@ TError TVolume::Create(const rpc::TVolumeSpec &spec,
     common_link->ReadOnly = volume->IsReadOnly;
 
     if (volume->Path == volume->InternalPath) {
-        VolumeLinks[volume->Path] = common_link;
+        InsertVolumeLink(common_link);
         RootContainer->VolumeMounts++;
     }
 
     /* also check if volume depends on itself */
     error = volume->CheckDependencies();
     if (error) {
-        VolumeLinks.erase(volume->Path);
+        EraseVolumeLink(volume->Path);
         return error;
     }
 
     Volumes[volume->Path] = volume;
+    volume->AddToIndex();
 
     volume->VolumeOwnerContainer = owner;
     owner->OwnedVolumes.push_back(volume);
 
     volume->SetState(EVolumeState::Building);
+    volume->AsyncBuild = async;
 
     volumes_lock.unlock();
 
@@ -3577,72 +4190,140 @@ TError TVolume::Create(const rpc::TVolumeSpec &spec,
     /* release owner */
     CL->ReleaseContainer();
 
-    if (error)
-        goto undo;
+    if (error) {
+        volume->Destroy();
+        return error;
+    }
+
+    if (async) {
+        auto client = CL->Clone();
+        /* async_spec backs volume->Spec until build completes */
+        QueueIoRequest([volume, client, async_spec, common_link] {
+            volume->BuildAsync(client, common_link);
+        }, CL, volume->Place);
+        return OK;
+    }
 
-    error = volume->Build();
+    error = volume->Complete(common_link);
     volume->Spec = nullptr;
     if (error)
-        goto undo;
+        volume->Destroy();
+
+    return error;
+}
+
+TError TVolume::Complete(std::shared_ptr<TVolumeLink> common_link) {
+    TError error;
+
+    error = Build();
+    if (error)
+        return error;
+
+    error = BuildStage("links");
+    if (error)
+        return error;
 
-    if (spec.links().size()) {
-        for (auto &link: spec.links()) {
+    if (Spec->links().size()) {
+        for (auto &link: Spec->links()) {
             std::shared_ptr<TContainer> ct;
+            /* do not take container locks after cancel */
+            if (BuildCancel)
+                return TError(EError::VolumeNotReady, "Build of volume {} cancelled", Path);
             error = CL->WriteContainer(link.container(), ct, true);
             if (error)
-                goto undo;
-            error = volume->LinkVolume(ct, link.target(), link.read_only(), link.required());
+                return error;
+            error = LinkVolume(ct, link.target(), link.read_only(), link.required());
             CL->ReleaseContainer();
             if (error)
-                goto undo;
+                return error;
         }
     } else {
         error = CL->LockContainer(CL->ClientContainer);
         if (!error)
-            error = volume->LinkVolume(CL->ClientContainer);
+            error = LinkVolume(CL->ClientContainer);
         CL->ReleaseContainer();
         if (error)
-            goto undo;
+            return error;
     }
 
-    error = volume->Save();
+    error = Save();
     if (error)
-        goto undo;
+        return error;
 
     /* Mount common link in requested path */
-    if (volume->Path != volume->InternalPath) {
-        error = volume->MountLink(common_link);
+    if (Path != InternalPath) {
+        error = MountLink(common_link);
         if (error)
-            goto undo;
+            return error;
     }
 
     /* Mount other links */
+    auto volumes_lock = LockVolumes();
 next_link:
-    volumes_lock.lock();
-    for (auto link: volume->Links) {
+    for (auto link: Links) {
         if (link->Target && !link->HostTarget) {
             volumes_lock.unlock();
-            error = volume->MountLink(link);
+            error = MountLink(link);
             if (error)
-                goto undo;
+                return error;
+            volumes_lock.lock();
             goto next_link;
         }
     }
 
     /* Complete costriction */
-    volume->SetState(EVolumeState::Ready);
+    SetState(EVolumeState::Ready);
     volumes_lock.unlock();
 
     /* Final commit */
-    error = volume->Save();
-    if (error)
-        goto undo;
+    return Save();
+}
 
-    return OK;
+void TVolume::BuildAsync(std::shared_ptr<TClient> client,
+                         std::shared_ptr<TVolumeLink> common_link) {
+    auto volumes_lock = LockVolumes();
+    /* Cancelled before start, canceller destroys volume */
+    if (BuildCancel) {
+        AsyncBuild = false;
+        return;
+    }
+    BuildRunning = true;
+    volumes_lock.unlock();
 
-undo:
-    volume->Destroy();
-    return error;
+    client->StartRequest();
+
+    TError error = Complete(common_link);
+    Spec = nullptr;
+
+    volumes_lock.lock();
+    bool cancelled = BuildCancel;
+    BuildRunning = false;
+    AsyncBuild = false;
+    VolumesCv.notify_all();
+    volumes_lock.unlock();
+
+    if (error) {
+        L_WRN("Cannot build volume {}: {}", Path, error);
+        Statistics->VolumesFailed++;
+        if (!cancelled) {
+            BuildError = error;
+            Destroy();
+        }
+    }
+
+    client->FinishRequest();
+}
+
+TError TVolume::BuildStage(const TString &stage) {
+    if (BuildCancel)
+        return TError(EError::VolumeNotReady, "Build of volume {} cancelled", Path);
+
+    if (AsyncBuild) {
+        auto volumes_lock = LockVolumes();
+        TContainerWaiter::ReportVolume(*this, "stage", stage);
+    }
+
+    return OK;
 }
 
 void TVolume::RestoreAll(void) {
@@ -4038,7 +4719,7 @@ TError TVolume::Load(const rpc::TVolumeSpec &spec, bool full) {
     return ret;
 }
 
-void TVolume::Dump(rpc::TVolumeSpec &spec, bool full) {
+void TVolume::Dump(rpc::TVolumeSpec &spec, bool full, bool sync) {
     auto volumes_lock = LockVolumes();
 
     spec.set_path(CL->ComposePath(Path).ToString());
@@ -4120,7 +4801,7 @@ void TVolume::Dump(rpc::TVolumeSpec &spec, bool full) {
     volumes_lock.unlock();
 
     TStatFS stat;
-    if (!full && !StatFS(stat)) {
+    if (!full && !StatFS(stat, sync)) {
         spec.mutable_space()->set_usage(stat.SpaceUsage);
         spec.mutable_space()->set_available(stat.SpaceAvail);
         spec.mutable_inodes()->set_usage(stat.InodeUsage);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <set>
@@ -7,6 +8,7 @@
 #include "common.hpp"
 #include "util/path.hpp"
 #include "util/log.hpp"
+#include "kvalue.hpp"
 
 constexpr const char *V_ID = "id";
 constexpr const char *V_PATH = "path";
@@ -54,6 +56,7 @@ constexpr const char *V_DEVICE_NAME = "device_name";
 class TVolume;
 class TContainer;
 class TKeyValue;
+class TClient;
 
 enum class EVolumeState {
     Initial,
@@ -107,6 +110,7 @@ public:
     bool IsAutoPath = false;
     uint64_t BuildTime = 0;
     uint64_t ChangeTime = 0;
+    TKeyValueJournal KvJournal;
 
     TPath Place;
 
@@ -130,6 +134,7 @@ public:
     bool HasDependentContainer = false;
 
     std::vector<TString> Layers;
+    std::list<TPath> LayerImages; /* mounted squashfs layers */
     std::list<std::shared_ptr<TVolumeLink>> Links;
 
     uint64_t ClaimedSpace = 0;
@@ -149,9 +154,25 @@ public:
     TString Private;
 
     std::set<std::shared_ptr<TVolume>> Nested;
+    std::set<std::shared_ptr<TVolume>> Bases;   /* volumes which have us in Nested */
+
+    /* protected with VolumesMutex */
+    std::vector<TPath> IndexPaths;
+    std::pair<dev_t, ino_t> ImageInode = {0, 0};
 
     const rpc::TVolumeSpec *Spec; /* during build */
 
+    /* asynchronous build, protected with VolumesMutex */
+    bool AsyncBuild = false;    /* queued or running */
+    bool BuildRunning = false;
+    std::atomic<bool> BuildCancel{false};
+    TError BuildError;
+
+    /* cached usage, protected with UsageMutex */
+    std::mutex UsageMutex;
+    TStatFS Usage;
+    uint64_t UsageTime = 0;     /* ms, 0 - not cached */
+
     TVolume() {
         Statistics->VolumesCount++;
     }
@@ -163,32 +184,51 @@ public:
     static TError ParseConfig(const TStringMap &cfg, rpc::TVolumeSpec &spec);
 
     static TError Create(const rpc::TVolumeSpec &spec,
-                         std::shared_ptr<TVolume> &volume);
+                         std::shared_ptr<TVolume> &volume,
+                         bool async = false);
 
     /* link target path */
     static std::shared_ptr<TVolumeLink> ResolveLinkLocked(const TPath &path);
     static std::shared_ptr<TVolumeLink> ResolveLink(const TPath &path);
 
+    /* volume in asynchronous build */
+    static std::shared_ptr<TVolume> FindBuilding(const TPath &path);
+
     /* link inner path */
     static std::shared_ptr<TVolumeLink> ResolveOriginLocked(const TPath &path);
     static std::shared_ptr<TVolumeLink> ResolveOrigin(const TPath &path);
 
     TPath ComposePath(const TContainer &ct) const;
+    TPath ComposePathLocked(const TContainer &ct) const;
 
     TError Configure(const TPath &target_root);
 
     TError Load(const rpc::TVolumeSpec &spec, bool full = false);
-    void Dump(rpc::TVolumeSpec &spec, bool full = false);
+    void Dump(rpc::TVolumeSpec &spec, bool full = false, bool sync = false);
 
-    void DumpDescription(TVolumeLink *link, const TPath &path, rpc::TVolumeDescription *dump);
+    void DumpDescription(TVolumeLink *link, const TPath &path, rpc::TVolumeDescription *dump,
+                         bool sync = false);
 
     TError DependsOn(const TPath &path);
     TError CheckDependencies();
     static TError CheckConflicts(const TPath &path);
+    TError CheckConflict(const TPath &path) const;
+
+    void AddToIndex();
+    void RemoveFromIndex();
 
     TError Build(void);
+    TError Complete(std::shared_ptr<TVolumeLink> common_link);
+    void BuildAsync(std::shared_ptr<TClient> client,
+                    std::shared_ptr<TVolumeLink> common_link);
+    TError BuildStage(const TString &stage);
 
     TError MergeLayers();
+    static TError AcquireLayerImage(const TPath &image, const TPath &path);
+    static void ReleaseLayerImage(const TPath &path);
+    static bool LayerImageBusy(const TPath &path);
+    TError AcquireLayerImages();
+    void ReleaseLayerImages();
     TError MakeDirectories(const TFile &base);
     TError MakeSymlinks(const TFile &base);
     TError MakeShares(const TFile &base, bool cow);
@@ -202,6 +242,10 @@ public:
 
     static void RestoreAll(void);
 
+    static void StartUsageRefresher();
+    static void StopUsageRefresher();
+    static void StartLoopPool();
+
     TError MountLink(std::shared_ptr<TVolumeLink> link);
 
     TError UmountLink(std::shared_ptr<TVolumeLink> link,
@@ -265,7 +309,8 @@ public:
         return !Layers.empty();
     }
 
-    TError StatFS(TStatFS &result);
+    /* Returns cached usage unless sync, see usage_refresh_ms */
+    TError StatFS(TStatFS &result, bool sync = false);
 
     TError GetUpperLayer(TPath &upper);
 
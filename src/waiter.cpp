@@ -1,14 +1,54 @@
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+
 #include "waiter.hpp"
 #include "client.hpp"
+#include "volume.hpp"
+#include "util/trie.hpp"
 #include <time.h>
 
+/*
+ * Active waiters are indexed by what they wait for: exact names, fixed
+ * leading components of wildcards and names of user labels. State or
+ * label change looks only at waiters which could match it.
+ */
 static std::mutex ContainerWaitersLock;
-static std::list<TContainerWaiter *> ContainerWaiters;
+static std::unordered_multimap<TString, TContainerWaiter *> NameWaiters;
+static TPathTrie<TContainerWaiter *> WildcardWaiters;
+static std::set<TContainerWaiter *> AnyNameWaiters;     /* wildcard in first component */
+static std::unordered_multimap<TString, TContainerWaiter *> LabelWaiters;
+static std::set<TContainerWaiter *> AnyLabelWaiters;    /* label wildcards */
+static std::set<TContainerWaiter *> VolumeWaiters;
+static uint64_t WaitersSeq = 0;
 
 static inline std::unique_lock<std::mutex> LockWaiters() {
     return std::unique_lock<std::mutex>(ContainerWaitersLock);
 }
 
+static bool IsWildcard(const TString &pattern) {
+    return pattern.find_first_of("*?[\\") != TString::npos;
+}
+
+/* components before first one with wildcard, empty if there is none */
+static TPath WildcardPrefix(const TString &pattern) {
+    auto slash = pattern.rfind('/', pattern.find_first_of("*?[\\"));
+    if (slash == TString::npos)
+        return TPath();
+    return TPath(pattern.substr(0, slash));
+}
+
+static void EraseWaiter(std::unordered_multimap<TString, TContainerWaiter *> &index,
+                        const TString &key, TContainerWaiter *waiter) {
+    auto range = index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == waiter) {
+            index.erase(it);
+            return;
+        }
+    }
+}
+
 TContainerWaiter::~TContainerWaiter() {
     if (Active) {
         auto lock = LockWaiters();
@@ -16,24 +56,62 @@ TContainerWaiter::~TContainerWaiter() {
     }
 }
 
-void TContainerWaiter::Activate(std::shared_ptr<TClient> &client) {
+TError TContainerWaiter::Activate(std::shared_ptr<TClient> &client) {
     auto lock = LockWaiters();
-    Client = client;
     auto link = Async ? &client->AsyncWaiter : &client->SyncWaiter;
     if (*link) {
+        /* Previous pipelined sync wait would never get response */
+        if (!Async && client->Pipelined)
+            return TError(EError::Busy, "Sync wait already in progress");
         (*link)->Deactivate();
         link->reset();
     }
-    if (!Names.empty() || !Wildcards.empty()) {
+    Client = client;
+    if (!Names.empty() || !Wildcards.empty() || !Volumes.empty()) {
         *link = shared_from_this();
         Active = true;
-        ContainerWaiters.push_back(this);
+        Seq = ++WaitersSeq;
+        for (auto &name: Names)
+            NameWaiters.emplace(name, this);
+        for (auto &wc: Wildcards) {
+            TPath prefix = WildcardPrefix(wc);
+            if (prefix.IsEmpty())
+                AnyNameWaiters.insert(this);
+            else
+                WildcardWaiters.Insert(prefix, this);
+        }
+        for (auto &label: Labels) {
+            if (IsWildcard(label))
+                AnyLabelWaiters.insert(this);
+            else
+                LabelWaiters.emplace(label, this);
+        }
+        if (!Volumes.empty())
+            VolumeWaiters.insert(this);
     }
+    return OK;
 }
 
 void TContainerWaiter::Deactivate() {
+    if (!Active)
+        return;
     Active = false;
-    ContainerWaiters.remove(this);
+    for (auto &name: Names)
+        EraseWaiter(NameWaiters, name, this);
+    for (auto &wc: Wildcards) {
+        TPath prefix = WildcardPrefix(wc);
+        if (prefix.IsEmpty())
+            AnyNameWaiters.erase(this);
+        else
+            WildcardWaiters.Erase(prefix, this);
+    }
+    for (auto &label: Labels) {
+        if (IsWildcard(label))
+            AnyLabelWaiters.erase(this);
+        else
+            EraseWaiter(LabelWaiters, label, this);
+    }
+    VolumeWaiters.erase(this);
 }
 
 bool TContainerWaiter::ShouldReport(TContainer &ct) {
@@ -63,30 +141,84 @@ bool TContainerWaiter::ShouldReportLabel(const TString &label) {
     return false;
 }
 
+bool TContainerWaiter::ShouldReportVolume(const TString &path, const TString &state) {
+
+    /* Sync wait reports only completion of build or destruction */
+    if (!Async && state != "ready" && state != "destroyed")
+        return false;
+
+    for (auto &wc: Volumes)
+        if (path == wc || StringMatch(path, wc))
+            return true;
+
+    return false;
+}
+
 void TContainerWaiter::ReportAll(TContainer &ct, const TString &label, const TString &value) {
+    /* system labels are reported to all waiters, user labels - by match */
+    bool userLabel = !label.empty() && !(label[0] >= 'a' && label[0] <= 'z');
+    std::vector<TContainerWaiter *> waiters;
+    auto add = [&waiters](TContainerWaiter *waiter) { waiters.push_back(waiter); };
+
     auto lock = LockWaiters();
-    for (auto it = ContainerWaiters.begin(); it != ContainerWaiters.end();) {
-        auto waiter = *it;
-        if (waiter->ShouldReport(ct) &&
-                (label.empty() || (label[0] >= 'a' && label[0] <= 'z') ||
-                 waiter->ShouldReportLabel(label))) {
-            auto client = waiter->Client.lock();
-
-            TString name;
-            if (client && !client->ComposeName(ct.Name, name)) {
-                client->MakeReport(name, TContainer::StateName(ct.State), waiter->Async, label, value);
-                if (!waiter->Async) {
-                    ++it;
-                    waiter->Deactivate();
-                    client->SyncWaiter.reset();
-                    continue;
-                }
+
+    if (userLabel) {
+        auto range = LabelWaiters.equal_range(label);
+        for (auto it = range.first; it != range.second; ++it)
+            add(it->second);
+        for (auto waiter: AnyLabelWaiters)
+            add(waiter);
+    } else {
+        auto range = NameWaiters.equal_range(ct.Name);
+        for (auto it = range.first; it != range.second; ++it)
+            add(it->second);
+        if (ct.Level) {
+            WildcardWaiters.Ancestors(TPath(ct.Name), add);
+            for (auto waiter: AnyNameWaiters)
+                add(waiter);
+        }
+    }
+
+    std::sort(waiters.begin(), waiters.end(), [](TContainerWaiter *a, TContainerWaiter *b) {
+        return a->Seq < b->Seq;
+    });
+    waiters.erase(std::unique(waiters.begin(), waiters.end()), waiters.end());
+
+    for (auto waiter: waiters) {
+        if (!waiter->ShouldReport(ct) || (userLabel && !waiter->ShouldReportLabel(label)))
+            continue;
+
+        auto client = waiter->Client.lock();
+
+        TString name;
+        if (client && !client->ComposeName(ct.Name, name)) {
+            client->MakeReport(name, TContainer::StateName(ct.State), waiter->Async, label, value, waiter->Tag);
+            if (!waiter->Async) {
+                waiter->Deactivate();
+                client->SyncWaiter.reset();
+            }
+        }
+    }
+}
+
+void TContainerWaiter::ReportVolume(TVolume &volume, const TString &label, const TString &value) {
+    auto lock = LockWaiters();
+    auto state = TVolume::StateName(volume.State);
+    std::vector<TContainerWaiter *> waiters(VolumeWaiters.begin(), VolumeWaiters.end());
+
+    for (auto waiter: waiters) {
+        auto client = waiter->Client.lock();
+        if (!client)
+            continue;
+
+        TPath path = volume.ComposePathLocked(*client->ClientContainer);
+        if (path && waiter->ShouldReportVolume(path.ToString(), state)) {
+            client->MakeReport(path.ToString(), state, waiter->Async, label, value, waiter->Tag);
+            if (!waiter->Async) {
+                waiter->Deactivate();
+                client->SyncWaiter.reset();
             }
         }
-        if (waiter->Active)
-            ++it;
-        else
-            it = ContainerWaiters.erase(it);
     }
 }
 
@@ -94,7 +226,7 @@ void TContainerWaiter::Timeout() {
     auto lock = LockWaiters();
     auto client = Client.lock();
     if (client) {
-        client->MakeReport("", "timeout", Async);
+        client->MakeReport("", "timeout", Async, "", "", Tag);
         Deactivate();
         if (Async)
             client->AsyncWaiter.reset();
@@ -7,6 +7,7 @@
 
 class TClient;
 class TContainer;
+class TVolume;
 
 struct TContainerReport {
     TString Name;
@@ -25,18 +26,25 @@ public:
     std::vector<TString> Names;
     std::vector<TString> Wildcards;
     std::vector<TString> Labels;
+    std::vector<TString> Volumes;   /* paths in client container or wildcards */
     bool Async;
     bool Active = false;
+    uint64_t Tag = 0;   /* pipelined request */
+    uint64_t Seq = 0;   /* activation order */
 
     TContainerWaiter(bool async) : Async(async) { }
     ~TContainerWaiter();
 
-    void Activate(std::shared_ptr<TClient> &client);
+    TError Activate(std::shared_ptr<TClient> &client);
     void Deactivate();
 
     bool ShouldReport(TContainer &ct);
     bool ShouldReportLabel(const TString &label);
+    bool ShouldReportVolume(const TString &path, const TString &state);
     void Timeout();
 
     static void ReportAll(TContainer &ct, const TString &label = "", const TString &value = "");
+
+    /* Called under VolumesMutex */
+    static void ReportVolume(TVolume &volume, const TString &label = "", const TString &value = "");
 };
@@ -38,9 +38,73 @@ static int Stresstest(int argc, char *argv[]) {
     return test::StressTest(threads, iter, killPorto);
 }
 
+static int GetBenchmark(int argc, char *argv[]) {
+    int containers = 1000, threads = 16, seconds = 5;
+    if (argc >= 1)
+        StringToInt(argv[0], containers);
+    if (argc >= 2)
+        StringToInt(argv[1], threads);
+    if (argc >= 3)
+        StringToInt(argv[2], seconds);
+    return test::GetBenchmark(containers, threads, seconds);
+}
+
+static int StatsBenchmark(int argc, char *argv[]) {
+    int containers = 10000, seconds = 5;
+    if (argc >= 1)
+        StringToInt(argv[0], containers);
+    if (argc >= 2)
+        StringToInt(argv[1], seconds);
+    return test::StatsBenchmark(containers, seconds);
+}
+
+static int IncLabelBenchmark(int argc, char *argv[]) {
+    int containers = 100, seconds = 5;
+    if (argc >= 1)
+        StringToInt(argv[0], containers);
+    if (argc >= 2)
+        StringToInt(argv[1], seconds);
+    return test::IncLabelBenchmark(containers, seconds);
+}
+
+static int WaitBenchmark(int argc, char *argv[]) {
+    int waiters = 10000, rate = 1000, seconds = 10;
+    if (argc >= 1)
+        StringToInt(argv[0], waiters);
+    if (argc >= 2)
+        StringToInt(argv[1], rate);
+    if (argc >= 3)
+        StringToInt(argv[2], seconds);
+    return test::WaitBenchmark(waiters, rate, seconds);
+}
+
+static int CopyBenchmark(int argc, char *argv[]) {
+    int files = 100000, threads = 4;
+    if (argc >= 1)
+        StringToInt(argv[0], files);
+    if (argc >= 2)
+        StringToInt(argv[1], threads);
+    return test::CopyBenchmark(files, threads);
+}
+
+static int VolumeBenchmark(int argc, char *argv[]) {
+    int volumes = 10000, threads = 4;
+    if (argc >= 1)
+        StringToInt(argv[0], volumes);
+    if (argc >= 2)
+        StringToInt(argv[1], threads);
+    return test::VolumeBenchmark(volumes, threads);
+}
+
 static void Usage() {
     std::cout << "usage: " << program_invocation_short_name << " [--except] <selftest>..." << std::endl;
     std::cout << "       " << program_invocation_short_name << " stress [threads] [iterations] [kill=on/off]" << std::endl;
+    std::cout << "       " << program_invocation_short_name << " get-bench [containers] [threads] [seconds]" << std::endl;
+    std::cout << "       " << program_invocation_short_name << " stats-bench [containers] [seconds]" << std::endl;
+    std::cout << "       " << program_invocation_short_name << " inclabel-bench [containers] [seconds]" << std::endl;
+    std::cout << "       " << program_invocation_short_name << " wait-bench [waiters] [changes/s] [seconds]" << std::endl;
+    std::cout << "       " << program_invocation_short_name << " copy-bench [files] [threads]" << std::endl;
+    std::cout << "       " << program_invocation_short_name << " volume-bench [volumes] [threads]" << std::endl;
 }
 
 static int TestConnectivity() {
@@ -94,5 +158,23 @@ int main(int argc, char *argv[])
     if (what == "stress")
         return Stresstest(argc - 2, argv + 2);
 
+    if (what == "get-bench")
+        return GetBenchmark(argc - 2, argv + 2);
+
+    if (what == "stats-bench")
+        return StatsBenchmark(argc - 2, argv + 2);
+
+    if (what == "inclabel-bench")
+        return IncLabelBenchmark(argc - 2, argv + 2);
+
+    if (what == "wait-bench")
+        return WaitBenchmark(argc - 2, argv + 2);
+
+    if (what == "copy-bench")
+        return CopyBenchmark(argc - 2, argv + 2);
+
+    if (what == "volume-bench")
+        return VolumeBenchmark(argc - 2, argv + 2);
+
     return Selftest(argc - 1, argv + 1);
 }
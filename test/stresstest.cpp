@@ -8,11 +8,14 @@
 
 #include "config.hpp"
 #include "util/string.hpp"
+#include "util/unix.hpp"
+#include "util/copy.hpp"
 #include "test.hpp"
 
 extern "C" {
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/resource.h>
 }
 
 namespace test {
@@ -279,4 +282,337 @@ int StressTest(int threads, int iter, bool killPorto) {
 
     return 0;
 }
+
+static void GetLoop(int n, int containers, uint64_t deadline, std::atomic<uint64_t> &count) {
+    Porto::Connection api;
+    TString value;
+    uint64_t nr = 0;
+
+    tid = n;
+    for (int i = n; GetCurrentTimeMs() < deadline; i++) {
+        TString name = "stressget" + std::to_string(i % containers);
+        ExpectApiSuccess(api.GetProperty(name, "state", value));
+        nr++;
+    }
+    count += nr;
+}
+
+/* Measure Get throughput vs number of concurrent readers */
+int GetBenchmark(int containers, int max_threads, int seconds) {
+    Porto::Connection api;
+
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    ReadConfigs();
+
+    for (int i = 0; i < containers; i++)
+        ExpectApiSuccess(api.Create("stressget" + std::to_string(i)));
+
+    std::cout << "Containers: " << containers << std::endl;
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        std::vector<std::thread> thrGet;
+        std::atomic<uint64_t> count(0);
+        uint64_t deadline = GetCurrentTimeMs() + seconds * 1000;
+
+        for (int i = 1; i <= threads; i++)
+            thrGet.push_back(std::thread(GetLoop, i, containers, deadline, std::ref(count)));
+        for (auto &th : thrGet)
+            th.join();
+
+        std::cout << "Threads: " << threads << " Get/s: " << count / seconds << std::endl;
+    }
+
+    for (int i = 0; i < containers; i++)
+        ExpectApiSuccess(api.Destroy("stressget" + std::to_string(i)));
+
+    TestDaemon(api);
+
+    return 0;
+}
+
+/* Compare string Get with typed GetStats, values are parsed as client would */
+int StatsBenchmark(int containers, int seconds) {
+    std::vector<TString> names = { "stressstat*" };
+    std::vector<TString> props = {
+        "cpu_usage", "cpu_usage_system", "memory_usage", "anon_usage",
+        "cache_usage", "io_read", "io_write", "io_ops",
+        "net_rx_bytes", "net_tx_bytes", "process_count", "thread_count",
+    };
+    Porto::Connection api;
+
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    ReadConfigs();
+
+    for (int i = 0; i < containers; i++) {
+        TString name = "stressstat" + std::to_string(i);
+        ExpectApiSuccess(api.Create(name));
+        ExpectApiSuccess(api.Start(name));
+    }
+
+    std::cout << "Containers: " << containers << " Properties: " << props.size() << std::endl;
+
+    uint64_t deadline = GetCurrentTimeMs() + seconds * 1000;
+    uint64_t nr = 0, values = 0;
+    while (GetCurrentTimeMs() < deadline) {
+        auto rsp = api.Get(names, props);
+        Expect(rsp != nullptr);
+        for (auto &ct: rsp->list()) {
+            for (auto &kv: ct.keyval()) {
+                TUintMap map;
+                uint64_t val;
+                if (kv.has_error())
+                    continue;
+                if (kv.value().find(':') != TString::npos)
+                    ExpectOk(StringToUintMap(kv.value(), map));
+                else
+                    ExpectOk(StringToUint64(kv.value(), val));
+                values++;
+            }
+        }
+        nr++;
+    }
+    std::cout << "Get: " << (double)nr / seconds << " req/s "
+              << values / seconds << " values/s" << std::endl;
+
+    deadline = GetCurrentTimeMs() + seconds * 1000;
+    nr = values = 0;
+    while (GetCurrentTimeMs() < deadline) {
+        auto rsp = api.GetStats(names, props);
+        Expect(rsp != nullptr);
+        for (auto &ct: rsp->container())
+            for (auto &stat: ct.stat())
+                if (!stat.has_error())
+                    values++;
+        nr++;
+    }
+    std::cout << "GetStats: " << (double)nr / seconds << " req/s "
+              << values / seconds << " values/s" << std::endl;
+
+    for (int i = 0; i < containers; i++)
+        ExpectApiSuccess(api.Destroy("stressstat" + std::to_string(i)));
+
+    TestDaemon(api);
+
+    return 0;
+}
+
+/* Each IncLabel saves container node, see keyvalue_journal */
+int IncLabelBenchmark(int containers, int seconds) {
+    Porto::Connection api;
+    TString val;
+
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    ReadConfigs();
+
+    for (int i = 0; i < containers; i++) {
+        TString name = "stresslabel" + std::to_string(i);
+        ExpectApiSuccess(api.Create(name));
+        ExpectApiSuccess(api.SetProperty(name, "labels", "BENCH_A: a; BENCH_B: b; BENCH_C: c"));
+    }
+
+    std::cout << "Containers: " << containers << std::endl;
+
+    uint64_t deadline = GetCurrentTimeMs() + seconds * 1000;
+    uint64_t nr = 0;
+    while (GetCurrentTimeMs() < deadline) {
+        ExpectApiSuccess(api.IncLabel("stresslabel" + std::to_string(nr % containers), "BENCH_COUNTER"));
+        nr++;
+    }
+    std::cout << "IncLabel: " << (double)nr / seconds << " req/s" << std::endl;
+
+    ExpectApiSuccess(api.GetProperty("/", "porto_stat[keyvalue_appends]", val));
+    std::cout << "KeyValue appends: " << val;
+    ExpectApiSuccess(api.GetProperty("/", "porto_stat[keyvalue_rewrites]", val));
+    std::cout << " rewrites: " << val << std::endl;
+
+    for (int i = 0; i < containers; i++)
+        ExpectApiSuccess(api.Destroy("stresslabel" + std::to_string(i)));
+
+    TestDaemon(api);
+
+    return 0;
+}
+
+static void WaitChurn(Porto::Connection &api, int containers, int rate, int seconds) {
+    uint64_t start = GetCurrentTimeMs();
+    uint64_t deadline = start + seconds * 1000;
+    uint64_t nr = 0, total = 0, worst = 0;
+
+    while (GetCurrentTimeMs() < deadline) {
+        /* pace state changes to requested rate */
+        uint64_t due = start + nr * 1000 / rate;
+        uint64_t now = GetCurrentTimeMs();
+        if (due > now)
+            usleep((due - now) * 1000);
+
+        TString name = "waitbench" + std::to_string(nr / 3 % containers);
+        uint64_t begin = GetCurrentTimeUs();
+        if (nr % 3 == 0)
+            ExpectApiSuccess(api.Start(name));
+        else if (nr % 3 == 1)
+            ExpectApiSuccess(api.IncLabel(name, "BENCH_" + std::to_string(nr % 1000)));
+        else
+            ExpectApiSuccess(api.Stop(name));
+        uint64_t time = GetCurrentTimeUs() - begin;
+        total += time;
+        worst = std::max(worst, time);
+        nr++;
+    }
+
+    std::cout << "Changes: " << nr * 1000 / std::max(GetCurrentTimeMs() - start, (uint64_t)1) << "/s"
+              << " avg " << total / std::max(nr, (uint64_t)1) << " us"
+              << " max " << worst << " us" << std::endl;
+}
+
+/* Idle async waiters on own names, wildcards and labels, needs daemon.max_clients above waiters */
+int WaitBenchmark(int waiters, int rate, int seconds) {
+    std::vector<std::unique_ptr<Porto::Connection>> conns;
+    Porto::Connection api;
+    struct rlimit lim;
+    int containers = 10;
+
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    ReadConfigs();
+
+    if (!getrlimit(RLIMIT_NOFILE, &lim)) {
+        lim.rlim_cur = lim.rlim_max;
+        (void)setrlimit(RLIMIT_NOFILE, &lim);
+    }
+
+    for (int i = 0; i < containers; i++)
+        ExpectApiSuccess(api.Create("waitbench" + std::to_string(i)));
+
+    std::cout << "Waiters: 0 Rate: " << rate << "/s" << std::endl;
+    WaitChurn(api, containers, rate, seconds);
+
+    for (int i = 0; i < waiters; i++) {
+        TString name = "waitbench-idle" + std::to_string(i);
+        conns.emplace_back(new Porto::Connection);
+        ExpectApiSuccess(conns.back()->AsyncWait({name, name + "/*"},
+                                                  {"BENCH_" + std::to_string(i % 1000)}, nullptr));
+    }
+
+    std::cout << "Waiters: " << waiters << " Rate: " << rate << "/s" << std::endl;
+    WaitChurn(api, containers, rate, seconds);
+
+    conns.clear();
+
+    for (int i = 0; i < containers; i++)
+        ExpectApiSuccess(api.Destroy("waitbench" + std::to_string(i)));
+
+    TestDaemon(api);
+
+    return 0;
+}
+
+static void VolumeLoop(int n, int threads, int volumes, const TPath &base, bool create) {
+    Porto::Connection api;
+
+    tid = n;
+    for (int i = n; i < volumes; i += threads) {
+        TString path = (base / std::to_string(i)).ToString();
+        if (create)
+            ExpectApiSuccess(api.CreateVolume(path, {{"backend", "dir"}}));
+        else
+            ExpectApiSuccess(api.UnlinkVolume(path));
+    }
+}
+
+/* Volumes with explicit paths go through conflict checks, needs volumes.max_total */
+int VolumeBenchmark(int volumes, int threads) {
+    TPath base("/tmp/porto-volume-bench");
+    Porto::Connection api;
+    uint64_t start;
+
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    ReadConfigs();
+
+    for (int i = 0; i < volumes; i++)
+        ExpectOk((base / std::to_string(i)).MkdirAll(0755));
+
+    std::cout << "Volumes: " << volumes << " Threads: " << threads << std::endl;
+
+    for (bool create: {true, false}) {
+        std::vector<std::thread> workers;
+
+        start = GetCurrentTimeMs();
+        for (int i = 0; i < threads; i++)
+            workers.push_back(std::thread(VolumeLoop, i, threads, volumes, base, create));
+        for (auto &th: workers)
+            th.join();
+
+        uint64_t time = std::max(GetCurrentTimeMs() - start, (uint64_t)1);
+        std::cout << (create ? "Create: " : "Destroy: ") << time << " ms "
+                  << volumes * 1000 / time << " volumes/s" << std::endl;
+    }
+
+    (void)base.RemoveAll();
+
+    TestDaemon(api);
+
+    return 0;
+}
+
+/* Synthetic layer: files of various sizes, some sparse, symlinks and hardlinks */
+int CopyBenchmark(int files, int threads) {
+    TPath base("/tmp/porto-copy-bench");
+    TPath src = base / "src";
+    uint64_t start;
+
+    (void)base.RemoveAll();
+    ExpectOk(src.MkdirAll(0755));
+
+    for (int i = 0; i < files; i++) {
+        TPath dir = src / ("d" + std::to_string(i / 1000)) / ("s" + std::to_string(i / 100 % 10));
+        TPath path = dir / ("f" + std::to_string(i));
+        TFile file;
+
+        if (i % 100 == 0)
+            ExpectOk(dir.MkdirAll(0755));
+
+        if (i % 50 == 1) {
+            ExpectOk(path.Symlink("f" + std::to_string(i - 1)));
+            continue;
+        }
+
+        if (i % 50 == 2) {
+            ExpectOk(path.Hardlink(dir / ("f" + std::to_string(i - 2))));
+            continue;
+        }
+
+        ExpectOk(file.CreateNew(path, 0644));
+        ExpectOk(file.WriteAll(TString((i * 7919) % 16384, 'x')));
+        if (i % 1000 == 3)
+            ExpectOk(file.Truncate(64 << 20));  /* sparse tail */
+    }
+
+    std::cout << "Files: " << files << " Threads: " << threads << std::endl;
+
+    ExpectOk((base / "cp").Mkdir(0755));
+    start = GetCurrentTimeMs();
+    Expect(system(("cp --archive --force --one-file-system --no-target-directory " +
+                   src.ToString() + " " + (base / "cp").ToString()).c_str()) == 0);
+    std::cout << "cp --archive: " << GetCurrentTimeMs() - start << " ms" << std::endl;
+
+    ExpectOk((base / "native").Mkdir(0755));
+    start = GetCurrentTimeMs();
+    TTreeCopy copy;
+    copy.Threads = threads;
+    ExpectOk(copy.Copy(src, base / "native"));
+    std::cout << "native: " << GetCurrentTimeMs() - start << " ms "
+              << copy.Files << " files " << copy.Directories << " dirs "
+              << copy.Bytes << " bytes " << copy.ClonedBytes << " cloned" << std::endl;
+
+    Expect(system(("diff -r --no-dereference " + (base / "cp").ToString() + " " +
+                   (base / "native").ToString()).c_str()) == 0);
+
+    (void)base.RemoveAll();
+
+    return 0;
+}
 }
@@ -339,6 +339,79 @@ c2.disconnect()
 c.disconnect()
 
 
+# PIPELINE
+
+from porto import rpc_pb2
+
+reqs = []
+for i in range(16):
+    req = rpc_pb2.TPortoRequest()
+    if i % 2:
+        req.version.SetInParent()
+    else:
+        req.list.SetInParent()
+    reqs.append(req)
+
+rsps = c.Pipeline(reqs)
+assert len(rsps) == len(reqs)
+for i, rsp in enumerate(rsps):
+    ExpectEq(rsp.error, rpc_pb2.Success)
+    ExpectEq(rsp.tag, i + 1)
+    ExpectEq(rsp.HasField('version'), i % 2 == 1)
+
+# plain requests still work after pipelined ones
+c.Version()
+
+
+# STATS
+
+a = c.Run("test-stats", command="sleep 100")
+stats = c.GetStats(["test-stats"], ["cpu_usage", "io_read", "io_read[hw]", "state", "labels", "foo"])["test-stats"]
+ExpectEq(type(stats["cpu_usage"]), int)
+ExpectLe(stats["cpu_usage"], int(c.GetProperty("test-stats", "cpu_usage")))
+ExpectEq(type(stats["io_read"]), dict)
+ExpectEq(stats["io_read[hw]"], stats["io_read"]["hw"])
+ExpectEq(stats["state"], "running")
+Expect(isinstance(stats["foo"], porto.exceptions.InvalidProperty))
+a.Destroy()
+
+
+# CHANGES
+
+rsp = c.ListChanges()
+Expect(rsp.full)
+Expect(rsp.generation > 0)
+Expect("/" in [ct.name for ct in rsp.container])
+gen = rsp.generation
+
+rsp = c.ListChanges(gen)
+Expect(not rsp.full)
+ExpectEq(rsp.generation, gen)
+ExpectEq(len(rsp.container), 0)
+
+a = c.Create("test-changes")
+rsp = c.ListChanges(gen)
+Expect(not rsp.full)
+ExpectEq([ct.name for ct in rsp.container], ["test-changes"])
+Expect(rsp.container[0].generation > gen)
+gen = rsp.generation
+
+a.SetProperty("command", "true")
+a.SetLabel("TEST.changes", "1")
+rsp = c.ListChanges(gen)
+ExpectEq([ct.name for ct in rsp.container], ["test-changes"])
+gen = rsp.generation
+
+a.Destroy()
+rsp = c.ListChanges(gen)
+ExpectEq([(ct.name, ct.removed) for ct in rsp.container], [("test-changes", True)])
+
+v = c.CreateVolume()
+rsp = c.ListChanges(rsp.generation)
+ExpectEq([vol.name for vol in rsp.volume], [v.path])
+v.Destroy()
+
+
 # TRY CONNECT
 
 c = porto.Connection(socket_path='/run/portod.socket.not.found', timeout=1)
@@ -0,0 +1,44 @@
+#!/usr/bin/python
+
+import porto
+from test_common import *
+
+ConfigurePortod('test-event-queue', """
+daemon {
+    event_threads: 4
+}
+""")
+
+c = porto.Connection(timeout=30)
+
+def Stat(event, name):
+    return int(c.GetProperty("/", "porto_stat[event:{}:{}]".format(event, name)))
+
+exits = Stat("exit", "handled")
+timeouts = Stat("wait_timeout", "handled")
+
+# exits of different subtrees are handled by different workers
+cts = []
+for i in range(8):
+    a = c.Run("test-event-queue-{}".format(i), weak=False)
+    cts.append(a)
+    cts.append(c.Run(a.name + "/b", command="true", weak=False))
+
+for ct in cts:
+    if ct.name.endswith("/b"):
+        ExpectEq(ct.Wait(timeout_s=10), ct.name)
+        ExpectEq(ct.GetProperty("state"), "dead")
+
+ExpectEq(c.Wait([cts[0].name], timeout_s=0.1), "")
+
+ExpectLe(exits + 8, Stat("exit", "handled"))
+ExpectLe(timeouts + 1, Stat("wait_timeout", "handled"))
+ExpectEq(Stat("exit", "handled"), Stat("exit", "latency_ms_le_inf"))
+ExpectLe(Stat("exit", "latency_ms_le_1"), Stat("exit", "latency_ms_le_10"))
+ExpectLe(Stat("wait_timeout", "latency_ms_le_1000"), Stat("wait_timeout", "latency_ms_le_inf"))
+
+for ct in cts:
+    if not ct.name.endswith("/b"):
+        ct.Destroy()
+
+ConfigurePortod('test-event-queue', '')
@@ -0,0 +1,63 @@
+#!/usr/bin/python
+
+import os
+import threading
+import porto
+from test_common import *
+
+ConfigurePortod('test-io-queue', """
+daemon {
+    io_threads: 4
+}
+volumes {
+    place_load_limit: "default: 1"
+}
+""")
+
+c = porto.Connection(timeout=60)
+
+tarball = "/tmp/test-io-queue.tgz"
+layers = ["test-io-queue-{}".format(i) for i in range(4)]
+
+for name in layers:
+    if Catch(c.FindLayer, name) is None:
+        c.RemoveLayer(name)
+
+def Stat(name):
+    return int(c.GetProperty("/", "porto_stat[io_queue:/place:{}]".format(name)))
+
+v = c.CreateVolume()
+open(v.path + "/file", 'w').write("x" * (16 << 20))
+v.Export(tarball)
+v.Unlink()
+
+completed = Stat("completed")
+waits = Stat("wait_ms_le_inf")
+
+def Import(name):
+    porto.Connection(timeout=60).ImportLayer(name, tarball)
+
+# imports are serialized by place load limit but leave threads for other work
+threads = [threading.Thread(target=Import, args=(name,)) for name in layers]
+for t in threads:
+    t.start()
+
+v = c.CreateVolume()
+v.Unlink()
+
+for t in threads:
+    t.join()
+
+for name in layers:
+    c.FindLayer(name)
+    c.RemoveLayer(name)
+
+ExpectLe(completed + 2 * len(layers) + 2, Stat("completed"))
+ExpectLe(waits + 2 * len(layers) + 2, Stat("wait_ms_le_inf"))
+ExpectEq(Stat("queued"), 0)
+ExpectEq(Stat("running"), 0)
+ExpectLe(Stat("depth_le_0"), Stat("depth_le_inf"))
+
+os.unlink(tarball)
+
+ConfigurePortod('test-io-queue', '')
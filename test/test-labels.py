@@ -130,4 +130,34 @@ ExpectEq(c.FindLabel('.TEST.a'), [{'name':'a', 'label':'.TEST.a', 'value':'a', '
 ExpectEq(c.FindLabel('TEST.b'), [{'name':'a/b', 'label':'TEST.b', 'value':'b', 'state':'meta'}])
 ExpectEq(c.FindLabel('.TEST.*'), [])
 
+# label index follows set, increment, removal and destruction
+d = c.Run('a/d')
+d['TEST.b'] = 'd'
+ExpectEq([l['name'] for l in c.FindLabel('TEST.b')], ['a/b', 'a/d'])
+ExpectEq([l['name'] for l in c.FindLabel('TEST.*', value='d')], ['a/d'])
+ExpectEq([l['name'] for l in c.FindLabel('TEST.b', mask='a/d')], ['a/d'])
+
+ExpectEq(c.List(labels=['TEST.b']), ['a/b', 'a/d'])
+ExpectEq(c.List(labels=['TEST.b=b']), ['a/b'])
+ExpectEq(c.List(labels=['TEST.a', 'TEST.b=d']), ['a', 'a/d'])
+ExpectEq(c.List(mask='a/*', labels=['TEST.*']), ['a/b', 'a/d'])
+ExpectEq(c.List(labels=['OTHER.*']), [])
+
+ExpectEq(sorted(c.Get([], ['state'], labels=['TEST.b=d']).keys()), ['a/d'])
+ExpectEq(sorted(c.Get(['a', 'a/b'], ['state'], labels=['TEST.b']).keys()), ['a/b'])
+ExpectEq(sorted(c.Get(['a/*'], ['state'], labels=['TEST.b']).keys()), ['a/b', 'a/d'])
+
+d.IncLabel('TEST.c', 5)
+ExpectEq(c.FindLabel('TEST.c', value='5'), [{'name':'a/d', 'label':'TEST.c', 'value':'5', 'state':'meta'}])
+d.IncLabel('TEST.c')
+ExpectEq(c.FindLabel('TEST.c', value='5'), [])
+ExpectEq(c.List(labels=['TEST.c=6']), ['a/d'])
+
+d['TEST.b'] = ''
+ExpectEq(c.List(labels=['TEST.b']), ['a/b'])
+
+d.Destroy()
+ExpectEq(c.FindLabel('TEST.c'), [])
+
 a.Destroy()
+ExpectEq(c.FindLabel('TEST.*'), [])
@@ -0,0 +1,55 @@
+#!/usr/bin/python
+
+import os
+import porto
+from test_common import *
+
+ConfigurePortod('test-layer-dedup', """
+volumes {
+    layer_dedup: true
+}
+""")
+
+c = porto.Connection(timeout=30)
+
+tarball = "/tmp/test-layer-dedup.tgz"
+layers = "/place/porto_layers"
+
+for name in ["test-dedup-a", "test-dedup-b"]:
+    if Catch(c.FindLayer, name) is None:
+        c.RemoveLayer(name)
+
+v = c.CreateVolume()
+open(v.path + "/shared", 'w').write("shared" * 4096)
+open(v.path + "/empty", 'w').close()
+v.Export(tarball)
+v.Unlink()
+
+c.ImportLayer("test-dedup-a", tarball)
+c.ImportLayer("test-dedup-b", tarball)
+
+a = os.stat(layers + "/test-dedup-a/shared")
+b = os.stat(layers + "/test-dedup-b/shared")
+ExpectEq(a.st_ino, b.st_ino)
+ExpectEq(a.st_nlink, 3)
+ExpectNe(os.stat(layers + "/test-dedup-a/empty").st_ino,
+         os.stat(layers + "/test-dedup-b/empty").st_ino)
+
+rsp = c._ListLayers()
+ExpectLe(1, rsp.dedup_files)
+ExpectLe(4096 * 6, rsp.dedup_bytes)
+
+# merge must not change shared inode in place
+c.MergeLayer("test-dedup-b", tarball)
+ExpectEq(open(layers + "/test-dedup-a/shared").read(), "shared" * 4096)
+ExpectEq(os.stat(layers + "/test-dedup-a/shared").st_nlink, 3)
+
+c.RemoveLayer("test-dedup-a")
+ExpectEq(os.stat(layers + "/test-dedup-b/shared").st_nlink, 2)
+ExpectEq(open(layers + "/test-dedup-b/shared").read(), "shared" * 4096)
+
+c.RemoveLayer("test-dedup-b")
+
+os.unlink(tarball)
+
+ConfigurePortod('test-layer-dedup', '')
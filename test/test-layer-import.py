@@ -0,0 +1,78 @@
+#!/usr/bin/python
+
+import os
+import subprocess
+import porto
+from test_common import *
+
+ConfigurePortod('test-layer-import', """
+volumes {
+    native_import: true
+}
+""")
+
+c = porto.Connection(timeout=60)
+
+src = "/tmp/test-layer-import"
+ref = "/tmp/test-layer-import-ref"
+layer = "/place/porto_layers/test-layer-import"
+
+def Snapshot(path):
+    return subprocess.check_output("cd {} && find . -printf '%p %y %m %U %G %s %T@ %l\\n' | sort && find . -type f -exec md5sum {{}} + | sort".format(path), shell=True)
+
+if Catch(c.FindLayer, "test-layer-import") is None:
+    c.RemoveLayer("test-layer-import")
+
+subprocess.check_call(["rm", "-rf", src, ref])
+os.makedirs(src + "/dir/" + "x" * 120)
+open(src + "/dir/" + "x" * 120 + "/" + "y" * 120, 'w').write("long")
+open(src + "/file", 'w').write("file" * 100000)
+os.chmod(src + "/file", 0o4755)
+os.link(src + "/file", src + "/link")
+os.symlink("/etc/passwd", src + "/symlink")
+os.mknod(src + "/whiteout", 0o600 | 0o020000, 0)
+os.mkfifo(src + "/fifo")
+os.chown(src + "/dir", 1234, 5678)
+subprocess.check_call(["truncate", "-s", "100M", src + "/sparse"])
+subprocess.check_call("echo data | dd of={}/sparse bs=1 seek=10M conv=notrunc".format(src), shell=True)
+
+for fmt in ["gnu", "posix"]:
+    tarball = "/tmp/test-layer-import.{}.tgz".format(fmt)
+    subprocess.check_call(["tar", "--numeric-owner", "--sparse", "--format=" + fmt, "-czf", tarball, "-C", src, "."])
+
+    os.mkdir(ref)
+    subprocess.check_call(["tar", "--numeric-owner", "--preserve-permissions", "-xzf", tarball, "-C", ref])
+
+    c.ImportLayer("test-layer-import", tarball)
+    ExpectEq(Snapshot(layer), Snapshot(ref))
+    Expect(os.stat(layer + "/sparse").st_blocks < 1024)
+
+    c.RemoveLayer("test-layer-import")
+    subprocess.check_call(["rm", "-rf", ref])
+    os.unlink(tarball)
+
+# paths outside of layer are rejected
+tarball = "/tmp/test-layer-import.bad.tar"
+subprocess.check_call(["tar", "-cf", tarball, "-P", "--transform=s:^:../:", "-C", src, "file"])
+ExpectEq(Catch(c.ImportLayer, "test-layer-import", tarball), porto.exceptions.InvalidPath)
+Expect(not os.path.exists("/place/porto_layers/file"))
+os.unlink(tarball)
+
+# compressed stream with explicit compress=tar falls back to tar
+from porto import rpc_pb2
+
+tarball = "/tmp/test-layer-import.gz"
+subprocess.check_call(["tar", "-czf", tarball, "-C", src, "file"])
+req = rpc_pb2.TPortoRequest()
+req.importLayer.layer = "test-layer-import"
+req.importLayer.tarball = tarball
+req.importLayer.merge = False
+req.importLayer.compress = "tar"
+c.rpc.call(req, c.disk_timeout)
+ExpectEq(open(layer + "/file").read(), "file" * 100000)
+c.RemoveLayer("test-layer-import")
+os.unlink(tarball)
+
+subprocess.check_call(["rm", "-rf", src])
+
+ConfigurePortod('test-layer-import', "")
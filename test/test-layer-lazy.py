@@ -0,0 +1,82 @@
+#!/usr/bin/python
+
+import os
+import porto
+from test_common import *
+
+ConfigurePortod('test-layer-lazy', """
+volumes {
+    lazy_squashfs: true
+}
+""")
+
+c = porto.Connection(timeout=30)
+
+image = "/tmp/test-layer-lazy.squashfs"
+layers = "/place/porto_layers"
+layer = layers + "/test-lazy"
+
+if Catch(c.FindLayer, "test-lazy") is None:
+    c.RemoveLayer("test-lazy")
+if Catch(c.FindLayer, "test-lazy-export") is None:
+    c.RemoveLayer("test-lazy-export")
+
+def Mounted():
+    return int(c.GetProperty("/", "porto_stat[layer_images_mounted]"))
+
+def IsMountpoint(path):
+    return os.stat(path).st_dev != os.stat(os.path.dirname(path)).st_dev
+
+v = c.CreateVolume()
+os.mkdir(v.path + "/dir")
+open(v.path + "/dir/file", 'w').write("lazy" * 1024)
+v.Export(image, compress="squashfs")
+v.Unlink()
+
+mounted = Mounted()
+
+c.ImportLayer("test-lazy", image)
+Expect(os.path.isfile(layers + "/_image_test-lazy"))
+ExpectEq(os.listdir(layer), [])
+Expect(not IsMountpoint(layer))
+
+ExpectException(c.MergeLayer, porto.exceptions.NotSupported, "test-lazy", image)
+
+a = c.CreateVolume(layers=["test-lazy"], backend="overlay")
+ExpectEq(open(a.path + "/dir/file").read(), "lazy" * 1024)
+open(a.path + "/dir/file", 'w').write("upper")
+Expect(IsMountpoint(layer))
+ExpectEq(Mounted(), mounted + 1)
+
+b = c.CreateVolume(layers=["test-lazy"], backend="plain")
+ExpectEq(open(b.path + "/dir/file").read(), "lazy" * 1024)
+ExpectEq(Mounted(), mounted + 1)
+
+ExpectException(c.RemoveLayer, porto.exceptions.Busy, "test-lazy")
+
+a.Unlink()
+Expect(IsMountpoint(layer))
+
+b.Unlink()
+Expect(not IsMountpoint(layer))
+ExpectEq(Mounted(), mounted)
+
+# export reads content of image, not empty layer directory
+export = "/tmp/test-layer-lazy.tgz"
+if os.path.exists(export):
+    os.unlink(export)
+c.ReExportLayer("test-lazy", export, compress="tar.gz")
+Expect(not IsMountpoint(layer))
+ExpectEq(Mounted(), mounted)
+
+c.ImportLayer("test-lazy-export", export)
+ExpectEq(open(layers + "/test-lazy-export/dir/file").read(), "lazy" * 1024)
+c.RemoveLayer("test-lazy-export")
+os.unlink(export)
+
+c.RemoveLayer("test-lazy")
+Expect(not os.path.exists(layers + "/_image_test-lazy"))
+
+os.unlink(image)
+
+ConfigurePortod('test-layer-lazy', '')
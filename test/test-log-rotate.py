@@ -0,0 +1,59 @@
+#!/usr/bin/python
+
+import time
+import porto
+from test_common import *
+
+ConfigurePortod('test-log-rotate', """
+daemon {
+    log_rotate_ms: 100
+}
+""")
+
+c = porto.Connection(timeout=30)
+
+def Stat(name):
+    return int(c.GetProperty("/", "porto_stat[{}]".format(name)))
+
+checks = Stat("log_rotate_checks")
+watched = Stat("log_rotate_watched")
+
+# growing stdout is rotated while container is running
+a = c.Run("test-log-rotate", command="bash -c 'while true; do seq 4096; sleep 0.05; done'",
+          stdout_limit="65536", weak=False)
+b = c.Run("test-log-rotate-idle", command="sleep 1000", weak=False)
+
+deadline = time.time() + 10
+while int(a["stdout_offset"]) == 0 and time.time() < deadline:
+    time.sleep(0.1)
+
+Expect(int(a["stdout_offset"]) > 0)
+ExpectLe(checks + 1, Stat("log_rotate_checks"))
+ExpectLe(watched + 4, Stat("log_rotate_watched"))
+
+# offset stays consistent with content after rotation
+offset = int(a["stdout_offset"])
+Expect(len(a["stdout[{}:16]".format(offset)]) > 0)
+
+a.Destroy()
+b.Destroy()
+
+# dead containers are destroyed by their own aging timer
+a = c.Run("test-log-rotate", command="true", aging_time="1", weak=False)
+a.Wait()
+ExpectEq(a["state"], "dead")
+
+b = c.Run("test-log-rotate-idle", command="true", aging_time="3600", weak=False)
+b.Wait()
+ExpectEq(b["state"], "dead")
+
+time.sleep(2)
+ExpectException(c.Find, porto.exceptions.ContainerDoesNotExist, "test-log-rotate")
+ExpectEq(b["state"], "dead")
+
+# shorter aging time applies to already dead container
+b["aging_time"] = "0"
+time.sleep(1)
+ExpectException(c.Find, porto.exceptions.ContainerDoesNotExist, "test-log-rotate-idle")
+
+ConfigurePortod('test-log-rotate', '')
@@ -0,0 +1,93 @@
+#!/usr/bin/python
+
+import os
+import time
+import porto
+from test_common import *
+
+pool = "/place/porto_loop_pool"
+
+ConfigurePortod('test-loop-pool', """
+volumes {
+    loop_pool_size: 1
+    loop_pool_classes: "64M"
+}
+""")
+
+c = porto.Connection(timeout=30)
+
+def Stat(name):
+    return int(c.GetProperty("/", "porto_stat[loop_pool_{}]".format(name)))
+
+def Poll(cond, timeout=60):
+    deadline = time.time() + timeout
+    while not cond() and time.time() < deadline:
+        time.sleep(0.1)
+    Expect(cond())
+
+def Images():
+    return sorted([x for x in os.listdir(pool) if x.endswith(".img")])
+
+def Check(v):
+    open(v.path + "/file", 'w').write("loop")
+    ExpectEq(open(v.path + "/file").read(), "loop")
+    v.Unlink()
+
+# default place is filled at start
+
+Poll(lambda: Stat("images") == 1)
+ExpectEq(len(Images()), 1)
+
+# size of pool class claims image, pool is refilled
+
+hit = Stat("hit")
+miss = Stat("miss")
+image = Images()[0]
+
+v = c.CreateVolume(backend="loop", space_limit="64M")
+ExpectEq(Stat("hit"), hit + 1)
+ExpectEq(Stat("miss"), miss)
+Expect(image not in Images())
+Check(v)
+
+Poll(lambda: Stat("images") == 1)
+ExpectEq(len(Images()), 1)
+
+# other sizes do not touch pool
+
+v = c.CreateVolume(backend="loop", space_limit="32M")
+ExpectEq(Stat("hit"), hit + 1)
+ExpectEq(Stat("miss"), miss)
+ExpectEq(Stat("images"), 1)
+Check(v)
+
+# pool is reloaded after restart, not refilled
+
+images = Images()
+ReloadPortod()
+Poll(lambda: Stat("images") == 1)
+ExpectEq(Images(), images)
+
+v = c.CreateVolume(backend="loop", space_limit="64M")
+ExpectEq(Stat("hit"), hit + 2)
+Check(v)
+Poll(lambda: Stat("images") == 1)
+
+# empty pool falls back to mkfs
+
+for name in os.listdir(pool):
+    os.unlink(pool + "/" + name)
+os.rmdir(pool)
+open(pool, 'w').close()     # refill cannot create pool directory
+
+ReloadPortod()
+ExpectEq(Stat("images"), 0)
+
+v = c.CreateVolume(backend="loop", space_limit="64M")
+ExpectEq(Stat("miss"), miss + 1)
+ExpectEq(Stat("images"), 0)
+Check(v)
+
+os.unlink(pool)
+
+ConfigurePortod('test-loop-pool', "")
@@ -473,6 +473,44 @@ def TestWaitRecovery():
     ExpectProp(aaa, "state", "dead")
     aaa.Destroy()
 
+def TestParallelRecovery():
+    print "Check parallel restore of container tree"
+
+    AsRoot()
+    c = porto.Connection(timeout=30)
+
+    names = []
+    for i in range(8):
+        names.append("par%d" % i)
+        for j in range(4):
+            names.append("par%d/b%d" % (i, j))
+            names.append("par%d/b%d/c" % (i, j))
+
+    for name in names:
+        r = c.Create(name)
+        if name.endswith("/c"):
+            r.SetProperty("command", "sleep 1000")
+            r.Start()
+
+    subprocess.check_call([portod, "reload"])
+    c.connect()
+
+    for name in names:
+        ExpectEq(c.Find(name).name, name)
+        if name.endswith("/c"):
+            ExpectProp(c.Find(name), "state", "running")
+        else:
+            ExpectProp(c.Find(name), "state", "meta")
+
+    for key in ["restore_containers_ms", "restore_keyvalue_ms", "restore_network_ms",
+                "restore_cgroups_ms", "restore_volumes_ms"]:
+        int(c.GetProperty("/", "porto_stat[%s]" % key))
+
+    ExpectEq(c.GetProperty("/", "porto_stat[errors]"), "0")
+
+    for i in range(8):
+        c.Destroy("par%d" % i)
+
 #Former selftest.cpp TestVolumeRecovery
 def TestVolumeRecovery():
     print "Make sure porto removes leftover volumes"
@@ -729,6 +767,7 @@ ret = 0
 try:
     TestRecovery()
     TestWaitRecovery()
+    TestParallelRecovery()
     TestVolumeRecovery()
     TestTCCleanup()
     TestPersistentStorage()
@@ -0,0 +1,63 @@
+#!/usr/bin/python
+
+import porto
+import time
+from porto import rpc_pb2
+from test_common import *
+
+NR_REQUESTS = 10000
+
+c = porto.Connection(timeout=30)
+
+def PortoStat():
+    stat = {}
+    for s in c.GetProperty("/", "porto_stat").split(';'):
+        pair = s.split(':')
+        if len(pair) == 2:
+            stat[pair[0].strip()] = int(pair[1])
+    return stat
+
+def Measure(name, fn, count):
+    before = PortoStat()
+    start = time.time()
+    fn()
+    elapsed = time.time() - start
+    after = PortoStat()
+
+    # porto_stat requests itself also counted
+    requests = after['requests_completed'] - before['requests_completed'] - 1
+    recv = after['clients_recv_calls'] - before['clients_recv_calls']
+    send = after['clients_send_calls'] - before['clients_send_calls']
+
+    print("{:>10}: {} requests {:.3f}s {:.1f} us/req recv/req {:.3f} send/req {:.3f}".format(
+          name, requests, elapsed, elapsed * 1000000. / count,
+          float(recv) / requests, float(send) / requests))
+
+    return (float(recv) / requests, float(send) / requests)
+
+def Sequential():
+    for i in range(NR_REQUESTS):
+        c.GetProperty("/", "state")
+
+def Pipelined():
+    for i in range(0, NR_REQUESTS, 100):
+        reqs = []
+        for j in range(100):
+            req = rpc_pb2.TPortoRequest()
+            req.getProperty.name = "/"
+            req.getProperty.property = "state"
+            reqs.append(req)
+        for rsp in c.Pipeline(reqs):
+            ExpectEq(rsp.error, rpc_pb2.Success)
+
+c.connect()
+
+# Header and request body are read in one call
+(recv, send) = Measure("sequential", Sequential, NR_REQUESTS)
+ExpectLe(recv, 1.1)
+ExpectLe(send, 1.1)
+
+# Several requests are read in one call
+(recv, send) = Measure("pipelined", Pipelined, NR_REQUESTS)
+ExpectLe(recv, 1.1)
+ExpectLe(send, 1.1)
@@ -0,0 +1,44 @@
+#!/usr/bin/python
+
+import porto
+import time
+from test_common import *
+
+ConfigurePortod('test-sampler', """
+daemon {
+    sampler_interval_ms: 200
+    sampler_history: 10
+}
+""")
+
+c = porto.Connection(timeout=30)
+
+a = c.Run("test-sampler", command="bash -c 'while true; do true; done'")
+
+time.sleep(3)
+
+samples = c.GetSamples(["test-sampler"])["test-sampler"]
+ExpectEq(len(samples), 10)
+
+prev = None
+for s in samples:
+    if prev is not None:
+        ExpectLe(prev['time'], s['time'])
+        ExpectLe(prev['cpu_usage'], s['cpu_usage'])
+    prev = s
+
+Expect('cpu_usage_rate' in samples[-1])
+Expect(samples[-1]['cpu_usage_rate'] > 100000000)
+Expect(samples[-1]['memory_usage'] > 0)
+
+ExpectEq(len(c.GetSamples(["test-sampler"], count=3)["test-sampler"]), 3)
+Expect("/" in c.GetSamples(count=1))
+Expect("test-sampler" in c.GetSamples(["test-*"], count=1))
+
+a.Stop()
+time.sleep(1)
+ExpectEq(c.GetSamples(["test-sampler"])["test-sampler"], [])
+
+a.Destroy()
+
+ConfigurePortod('test-sampler', '')
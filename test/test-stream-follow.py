@@ -0,0 +1,90 @@
+#!/usr/bin/python
+
+import time
+import porto
+from test_common import *
+
+c = porto.Connection(timeout=30)
+
+chunks = []
+
+def on_data(name, stream, offset, data, end):
+    chunks.append((name, stream, offset, data, end))
+
+def Poll(cond, timeout=10):
+    deadline = time.time() + timeout
+    while not cond() and time.time() < deadline:
+        c.Version()
+        time.sleep(0.1)
+    Expect(cond())
+
+def Text():
+    return b"".join([x[3] for x in chunks])
+
+# follow from the beginning
+
+a = c.Run("test-follow", command="bash -c 'echo hello; sleep 1; echo world; sleep 1000'")
+c.FollowStream(a, on_data, offset=0)
+
+Poll(lambda: Text() == b"hello\nworld\n")
+ExpectEq(chunks[0][:3], ("test-follow", "stdout", 0))
+ExpectEq(chunks[-1][2], len(b"hello\n"))
+
+ExpectEq(int(c.GetProperty("/", "porto_stat[stream_followers]")), 1)
+
+a.Destroy()
+Poll(lambda: chunks[-1][4])
+ExpectEq(int(c.GetProperty("/", "porto_stat[stream_followers]")), 0)
+
+# rotation while client does not read is visible as offset jump
+
+chunks = []
+a = c.Run("test-follow", stdout_limit="65536",
+          command="bash -c 'for i in $(seq 64); do head -c 65536 /dev/zero | tr \\\\0 x; sleep 0.1; done; sleep 1000'")
+c.FollowStream(a, on_data, offset=0)
+time.sleep(4)
+
+Poll(lambda: chunks and chunks[-1][2] + len(chunks[-1][3]) == 64 * 65536, 30)
+
+jumps = 0
+for prev, cur in zip(chunks, chunks[1:]):
+    ExpectLe(prev[2] + len(prev[3]), cur[2])
+    if cur[2] > prev[2] + len(prev[3]):
+        jumps += 1
+Expect(jumps > 0)
+ExpectEq(set(Text()), set(b"x"))
+
+c.UnfollowStream(a)
+ExpectEq(int(c.GetProperty("/", "porto_stat[stream_followers]")), 0)
+a.Destroy()
+
+ExpectException(c.FollowStream, porto.exceptions.InvalidValue, "/", on_data, "stdin")
+
+# followers per client are limited, each keeps file open
+
+cts = [c.Run("test-follow-{}".format(i), command="sleep 1000") for i in range(8)]
+for ct in cts:
+    c.FollowStream(ct, on_data, "stdout")
+    c.FollowStream(ct, on_data, "stderr")
+c.FollowStream(cts[0], on_data, "stdout")
+a = c.Run("test-follow", command="sleep 1000")
+ExpectException(c.FollowStream, porto.exceptions.ResourceNotAvailable, a, on_data, "stdout")
+ExpectEq(int(c.GetProperty("/", "porto_stat[stream_followers]")), 16)
+for ct in cts:
+    c.UnfollowStream(ct, "stdout")
+    c.UnfollowStream(ct, "stderr")
+    ct.Destroy()
+a.Destroy()
+
+# follow without tag is rejected, data could not be told from responses
+
+from porto import rpc_pb2
+
+a = c.Run("test-follow", command="sleep 1000")
+plain = porto.Connection(timeout=30)
+req = rpc_pb2.TPortoRequest()
+req.FollowStream.name = "test-follow"
+ExpectException(plain.rpc.call, porto.exceptions.InvalidValue, req)
+plain.Disconnect()
+ExpectEq(int(c.GetProperty("/", "porto_stat[stream_followers]")), 0)
+a.Destroy()
@@ -0,0 +1,97 @@
+#!/usr/bin/python
+
+import os
+import time
+import shutil
+import subprocess
+import porto
+from test_common import *
+
+ConfigurePortod('test-tree-remove', """
+volumes {
+    remove_threads: 4
+    async_remove: true
+}
+""")
+
+c = porto.Connection(timeout=30)
+
+tarball = "/tmp/test-tree-remove.tgz"
+staging = "/tmp/test-tree-remove-mnt"
+layers = "/place/porto_layers"
+trash = "/place/porto_trash"
+layer = "test-tree-remove"
+
+if Catch(c.FindLayer, layer) is None:
+    c.RemoveLayer(layer)
+
+def Stat(name):
+    return int(c.GetProperty("/", "porto_stat[{}]".format(name)))
+
+def Poll(cond, timeout=10):
+    deadline = time.time() + timeout
+    while not cond() and time.time() < deadline:
+        time.sleep(0.1)
+    Expect(cond())
+
+def MakeTree(path, depth, width):
+    for i in range(width):
+        open("{}/file{}".format(path, i), 'w').write("x" * i)
+        os.symlink("file{}".format(i), "{}/link{}".format(path, i))
+    if depth:
+        for i in range(width):
+            sub = "{}/dir{}".format(path, i)
+            os.mkdir(sub)
+            MakeTree(sub, depth - 1, width)
+
+v = c.CreateVolume()
+MakeTree(v.path, 3, 4)
+v.Export(tarball)
+v.Unlink()
+
+# nested tree is moved into trash and removed in background
+
+queued = Stat("trash_queued")
+removed = Stat("trash_removed")
+
+c.ImportLayer(layer, tarball)
+c.RemoveLayer(layer)
+Expect(not os.path.exists(layers + "/" + layer))
+ExpectEq(Stat("trash_queued"), queued + 1)
+
+Poll(lambda: Stat("trash_removed") == removed + 1)
+Poll(lambda: not os.path.exists(trash))
+
+# removal does not cross mountpoints
+
+if not os.path.exists(staging):
+    os.mkdir(staging)
+subprocess.check_call(["mount", "-t", "tmpfs", "tmpfs", staging])
+open(staging + "/keep", 'w').write("keep")
+
+c.ImportLayer(layer, tarball)
+os.mkdir(layers + "/" + layer + "/mnt")
+subprocess.check_call(["mount", "--bind", staging, layers + "/" + layer + "/mnt"])
+
+c.RemoveLayer(layer)
+Expect(not os.path.exists(layers + "/" + layer))
+ExpectEq(Stat("trash_queued"), queued + 2)
+
+Poll(lambda: os.path.exists(trash) and
+     all(os.listdir(trash + "/" + name) == ["mnt"] for name in os.listdir(trash)))
+ExpectEq(Stat("trash_removed"), removed + 1)
+ExpectEq(open(staging + "/keep").read(), "keep")
+
+for line in open("/proc/self/mounts").readlines():
+    target = line.split()[1]
+    if target.startswith(trash + "/"):
+        subprocess.check_call(["umount", target])
+for name in os.listdir(trash):
+    shutil.rmtree(trash + "/" + name)
+os.rmdir(trash)
+
+subprocess.check_call(["umount", staging])
+os.rmdir(staging)
+os.unlink(tarball)
+
+ConfigurePortod('test-tree-remove', '')
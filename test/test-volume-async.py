@@ -0,0 +1,58 @@
+#!/usr/bin/python
+
+import os
+import porto
+from test_common import *
+
+c = porto.Connection(timeout=30)
+
+tarball = "/tmp/test-volume-async.tgz"
+
+if Catch(c.FindLayer, "test-volume-async") is None:
+    c.RemoveLayer("test-volume-async")
+
+events = []
+
+def on_event(name, state, when, label=None, value=None):
+    events.append((name, state, label, value))
+
+c.AsyncWait([], on_event, volumes=["***"])
+
+# build completes in background
+
+spec = c.NewVolume({'backend': 'plain'}, async_build=True)
+path = spec['path']
+ExpectNe(spec['state'], 'destroyed')
+
+r = c.WaitVolumes([path], timeout=30)
+ExpectEq(r['path'], path)
+ExpectEq(r['state'], 'ready')
+ExpectEq(c.GetVolume(path)['state'], 'ready')
+
+Expect((path, 'building', None, None) in events)
+Expect((path, 'ready', None, None) in events)
+
+c.UnlinkVolume(path)
+Expect((path, 'destroyed', None, None) in events)
+
+# unlink cancels build in progress
+
+v = c.CreateVolume()
+open(v.path + "/file", 'w').write("x" * (64 << 20))
+v.Export(tarball)
+v.Unlink()
+c.ImportLayer("test-volume-async", tarball)
+
+events = []
+spec = c.NewVolume({'backend': 'plain', 'layers': ['test-volume-async']}, async_build=True)
+path = spec['path']
+c.UnlinkVolume(path)
+
+ExpectException(c.FindVolume, porto.exceptions.VolumeNotFound, path)
+ExpectEq([e[1] for e in events if e[0] == path and e[2] is None][-1], 'destroyed')
+
+ExpectException(lambda: c.WaitVolumes([path], timeout=0), porto.exceptions.WaitContainerTimeout)
+
+c.AsyncWait([], on_event, volumes=[])
+c.RemoveLayer("test-volume-async")
+os.unlink(tarball)
@@ -0,0 +1,51 @@
+#!/usr/bin/python
+
+import os
+import porto
+from test_common import *
+
+ConfigurePortod('test-volume-usage', """
+volumes {
+    usage_refresh_ms: 3600000
+}
+""")
+
+c = porto.Connection(timeout=30)
+
+def Refreshes():
+    return int(c.GetProperty("/", "porto_stat[volume_usage_refreshes]"))
+
+def Usage(path, sync=False):
+    return c.GetVolume(path, sync=sync)['space']['usage']
+
+v = c.CreateVolume(space_limit="1G")
+
+refreshes = Refreshes()
+usage = Usage(v.path)
+ExpectEq(Usage(v.path), usage)
+ExpectEq(Refreshes(), refreshes)
+
+with open(v.path + "/file", 'w') as f:
+    f.write("x" * (16 << 20))
+    f.flush()
+    os.fsync(f.fileno())
+
+# cached until refresh or sync read
+ExpectEq(Usage(v.path), usage)
+ExpectEq(int(c.FindVolume(v.path).GetProperty("space_used")), usage)
+ExpectEq(Refreshes(), refreshes)
+
+fresh = Usage(v.path, sync=True)
+ExpectLe(usage + (16 << 20), fresh)
+ExpectEq(Refreshes(), refreshes + 1)
+ExpectEq(Usage(v.path), fresh)
+
+# resize refreshes cache
+avail = c.GetVolume(v.path)['space']['available']
+v.Tune(space_limit="2G")
+ExpectLe(avail + (1 << 30) - (16 << 20), c.GetVolume(v.path)['space']['available'])
+ExpectEq(Refreshes(), refreshes + 2)
+
+v.Unlink()
+
+ConfigurePortod('test-volume-usage', '')
@@ -1,3 +1,5 @@
+import threading
+import time
 from test_common import *
 import porto
 
@@ -27,3 +29,34 @@ a = c.Run("a", weak=False, command="sleep 1000")
 ReloadPortod()
 a.Destroy()
 ExpectEq(events, [])
+
+# waiters are found by exact name, fixed prefix of wildcard and label name
+found = []
+def collect_event(name, state, when, **kwargs):
+    found.append((name, state))
+
+watcher = porto.Connection()
+watcher.AsyncWait(["w/b*", "*/c", "x"], collect_event)
+
+w_ct = c.Run("w", weak=False)
+for name in ["w/b", "w/c", "w/d"]:
+    c.Run(name, command="true").Wait()
+watcher.List()
+ExpectEq(sorted(set([name for name, state in found])), ["w/b", "w/c"])
+Expect(("w/b", "dead") in found)
+Expect(("w/c", "dead") in found)
+watcher.Disconnect()
+
+result = []
+def wait_labels():
+    result.append(porto.Connection().WaitLabels(["w"], ["TEST_*", "OTHER"], timeout=10))
+
+t = threading.Thread(target=wait_labels)
+t.start()
+time.sleep(0.5)
+w_ct.SetLabel("NOISE", "1")
+w_ct.SetLabel("OTHER", "2")
+t.join()
+ExpectEq((result[0]['name'], result[0]['label'], result[0]['value']), ("w", "OTHER", "2"))
+
+w_ct.Destroy()
@@ -67,6 +67,12 @@ namespace test {
 
     int SelfTest(std::vector<TString> args);
     int StressTest(int threads, int iter, bool killPorto);
+    int GetBenchmark(int containers, int max_threads, int seconds);
+    int StatsBenchmark(int containers, int seconds);
+    int IncLabelBenchmark(int containers, int seconds);
+    int WaitBenchmark(int waiters, int rate, int seconds);
+    int CopyBenchmark(int files, int threads);
+    int VolumeBenchmark(int volumes, int threads);
     int FuzzyTest(int threads, int iter);
 
     enum class KernelFeature {